@@ -1 +0,0 @@
-../../dotproduct/kernel/dotproduct.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../exp/kernel/exp.c
\ No newline at end of file
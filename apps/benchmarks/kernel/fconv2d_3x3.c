@@ -1 +0,0 @@
-../../fconv2d/fconv2d_3x3.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../fconv2d/fconv2d_7x7.c
\ No newline at end of file
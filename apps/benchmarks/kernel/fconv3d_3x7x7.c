@@ -1 +0,0 @@
-../../fconv3d/fconv3d_3x7x7.c
\ No newline at end of file
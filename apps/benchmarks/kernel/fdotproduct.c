@@ -1 +0,0 @@
-../../fdotproduct/kernel/fdotproduct.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../fft/kernel/fft.c
\ No newline at end of file
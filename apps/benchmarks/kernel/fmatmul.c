@@ -1 +0,0 @@
-../../fmatmul/kernel/fmatmul.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../iconv2d/iconv2d_3x3.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../iconv2d/iconv2d_5x5.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../iconv2d/iconv2d_7x7.c
\ No newline at end of file
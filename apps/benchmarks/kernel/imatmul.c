@@ -1 +0,0 @@
-../../imatmul/kernel/imatmul.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../softmax/kernel/softmax.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../jacobi2d/kernel/stencil.c
\ No newline at end of file
@@ -0,0 +1 @@
+../../jacobi2d/kernel/stencil.h
\ No newline at end of file
@@ -1 +0,0 @@
-../../dwt/kernel/wavelet.c
\ No newline at end of file
@@ -34,6 +34,9 @@
 #elif defined(FMATMUL)
 #include "benchmark/fmatmul.bmark"
 
+#elif defined(FGEMM)
+#include "benchmark/fgemm.bmark"
+
 #elif defined(ICONV2D)
 #include "benchmark/iconv2d.bmark"
 
@@ -76,6 +79,9 @@
 #elif defined(LAVAMD)
 #include "benchmark/lavamd.bmark"
 
+#elif defined(SPMV)
+#include "benchmark/spmv.bmark"
+
 #else
 #error                                                                         \
     "Error, no kernel was specified. Please, run 'make bin/benchmarks ENV_DEFINES=-D${KERNEL}', where KERNEL contains the kernel to benchmark. For example: 'make bin/benchmarks ENV_DEFINES=-DIMATMUL'."
@@ -0,0 +1,85 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "chaining.h"
+
+void axpy_short_v(double a, const double *x, double *y, size_t n, size_t vl) {
+  size_t avl;
+  for (; n > 0; n -= avl) {
+    avl = n < vl ? n : vl;
+    asm volatile("vsetvli zero, %0, e64, m1, ta, ma" ::"r"(avl));
+    asm volatile("vle64.v v0, (%0)" ::"r"(x));
+    asm volatile("vle64.v v8, (%0)" ::"r"(y));
+    asm volatile("vfmacc.vf v8, %0, v0" ::"f"(a));
+    asm volatile("vse64.v v8, (%0)" ::"r"(y));
+    x += avl;
+    y += avl;
+  }
+}
+
+double dotp_short_v(const double *x, const double *y, size_t n, size_t vl) {
+  size_t avl;
+  double red;
+
+  // Clean the accumulator
+  asm volatile("vsetvli zero, %0, e64, m1, ta, ma" ::"r"(1));
+  asm volatile("vmv.s.x v24, zero");
+  for (; n > 0; n -= avl) {
+    avl = n < vl ? n : vl;
+    asm volatile("vsetvli zero, %0, e64, m1, ta, ma" ::"r"(avl));
+    asm volatile("vle64.v v0, (%0)" ::"r"(x));
+    asm volatile("vle64.v v8, (%0)" ::"r"(y));
+    asm volatile("vfmul.vv v16, v0, v8");
+    asm volatile("vfredusum.vs v24, v16, v24");
+    x += avl;
+    y += avl;
+  }
+  asm volatile("vfmv.f.s %0, v24" : "=f"(red));
+  return red;
+}
+
+void ichain_short_v(int64_t b, const int64_t *x, int64_t *z, size_t n,
+                    size_t vl) {
+  size_t avl;
+  for (; n > 0; n -= avl) {
+    avl = n < vl ? n : vl;
+    asm volatile("vsetvli zero, %0, e64, m1, ta, ma" ::"r"(avl));
+    asm volatile("vle64.v v0, (%0)" ::"r"(x));
+    asm volatile("vadd.vx v8, v0, %0" ::"r"(b));
+    asm volatile("vmul.vv v16, v8, v0");
+    asm volatile("vsub.vv v24, v16, v8");
+    asm volatile("vse64.v v24, (%0)" ::"r"(z));
+    x += avl;
+    z += avl;
+  }
+}
+
+void axpy_short_s(double a, const double *x, double *y, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    y[i] += a * x[i];
+}
+
+double dotp_short_s(const double *x, const double *y, size_t n) {
+  double red = 0;
+  for (size_t i = 0; i < n; ++i)
+    red += x[i] * y[i];
+  return red;
+}
+
+void ichain_short_s(int64_t b, const int64_t *x, int64_t *z, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    z[i] = (x[i] + b) * x[i] - (x[i] + b);
+}
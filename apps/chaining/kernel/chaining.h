@@ -0,0 +1,39 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Short-vector kernels made of chains of dependent instructions. Each kernel
+// stripmines n elements in vectors of at most vl elements (e64, LMUL=1), so
+// that the latency of every chain is exposed instead of hidden by long vectors.
+
+#ifndef _CHAINING_H_
+#define _CHAINING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// y = a * x + y: vle -> vfmacc -> vse
+void axpy_short_v(double a, const double *x, double *y, size_t n, size_t vl);
+// Sum of x * y: vle -> vfmul -> vfredusum
+double dotp_short_v(const double *x, const double *y, size_t n, size_t vl);
+// z = (x + b) * x - (x + b): vle -> vadd -> vmul -> vsub -> vse
+void ichain_short_v(int64_t b, const int64_t *x, int64_t *z, size_t n,
+                    size_t vl);
+
+void axpy_short_s(double a, const double *x, double *y, size_t n);
+double dotp_short_s(const double *x, const double *y, size_t n);
+void ichain_short_s(int64_t b, const int64_t *x, int64_t *z, size_t n);
+
+#endif
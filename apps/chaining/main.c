@@ -0,0 +1,126 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Cycles of short-vector kernels whose instructions depend on each other, to
+// compare Ara with and without the operand forwarding (operand_fwd=1). Every
+// kernel is checked against the scalar code.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/chaining.h"
+#include "runtime.h"
+#include "util.h"
+
+#ifdef SPIKE
+#include <stdio.h>
+#elif defined ARA_LINUX
+#include <stdio.h>
+#else
+#include "printf.h"
+#endif
+
+// Elements of each buffer
+#define N 256
+// Threshold for FP numbers comparison during the final check
+#define THRESHOLD 0.000000001
+
+double x[N] __attribute__((aligned(4 * NR_LANES)));
+double y[N] __attribute__((aligned(4 * NR_LANES)));
+double y_ref[N] __attribute__((aligned(4 * NR_LANES)));
+int64_t ix[N] __attribute__((aligned(4 * NR_LANES)));
+int64_t iz[N] __attribute__((aligned(4 * NR_LANES)));
+int64_t iz_ref[N] __attribute__((aligned(4 * NR_LANES)));
+
+void init_y() {
+  for (int i = 0; i < N; ++i)
+    y[i] = y_ref[i] = 1.0 - 0.125 * (i % 16);
+}
+
+int main() {
+  printf("\n");
+  printf("==============\n");
+  printf("=  CHAINING  =\n");
+  printf("==============\n");
+  printf("\n");
+  printf("\n");
+
+  int error = 0;
+
+  for (int i = 0; i < N; ++i) {
+    x[i] = 0.25 * (i % 32) - 4.0;
+    ix[i] = i % 64 - 32;
+  }
+
+  printf("kernel  vl  cycles  cycles/element\n");
+
+  // From a single element up to one e64 vector register with LMUL=1, so that
+  // every configuration runs at least one vector length
+  for (size_t vl = 1; vl <= VLEN / 64; vl *= 2) {
+    int64_t runtime;
+
+    // vle -> vfmacc -> vse
+    init_y();
+    axpy_short_s(1.5, x, y_ref, N);
+    start_timer();
+    axpy_short_v(1.5, x, y, N, vl);
+    stop_timer();
+    runtime = get_timer();
+    for (int i = 0; i < N; ++i)
+      if (!similarity_check(y[i], y_ref[i], THRESHOLD)) {
+        printf("Error: axpy, vl = %lu, y[%d] = %lf instead of %lf\n", vl, i,
+               y[i], y_ref[i]);
+        error = 1;
+        break;
+      }
+    printf("axpy   %3lu  %6ld  %14f\n", vl, runtime, (float)runtime / N);
+
+    // vle -> vfmul -> vfredusum
+    start_timer();
+    double red = dotp_short_v(x, y, N, vl);
+    stop_timer();
+    runtime = get_timer();
+    double red_ref = dotp_short_s(x, y, N);
+    if (!similarity_check(red, red_ref, THRESHOLD)) {
+      printf("Error: dotp, vl = %lu, %lf instead of %lf\n", vl, red, red_ref);
+      error = 1;
+    }
+    printf("dotp   %3lu  %6ld  %14f\n", vl, runtime, (float)runtime / N);
+
+    // vle -> vadd -> vmul -> vsub -> vse
+    memset(iz, 0, sizeof(iz));
+    ichain_short_s(3, ix, iz_ref, N);
+    start_timer();
+    ichain_short_v(3, ix, iz, N, vl);
+    stop_timer();
+    runtime = get_timer();
+    for (int i = 0; i < N; ++i)
+      if (iz[i] != iz_ref[i]) {
+        printf("Error: ichain, vl = %lu, z[%d] = %ld instead of %ld\n", vl, i,
+               iz[i], iz_ref[i]);
+        error = 1;
+        break;
+      }
+    printf("ichain %3lu  %6ld  %14f\n", vl, runtime, (float)runtime / N);
+  }
+
+  if (error)
+    printf("\nFail.\n");
+  else
+    printf("\nPassed.\n");
+
+  return error;
+}
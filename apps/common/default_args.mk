@@ -5,6 +5,8 @@ def_args_imatmul     ?= "128 128 128"
 def_args_fmatmul     ?= "128 128 128"
 def_args_dtype-matmul?= "float64 128 128 128"
 def_args_fmatmul-loop?= "128 128 128"
+# Matrix sizes, alpha, beta
+def_args_fgemm       ?= "61 100 130 1.5 0.5"
 # Matrix size, filter size
 def_args_iconv2d     ?= "112 7"
 def_args_fconv2d     ?= "112 7"
@@ -26,14 +28,18 @@ def_args_dwt         ?= "512"
 def_args_exp         ?= "128"
 def_args_cos         ?= "512"
 def_args_log         ?= "512"
+# Elements per function, data type, and LMUL
+def_args_vmath       ?= "512"
+# Elements of each buffer (input, weights, output)
+def_args_conv        ?= "16384"
 # Channels and Inner size
 def_args_softmax     ?= "3 256"
 # Number of steps and width of the vector
 def_args_pathfinder  ?= "1 1024 64"
 # Batch_size, depth, height, width, n_boxes (in total), crop_h, crop_w
 def_args_roi_align   ?= "1 32 4 4 4 2 2"
-# SpMV configuration: row, col, density
-def_args_spmv        ?= "128 128 0.6"
+# SpMV configuration: row, col, density, row-length distribution, SELL slice height (VLEN/16, e64 with LMUL=4)
+def_args_spmv        ?= "128 128 0.6 uniform $(shell echo $$(( $(vlen) / 16 )))"
 # Conjugate gradient size and steps
 def_args_conjugate_gradient	?= "128 0 0.5"
 # box1d, particles_per_box, alpha, maxelm
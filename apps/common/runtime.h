@@ -11,6 +11,33 @@ extern int64_t event_trigger;
 extern int64_t timer;
 // SoC-level CSR
 extern uint64_t hw_cnt_en_reg;
+// SoC-level performance counters (see ctrl_registers.sv)
+extern volatile uint64_t perf_cnt_reg[];
+
+// Performance counters of Ara's functional units, in the order of
+// ara_pkg::perf_event_e. *_BUSY counts the cycles with a vector instruction
+// in flight in the unit, *_STARVED the cycles in which such an instruction
+// waits for its operands (VLDU: for the memory).
+enum perf_counter_e {
+  PERF_VALU_BUSY,
+  PERF_VMFPU_BUSY,
+  PERF_SLDU_BUSY,
+  PERF_MASKU_BUSY,
+  PERF_VLDU_BUSY,
+  PERF_VSTU_BUSY,
+  PERF_VALU_STARVED,
+  PERF_VMFPU_STARVED,
+  PERF_SLDU_STARVED,
+  PERF_MASKU_STARVED,
+  PERF_VLDU_STARVED,
+  PERF_VSTU_STARVED,
+  PERF_VRF_BANK_CONFLICT,
+  NR_PERF_COUNTERS
+};
+
+typedef struct {
+  int64_t cnt[NR_PERF_COUNTERS];
+} perf_counters_t;
 
 // Return the current value of the cycle counter
 inline int64_t get_cycle_count() {
@@ -36,6 +63,24 @@ inline void stop_timer() { timer += get_cycle_count(); }
 
 // Get the value of the timer
 inline int64_t get_timer() { return timer; }
+
+// Sample the performance counters around a kernel, as for the timer
+inline void start_perf_counters(perf_counters_t *perf) {
+  asm volatile("fence");
+  for (int i = 0; i < NR_PERF_COUNTERS; ++i)
+    perf->cnt[i] = -perf_cnt_reg[i];
+}
+inline void stop_perf_counters(perf_counters_t *perf) {
+  asm volatile("fence");
+  for (int i = 0; i < NR_PERF_COUNTERS; ++i)
+    perf->cnt[i] += perf_cnt_reg[i];
+}
+
+// Get the value of a performance counter
+inline int64_t get_perf_counter(const perf_counters_t *perf,
+                                enum perf_counter_e c) {
+  return perf->cnt[c];
+}
 #else
 #define HW_CNT_READY ;
 #define HW_CNT_NOT_READY ;
@@ -51,6 +96,22 @@ inline void stop_timer() {
 
 // Get the value of the timer
 inline int64_t get_timer() { return 0; }
+
+// Sample the performance counters around a kernel, as for the timer
+inline void start_perf_counters(perf_counters_t *perf) {
+  while (0)
+    ;
+}
+inline void stop_perf_counters(perf_counters_t *perf) {
+  while (0)
+    ;
+}
+
+// Get the value of a performance counter
+inline int64_t get_perf_counter(const perf_counters_t *perf,
+                                enum perf_counter_e c) {
+  return 0;
+}
 #endif
 
 #endif // _RUNTIME_H_
@@ -19,10 +19,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "ara_rvv.h"
 #include "runtime.h"
-#include "shared_kernel/fdotproduct.h"
-#include "shared_kernel/gemv.h"
-#include "shared_kernel/spmv.h"
 #include "util.h"
 
 #ifdef SPIKE
@@ -38,6 +36,11 @@
 #define MIN_LOSS 0.0005
 #define abs(x) (x < 0 ? -x : x)
 
+// Clock frequency, to report the iterations per second
+#ifndef FREQUENCY_MHZ
+#define FREQUENCY_MHZ 1000
+#endif
+
 extern uint64_t size;
 extern uint64_t step;
 extern double sparsity;
@@ -49,6 +52,9 @@ extern double b[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern double r[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern double p[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern double Ap[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+// Fused version: w = Ar and s = Ap
+extern double w[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern double s[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern int32_t A_PROW[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern int32_t A_IDX[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern double A_DATA[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
@@ -75,6 +81,50 @@ void daxpy(double *x, double a, double *y, double *dest, uint64_t len) {
   }
 }
 
+// p = r + beta * p, s = w + beta * s, x = x + alpha * p, r = r - alpha * s,
+// in a single pass on the vectors. Returns (r, r), reduced once at the end.
+double cg_fused_update(double *x, double *r, double *w, double *p, double *s,
+                       double alpha, double beta, uint64_t len) {
+  size_t vl;
+  double rr;
+
+  // Clear the accumulator of (r, r)
+  asm volatile("vsetvli %0, %1, e64, m4, ta, ma" : "=r"(vl) : "r"(len));
+  asm volatile("vmv.v.i v24, 0");
+  size_t vl_rr = vl;
+
+  // The tails of the accumulator are undisturbed
+  for (; len > 0; len -= vl) {
+    asm volatile("vsetvli %0, %1, e64, m4, tu, ma" : "=r"(vl) : "r"(len));
+    asm volatile("vle64.v v0, (%0);" ::"r"(r));
+    asm volatile("vle64.v v8, (%0);" ::"r"(p));
+    asm volatile("vfmadd.vf v8, %0, v0" ::"f"(beta));
+    asm volatile("vse64.v v8, (%0);" ::"r"(p));
+    asm volatile("vle64.v v4, (%0);" ::"r"(w));
+    asm volatile("vle64.v v12, (%0);" ::"r"(s));
+    asm volatile("vfmadd.vf v12, %0, v4" ::"f"(beta));
+    asm volatile("vse64.v v12, (%0);" ::"r"(s));
+    asm volatile("vle64.v v16, (%0);" ::"r"(x));
+    asm volatile("vfmacc.vf v16, %0, v8" ::"f"(alpha));
+    asm volatile("vse64.v v16, (%0);" ::"r"(x));
+    asm volatile("vfnmsac.vf v0, %0, v12" ::"f"(alpha));
+    asm volatile("vse64.v v0, (%0);" ::"r"(r));
+    asm volatile("vfmacc.vv v24, v0, v0");
+    x += vl;
+    r += vl;
+    w += vl;
+    p += vl;
+    s += vl;
+  }
+
+  asm volatile("vsetvli zero, %0, e64, m4, ta, ma" ::"r"(vl_rr));
+  asm volatile("vmv.s.x v28, zero");
+  asm volatile("vfredusum.vs v28, v24, v28");
+  asm volatile("vfmv.f.s %0, v28" : "=f"(rr));
+
+  return rr;
+}
+
 double CG_iteration_gemv(double *A, double *x, double *b, double *r, double *p,
                          double *Ap, uint64_t size) {
   /*
@@ -153,6 +203,81 @@ double CG_iteration_spmv(int32_t *A_PROW, int32_t *A_IDX, double *A_DATA,
   return rk_norm_new;
 }
 
+// Chronopoulos-Gear formulation of CG, with s = Ap and w = Ar. Each
+// iteration takes one pass on the vectors, fused with (r, r), and one matrix
+// product, fused with (w, r). The two dot products are independent, and each
+// pass has a single reduction.
+typedef struct {
+  double alpha;
+  double beta;
+  double gamma;
+} cg_state_t;
+
+// w = Ar, returns (w, r)
+double CG_fused_matvec(double *r, double *w, uint64_t size) {
+  if (USE_SPMV) {
+    return spmv_dot_csr_idx32(size, A_PROW, A_IDX, A_DATA, r, w);
+  } else {
+    gemv_rowwise(size, size, A, r, w);
+    return fdotp_v64b(w, r, size);
+  }
+}
+
+void CG_fused_init(double *r, double *w, double *p, double *s,
+                   cg_state_t *state, uint64_t size) {
+  double delta = CG_fused_matvec(r, w, size);
+  state->gamma = fdotp_v64b(r, r, size);
+  state->alpha = state->gamma / delta;
+  state->beta = 0;
+  for (uint64_t i = 0; i < size; ++i) {
+    p[i] = 0;
+    s[i] = 0;
+  }
+}
+
+double CG_fused_iteration(double *x, double *r, double *w, double *p,
+                          double *s, cg_state_t *state, uint64_t size) {
+  double gamma = cg_fused_update(x, r, w, p, s, state->alpha, state->beta, size);
+  double delta = CG_fused_matvec(r, w, size);
+
+  double beta = gamma / state->gamma;
+  double den = delta - beta * gamma / state->alpha;
+  if (abs(den) < MIN_LOSS) {
+    return gamma;
+  }
+  state->alpha = gamma / den;
+  state->beta = beta;
+  state->gamma = gamma;
+
+  return gamma;
+}
+
+// Bytes loaded and stored per iteration, from the traffic of each pass
+uint64_t CG_bytes_per_iteration(int fused, uint64_t size) {
+  uint64_t nnz = A_PROW[size];
+  // Matrix, and elements of the vector read by the matrix product
+  uint64_t matrix = USE_SPMV ? nnz * (sizeof(double) + sizeof(int32_t)) +
+                                   (size + 1) * sizeof(int32_t) +
+                                   nnz * sizeof(double)
+                             : size * size * sizeof(double) +
+                                   size * sizeof(double);
+  // Vectors of the other passes, and output of the matrix product. Current:
+  // three dot products (2 each), three axpys (3 each), Ap. Fused: the update
+  // (5 loads, 4 stores), w, and r for (w, r)
+  uint64_t vectors = (fused ? 11 : 16) * size * sizeof(double);
+  return matrix + vectors;
+}
+
+void CG_report(uint64_t iterations, double loss, int64_t runtime, int fused) {
+  printf("%d iterations, loss: %f\n", iterations, loss);
+  printf("The execution took %d cycles (%d cycles per iteration).\n", runtime,
+         iterations ? runtime / iterations : 0);
+  printf("%f iterations per second at %d MHz, %d bytes moved per "
+         "iteration.\n",
+         ((double)iterations) * FREQUENCY_MHZ * 1000000 / runtime,
+         FREQUENCY_MHZ, CG_bytes_per_iteration(fused, size));
+}
+
 int main() {
   printf("\n");
   printf("========================\n");
@@ -182,22 +307,52 @@ int main() {
 
   printf("Start CGM ...\n");
   uint64_t i = 0;
+  double loss;
+  start_timer();
   while (1) {
     if (step > 0 && i >= step) {
       break;
     }
 
-    double loss;
     if (USE_SPMV) {
       loss = CG_iteration_spmv(A_PROW, A_IDX, A_DATA, x, b, r, p, Ap, size);
     } else {
       loss = CG_iteration_gemv(A, x, b, r, p, Ap, size);
     }
-    printf("iteration %d, loss: %f\n", i, loss);
+    i++;
     if (loss < MIN_LOSS) {
       break;
     }
+  }
+  stop_timer();
+  CG_report(i, loss, get_timer(), 0);
+
+  printf("\n");
+  printf("Initializing fused CGM parameters...\n");
+  cg_state_t state;
+  // Restart from x = 0, so that r = b
+  for (uint64_t j = 0; j < size; ++j) {
+    x[j] = 0;
+    r[j] = b[j];
+  }
+  CG_fused_init(r, w, p, s, &state, size);
+
+  printf("Start fused CGM ...\n");
+  i = 0;
+  start_timer();
+  while (1) {
+    if (step > 0 && i >= step) {
+      break;
+    }
+
+    loss = CG_fused_iteration(x, r, w, p, s, &state, size);
     i++;
+    if (loss < MIN_LOSS) {
+      break;
+    }
   }
+  stop_timer();
+  CG_report(i, loss, get_timer(), 1);
+
   return 0;
 }
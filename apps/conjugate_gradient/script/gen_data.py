@@ -186,6 +186,8 @@ r=np.zeros([S], dtype=data_type)
 p=np.zeros([S], dtype=data_type)
 Ax=np.zeros([S,S], dtype=data_type)
 Ap=np.zeros([S,S], dtype=data_type)
+w=np.zeros([S], dtype=data_type)
+s=np.zeros([S], dtype=data_type)
 
 
 print(".section .data,\"aw\",@progbits")
@@ -199,6 +201,8 @@ emit("r", r, 'NR_LANES*4')
 emit("p", p, 'NR_LANES*4')
 emit("Ax", Ax, 'NR_LANES*4')
 emit("Ap", Ap, 'NR_LANES*4')
+emit("w", w, 'NR_LANES*4')
+emit("s", s, 'NR_LANES*4')
 emit("A_PROW", A_PROW, 'NR_LANES*4')
 emit("A_IDX", A_IDX, 'NR_LANES*4')
 emit("A_DATA", A_DATA, 'NR_LANES*4')
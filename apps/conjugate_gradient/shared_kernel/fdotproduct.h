@@ -1 +0,0 @@
-../../fdotproduct/kernel/fdotproduct.h
\ No newline at end of file
@@ -1 +0,0 @@
-../../gemv/kernel/gemv.c
\ No newline at end of file
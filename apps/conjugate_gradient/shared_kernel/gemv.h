@@ -1 +0,0 @@
-../../gemv/kernel/gemv.h
\ No newline at end of file
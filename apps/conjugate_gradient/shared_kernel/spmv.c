@@ -1 +0,0 @@
-../../spmv/kernel/spmv.c
\ No newline at end of file
@@ -1 +0,0 @@
-../../spmv/kernel/spmv.h
\ No newline at end of file
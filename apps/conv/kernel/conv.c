@@ -0,0 +1,190 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Direct convolution engine. NCHW is vectorized along the output rows, NHWC
+// along the output channels. Each output block stays in 8 vector registers of
+// accumulators: 8 / LMUL rows (NCHW) or pixels (NHWC) of one vector each, so
+// that every scalar weight (NCHW) or input (NHWC) is reused on 8 / LMUL
+// vectors. LMUL is the smallest one whose vectors hold a whole output row
+// (NCHW) or all the output channels (NHWC), up to 4. With a long VLEN, short
+// rows take more rows per block; with a short one, the longer register groups
+// keep enough elements per lane to hide the issue of each instruction.
+
+#include <riscv_vector.h>
+#include <stddef.h>
+
+#include "../../fconv2d/fconv2d.h"
+#include "../../fconv3d/fconv3d.h"
+#include "conv.h"
+
+#define CV_PASTE_(a, b) a##b
+#define CV_PASTE(a, b) CV_PASTE_(a, b)
+
+#define CV_F(op) CV_PASTE(__riscv_##op##_, CV_SFX)
+#define CV_U(op) CV_PASTE(__riscv_##op##_, CV_USFX)
+#define CV_B(op) CV_PASTE(__riscv_##op##_, CV_BSFX)
+#define CV_UB(op) CV_PASTE(CV_U(op), CV_PASTE(_, CV_BSFX))
+#define CV_MU(fn) CV_PASTE(fn, _mu)
+#define CV_FN(name) CV_PASTE(conv_##name##_, CV_SFX)
+#define CV_VSETVL(n) CV_PASTE(__riscv_vsetvl_e64, CV_LMUL)(n)
+#define CV_VLE(p, vl) CV_PASTE(__riscv_vle64_v_, CV_SFX)(p, vl)
+#define CV_VLSE(p, bs, vl) CV_PASTE(__riscv_vlse64_v_, CV_SFX)(p, bs, vl)
+#define CV_VLSE_M(m, p, bs, vl)                                                \
+  CV_PASTE(CV_PASTE(__riscv_vlse64_v_, CV_SFX), _m)(m, p, bs, vl)
+#define CV_VSE(p, v, vl) CV_PASTE(__riscv_vse64_v_, CV_SFX)(p, v, vl)
+
+#define CV_ROWS_2(X) X(0) X(1)
+#define CV_ROWS_4(X) CV_ROWS_2(X) X(2) X(3)
+#define CV_ROWS_8(X) CV_ROWS_4(X) X(4) X(5) X(6) X(7)
+
+#define CV_LMUL m1
+#define CV_SFX f64m1
+#define CV_USFX u64m1
+#define CV_BSFX b64
+#define CV_FT vfloat64m1_t
+#define CV_UT vuint64m1_t
+#define CV_BT vbool64_t
+#define CV_NROWS 8
+#define CV_FOR_ROWS CV_ROWS_8
+#include "conv_impl.h"
+#undef CV_LMUL
+#undef CV_SFX
+#undef CV_USFX
+#undef CV_BSFX
+#undef CV_FT
+#undef CV_UT
+#undef CV_BT
+#undef CV_NROWS
+#undef CV_FOR_ROWS
+
+#define CV_LMUL m2
+#define CV_SFX f64m2
+#define CV_USFX u64m2
+#define CV_BSFX b32
+#define CV_FT vfloat64m2_t
+#define CV_UT vuint64m2_t
+#define CV_BT vbool32_t
+#define CV_NROWS 4
+#define CV_FOR_ROWS CV_ROWS_4
+#include "conv_impl.h"
+#undef CV_LMUL
+#undef CV_SFX
+#undef CV_USFX
+#undef CV_BSFX
+#undef CV_FT
+#undef CV_UT
+#undef CV_BT
+#undef CV_NROWS
+#undef CV_FOR_ROWS
+
+#define CV_LMUL m4
+#define CV_SFX f64m4
+#define CV_USFX u64m4
+#define CV_BSFX b16
+#define CV_FT vfloat64m4_t
+#define CV_UT vuint64m4_t
+#define CV_BT vbool16_t
+#define CV_NROWS 2
+#define CV_FOR_ROWS CV_ROWS_2
+#include "conv_impl.h"
+#undef CV_LMUL
+#undef CV_SFX
+#undef CV_USFX
+#undef CV_BSFX
+#undef CV_FT
+#undef CV_UT
+#undef CV_BT
+#undef CV_NROWS
+#undef CV_FOR_ROWS
+
+void conv2d_s(const conv_t *c, const double *in, const double *w,
+              double *out) {
+  const int64_t h_out = conv_h_out(c), w_out = conv_w_out(c);
+  const int nchw = c->layout == CONV_NCHW;
+
+  for (int64_t co = 0; co < c->c_out; ++co)
+    for (int64_t oh = 0; oh < h_out; ++oh)
+      for (int64_t ow = 0; ow < w_out; ++ow) {
+        double acc = 0;
+        for (int64_t ci = 0; ci < c->c_in; ++ci)
+          for (int64_t kh = 0; kh < c->k; ++kh)
+            for (int64_t kw = 0; kw < c->k; ++kw) {
+              const int64_t ih = oh * c->stride - c->pad + kh * c->dilation;
+              const int64_t iw = ow * c->stride - c->pad + kw * c->dilation;
+              if (ih < 0 || ih >= c->h || iw < 0 || iw >= c->w)
+                continue;
+              if (nchw)
+                acc += in[(ci * c->h + ih) * c->w + iw] *
+                       w[((co * c->c_in + ci) * c->k + kh) * c->k + kw];
+              else
+                acc += in[(ih * c->w + iw) * c->c_in + ci] *
+                       w[((kh * c->k + kw) * c->c_in + ci) * c->c_out + co];
+            }
+        if (nchw)
+          out[(co * h_out + oh) * w_out + ow] = acc;
+        else
+          out[(oh * w_out + ow) * c->c_out + co] = acc;
+      }
+}
+
+void conv2d_direct_v(const conv_t *c, const double *in, const double *w,
+                     double *out) {
+  const int64_t n = c->layout == CONV_NCHW ? conv_w_out(c) : c->c_out;
+
+  if (n <= (int64_t)__riscv_vsetvlmax_e64m1())
+    conv_run_f64m1(c, in, w, out);
+  else if (n <= (int64_t)__riscv_vsetvlmax_e64m2())
+    conv_run_f64m2(c, in, w, out);
+  else
+    conv_run_f64m4(c, in, w, out);
+}
+
+// The specialised kernels work on one output channel of an unpadded NCHW
+// input, with stride and dilation 1, on blocks of 4 output rows. fconv2d_3x3
+// keeps a whole input row in one LMUL=2 vector, the other ones stripmine the
+// columns and need at least 8 output rows.
+int conv2d_fast_path(const conv_t *c) {
+  if (c->layout != CONV_NCHW || c->c_out != 1 || c->stride != 1 ||
+      c->dilation != 1 || c->pad != 0)
+    return 0;
+
+  const int64_t h_out = conv_h_out(c), w_out = conv_w_out(c);
+  if (h_out % 4)
+    return 0;
+  if (c->k == 3 && c->c_in == 1)
+    return w_out + 2 <= (int64_t)__riscv_vsetvlmax_e64m2();
+  if (c->k == 7)
+    return h_out >= 8;
+  return 0;
+}
+
+void conv2d_v(const conv_t *c, const double *in, const double *w,
+              double *out) {
+  if (!conv2d_fast_path(c)) {
+    conv2d_direct_v(c, in, w, out);
+    return;
+  }
+
+  const int64_t h_out = conv_h_out(c), w_out = conv_w_out(c);
+  // The specialised kernels do not write their inputs
+  double *i = (double *)in, *f = (double *)w;
+  if (c->k == 3)
+    fconv2d_3x3(out, i, f, h_out, w_out, c->k);
+  else if (c->c_in == 1)
+    fconv2d_7x7(out, i, f, h_out, w_out, c->k);
+  else
+    fconv3d_CHx7x7(out, i, f, h_out, w_out, c->c_in, c->k);
+}
@@ -0,0 +1,61 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Direct 2D convolution on double-precision tensors, for any KxK filter,
+// stride, dilation, zero padding, and number of channels. Like the fconv2d
+// kernels, the filter is not flipped (cross-correlation).
+//
+// NCHW: in [c_in][h][w], w [c_out][c_in][k][k], out [c_out][h_out][w_out]
+// NHWC: in [h][w][c_in], w [k][k][c_in][c_out], out [h_out][w_out][c_out]
+
+#ifndef _CONV_H_
+#define _CONV_H_
+
+#include <stdint.h>
+
+typedef enum { CONV_NCHW, CONV_NHWC } conv_layout_t;
+
+typedef struct {
+  conv_layout_t layout;
+  int64_t c_in;
+  int64_t h;
+  int64_t w;
+  int64_t c_out;
+  int64_t k;
+  int64_t stride;
+  int64_t dilation;
+  int64_t pad;
+} conv_t;
+
+static inline int64_t conv_h_out(const conv_t *c) {
+  return (c->h + 2 * c->pad - c->dilation * (c->k - 1) - 1) / c->stride + 1;
+}
+
+static inline int64_t conv_w_out(const conv_t *c) {
+  return (c->w + 2 * c->pad - c->dilation * (c->k - 1) - 1) / c->stride + 1;
+}
+
+// Scalar reference
+void conv2d_s(const conv_t *c, const double *in, const double *w, double *out);
+// Generic vector engine
+void conv2d_direct_v(const conv_t *c, const double *in, const double *w,
+                     double *out);
+// Return 1 if one of the specialised fconv2d/fconv3d kernels handles c
+int conv2d_fast_path(const conv_t *c);
+// Specialised kernel if there is one, generic engine otherwise
+void conv2d_v(const conv_t *c, const double *in, const double *w, double *out);
+
+#endif
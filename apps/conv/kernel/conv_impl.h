@@ -0,0 +1,189 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// LMUL-generic body of the direct convolution. This file has no include
+// guard: conv.c includes it once per LMUL, after defining the CV_* macros.
+// Do not include it directly.
+//
+// The output is computed in blocks of CV_NROWS vectors, which stay in the
+// registers until all the input channels and filter taps are accumulated.
+
+#define CV_ACC(r) CV_FT acc##r = CV_F(vfmv_v_f)(0, vl);
+#define CV_IN(r) CV_FT x##r;
+
+// NCHW: output rows oh0 .. oh0 + CV_NROWS - 1 (the ones past h_out are
+// skipped), columns ow0 .. ow0 + vl - 1, of output channel co
+static void CV_FN(nchw_block)(const conv_t *c, const double *in,
+                              const double *w, double *out, int64_t co,
+                              int64_t oh0, int64_t ow0, size_t vl) {
+  const int64_t h_out = conv_h_out(c), w_out = conv_w_out(c);
+  const int64_t s = c->stride, d = c->dilation, k = c->k;
+  const int64_t iw0 = ow0 * s - c->pad;
+  // The whole strip reads inside the input rows, for every tap
+  const int inner =
+      iw0 >= 0 && iw0 + ((int64_t)vl - 1) * s + (k - 1) * d < c->w;
+  const CV_UT idx = CV_U(vid_v)(vl);
+
+  CV_FOR_ROWS(CV_ACC)
+  CV_FOR_ROWS(CV_IN)
+
+  for (int64_t ci = 0; ci < c->c_in; ++ci) {
+    const double *in_c = in + ci * c->h * c->w;
+    for (int64_t kh = 0; kh < k; ++kh) {
+      const double *w_k = w + ((co * c->c_in + ci) * k + kh) * k;
+      // First input element of each output row, NULL if the input row is in
+      // the padding
+#define CV_ROW(r)                                                              \
+  const double *row##r = NULL;                                                 \
+  {                                                                            \
+    const int64_t ih = (oh0 + r) * s - c->pad + kh * d;                        \
+    if (oh0 + r < h_out && ih >= 0 && ih < c->h)                               \
+      row##r = in_c + ih * c->w + iw0;                                         \
+  }
+      CV_FOR_ROWS(CV_ROW)
+#undef CV_ROW
+
+      if (inner && s == 1 && d == 1) {
+        // Load each input row once, and slide it by one element per tap
+        for (int64_t kw = 0; kw < k; ++kw) {
+          const double wk = w_k[kw];
+#define CV_TAP(r)                                                              \
+  if (row##r) {                                                                \
+    x##r = kw ? CV_F(vfslide1down_vf)(x##r, row##r[vl + kw - 1], vl)           \
+              : CV_VLE(row##r, vl);                                            \
+    acc##r = CV_F(vfmacc_vf)(acc##r, wk, x##r, vl);                            \
+  }
+          CV_FOR_ROWS(CV_TAP)
+#undef CV_TAP
+        }
+        continue;
+      }
+
+      for (int64_t kw = 0; kw < k; ++kw) {
+        const int64_t off = iw0 + kw * d;
+        // Columns lo .. hi - 1 of the strip read inside the input row
+        int64_t lo = off >= 0 ? 0 : (s - 1 - off) / s;
+        int64_t hi = c->w > off ? (c->w - off + s - 1) / s : 0;
+        if (hi > (int64_t)vl)
+          hi = vl;
+        if (lo >= hi)
+          continue;
+        const double wk = w_k[kw];
+        if (lo == 0 && hi == (int64_t)vl) {
+#define CV_TAP(r)                                                              \
+  if (row##r) {                                                                \
+    x##r = s == 1 ? CV_VLE(row##r + kw * d, vl)                                \
+                  : CV_VLSE(row##r + kw * d, s * sizeof(double), vl);          \
+    acc##r = CV_F(vfmacc_vf)(acc##r, wk, x##r, vl);                            \
+  }
+          CV_FOR_ROWS(CV_TAP)
+#undef CV_TAP
+        } else {
+          // Partially in the padding: only the valid columns are loaded and
+          // accumulated
+          const CV_BT m = CV_B(vmand_mm)(CV_UB(vmsgeu_vx)(idx, lo, vl),
+                                         CV_UB(vmsltu_vx)(idx, hi, vl), vl);
+#define CV_TAP(r)                                                              \
+  if (row##r) {                                                                \
+    x##r = CV_VLSE_M(m, row##r + kw * d, s * sizeof(double), vl);              \
+    acc##r = CV_MU(CV_F(vfmacc_vf))(m, acc##r, wk, x##r, vl);                  \
+  }
+          CV_FOR_ROWS(CV_TAP)
+#undef CV_TAP
+        }
+      }
+    }
+  }
+
+  double *out_c = out + co * h_out * w_out + ow0;
+#define CV_STORE(r)                                                            \
+  if (oh0 + r < h_out)                                                         \
+    CV_VSE(out_c + (oh0 + r) * w_out, acc##r, vl);
+  CV_FOR_ROWS(CV_STORE)
+#undef CV_STORE
+}
+
+// NHWC: output pixels ow0 .. ow0 + CV_NROWS - 1 of row oh (the ones past w_out
+// are skipped), channels co0 .. co0 + vl - 1
+static void CV_FN(nhwc_block)(const conv_t *c, const double *in,
+                              const double *w, double *out, int64_t oh,
+                              int64_t ow0, int64_t co0, size_t vl) {
+  const int64_t w_out = conv_w_out(c);
+  const int64_t s = c->stride, d = c->dilation, k = c->k;
+
+  CV_FOR_ROWS(CV_ACC)
+
+  for (int64_t kh = 0; kh < k; ++kh) {
+    const int64_t ih = oh * s - c->pad + kh * d;
+    if (ih < 0 || ih >= c->h)
+      continue;
+    for (int64_t kw = 0; kw < k; ++kw) {
+      // Input channels of each output pixel, NULL if the pixel is in the
+      // padding
+#define CV_PIX(r)                                                              \
+  const double *pix##r = NULL;                                                 \
+  {                                                                            \
+    const int64_t iw = (ow0 + r) * s - c->pad + kw * d;                        \
+    if (ow0 + r < w_out && iw >= 0 && iw < c->w)                               \
+      pix##r = in + (ih * c->w + iw) * c->c_in;                                \
+  }
+      CV_FOR_ROWS(CV_PIX)
+#undef CV_PIX
+
+      const double *w_k = w + (kh * k + kw) * c->c_in * c->c_out + co0;
+      for (int64_t ci = 0; ci < c->c_in; ++ci) {
+        const CV_FT wv = CV_VLE(w_k + ci * c->c_out, vl);
+#define CV_TAP(r)                                                              \
+  if (pix##r)                                                                  \
+    acc##r = CV_F(vfmacc_vf)(acc##r, pix##r[ci], wv, vl);
+        CV_FOR_ROWS(CV_TAP)
+#undef CV_TAP
+      }
+    }
+  }
+
+  double *out_p = out + (oh * w_out + ow0) * c->c_out + co0;
+#define CV_STORE(r)                                                            \
+  if (ow0 + r < w_out)                                                         \
+    CV_VSE(out_p + r * c->c_out, acc##r, vl);
+  CV_FOR_ROWS(CV_STORE)
+#undef CV_STORE
+}
+
+static void CV_FN(run)(const conv_t *c, const double *in, const double *w,
+                       double *out) {
+  const int64_t h_out = conv_h_out(c), w_out = conv_w_out(c);
+  size_t vl;
+
+  if (c->layout == CONV_NCHW) {
+    for (int64_t co = 0; co < c->c_out; ++co)
+      for (int64_t oh = 0; oh < h_out; oh += CV_NROWS)
+        for (int64_t ow = 0; ow < w_out; ow += vl) {
+          vl = CV_VSETVL(w_out - ow);
+          CV_FN(nchw_block)(c, in, w, out, co, oh, ow, vl);
+        }
+  } else {
+    for (int64_t oh = 0; oh < h_out; ++oh)
+      for (int64_t ow = 0; ow < w_out; ow += CV_NROWS)
+        for (int64_t co = 0; co < c->c_out; co += vl) {
+          vl = CV_VSETVL(c->c_out - co);
+          CV_FN(nhwc_block)(c, in, w, out, oh, ow, co, vl);
+        }
+  }
+}
+
+#undef CV_ACC
+#undef CV_IN
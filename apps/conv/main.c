@@ -0,0 +1,135 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generic direct convolution on a set of CNN layer shapes, in both layouts.
+// Every layer is checked against the scalar reference. The shapes handled by
+// the fconv2d/fconv3d kernels also run on them, to compare the two.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/conv.h"
+#include "runtime.h"
+#include "util.h"
+
+#ifdef SPIKE
+#include <stdio.h>
+#elif defined ARA_LINUX
+#include <stdio.h>
+#else
+#include "printf.h"
+#endif
+
+// Threshold for FP numbers comparison during the final check
+#define THRESHOLD 0.000000001
+
+// Elements of each buffer
+extern uint64_t N;
+extern double in[] __attribute__((aligned(4 * NR_LANES)));
+extern double w[] __attribute__((aligned(4 * NR_LANES)));
+extern double o[] __attribute__((aligned(4 * NR_LANES)));
+extern double o_ref[] __attribute__((aligned(4 * NR_LANES)));
+
+typedef struct {
+  const char *name;
+  conv_t c;
+} layer_t;
+
+// layout, c_in, h, w, c_out, k, stride, dilation, pad
+static const layer_t layers[] = {
+    {"3x3 s1 p1", {CONV_NCHW, 8, 16, 16, 8, 3, 1, 1, 1}},
+    {"1x1", {CONV_NCHW, 16, 16, 16, 16, 1, 1, 1, 0}},
+    {"5x5 s1 p2", {CONV_NCHW, 4, 24, 24, 4, 5, 1, 1, 2}},
+    {"3x3 s2 p1", {CONV_NCHW, 8, 32, 32, 8, 3, 2, 1, 1}},
+    {"3x3 d2 p2", {CONV_NCHW, 4, 24, 24, 4, 3, 1, 2, 2}},
+    {"7x7 s2 p3", {CONV_NCHW, 3, 64, 64, 4, 7, 2, 1, 3}},
+    {"11x11 s4 p2", {CONV_NCHW, 3, 63, 63, 4, 11, 4, 1, 2}},
+    {"3x3 s1 p1", {CONV_NHWC, 16, 16, 16, 32, 3, 1, 1, 1}},
+    {"1x1", {CONV_NHWC, 32, 16, 16, 32, 1, 1, 1, 0}},
+    {"3x3 s2 p1", {CONV_NHWC, 16, 32, 32, 32, 3, 2, 1, 1}},
+    {"5x5 s1 p2", {CONV_NHWC, 8, 16, 16, 16, 5, 1, 1, 2}},
+    // Shapes of the specialised kernels
+    {"3x3", {CONV_NCHW, 1, 34, 34, 1, 3, 1, 1, 0}},
+    {"7x7", {CONV_NCHW, 1, 38, 38, 1, 7, 1, 1, 0}},
+    {"3x7x7", {CONV_NCHW, 3, 38, 38, 1, 7, 1, 1, 0}},
+};
+
+int check_output(const double *out, const double *ref, int64_t len) {
+  for (int64_t k = 0; k < len; ++k)
+    if (!similarity_check(out[k], ref[k], THRESHOLD)) {
+      printf("Error: o[%ld] = %lf, instead of %lf\n", k, out[k], ref[k]);
+      return 1;
+    }
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("==========\n");
+  printf("=  CONV  =\n");
+  printf("==========\n");
+  printf("\n");
+  printf("\n");
+
+  int error = 0;
+
+  printf("layer        layout  generic [cycles]  DPFLOP/cycle  "
+         "specialised [cycles]\n");
+
+  for (unsigned int l = 0; l < sizeof(layers) / sizeof(layers[0]); ++l) {
+    const conv_t *c = &layers[l].c;
+    const char *layout = c->layout == CONV_NCHW ? "NCHW" : "NHWC";
+    const int64_t in_len = c->c_in * c->h * c->w;
+    const int64_t w_len = c->c_out * c->c_in * c->k * c->k;
+    const int64_t o_len = c->c_out * conv_h_out(c) * conv_w_out(c);
+
+    if (in_len > (int64_t)N || w_len > (int64_t)N || o_len > (int64_t)N) {
+      printf("%-12s %-6s  skipped, larger than %lu elements\n", layers[l].name,
+             layout, N);
+      continue;
+    }
+
+    conv2d_s(c, in, w, o_ref);
+
+    memset(o, 0, o_len * sizeof(double));
+    start_timer();
+    conv2d_direct_v(c, in, w, o);
+    stop_timer();
+    int64_t runtime = get_timer();
+    error |= check_output(o, o_ref, o_len);
+    float performance = 2.0 * o_len * c->c_in * c->k * c->k / runtime;
+    printf("%-12s %-6s  %16ld  %12f", layers[l].name, layout, runtime,
+           performance);
+
+    if (conv2d_fast_path(c)) {
+      memset(o, 0, o_len * sizeof(double));
+      start_timer();
+      conv2d_v(c, in, w, o);
+      stop_timer();
+      runtime = get_timer();
+      error |= check_output(o, o_ref, o_len);
+      printf("  %20ld", runtime);
+    }
+    printf("\n");
+  }
+
+  if (error)
+    printf("\nFail.\n");
+  else
+    printf("\nPassed.\n");
+
+  return error;
+}
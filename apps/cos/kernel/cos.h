@@ -32,6 +32,9 @@
   (this is the zlib license)
 */
 
+#ifndef _COS_H_
+#define _COS_H_
+
 #include <stdio.h>
 #include <string.h>
 
@@ -283,3 +286,5 @@ inline _MMR_f32 __cos_2xf32(_MMR_f32 x, size_t gvl) {
 
   return y;
 }
+
+#endif
@@ -0,0 +1,424 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "wbp-imatmul.h"
+
+// Verify the matrix
+int wbp_imatmul_verify(int8_t *result, int8_t *gold, size_t R, size_t C) {
+  for (uint64_t i = 0; i < R; ++i) {
+    for (uint64_t j = 0; j < C; ++j) {
+      uint64_t idx = i * C + j;
+      if (result[idx] != gold[idx]) {
+        return (i + j) == 0 ? -1 : idx;
+      }
+    }
+  }
+  return 0;
+}
+
+void wbp_imatmul(int8_t *c, const int8_t *a, const int8_t *b,
+                 const unsigned int M, const unsigned int N,
+                 const unsigned int P, const unsigned int shift) {
+  // Round to nearest, ties up, when requantizing
+  asm volatile("csrwi vxrm, 0");
+
+  if (M <= 4) {
+    wbp_imatmul_4x4(c, a, b, M, N, P, shift);
+  } else if (M <= 128) {
+    // The accumulators are four times as wide as the operands, and the MACs
+    // work on sign-extended 16-bit rows of B. With an 8x8 wbp_imatmul, we can
+    // use LMUL=1 for the rows of B and LMUL=2 for C.
+    wbp_imatmul_8x8(c, a, b, M, N, P, shift);
+  } else {
+    // With an 4x4 wbp_imatmul, we can use LMUL=2 for the rows of B and LMUL=4
+    // for C, having a longer vl.
+    wbp_imatmul_4x4(c, a, b, M, N, P, shift);
+  }
+}
+
+// ---------------
+// 4x4
+// ---------------
+
+void wbp_imatmul_4x4(int8_t *c, const int8_t *a, const int8_t *b,
+                     const unsigned int M, const unsigned int N,
+                     const unsigned int P, const unsigned int shift) {
+  // We work on 4 rows of the matrix at once
+  unsigned int block_size = 4;
+  unsigned int block_size_p;
+
+  // Set the vector configuration. The rows of B are loaded as 8-bit elements,
+  // sign-extended to 16 bits, and accumulated with widening MACs on 32 bits.
+  asm volatile("vsetvli %0, %1, e16, m2, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  // Slice the matrix into a manageable number of columns p_
+  for (unsigned int p = 0; p < P; p += block_size_p) {
+    // Set the vector length
+    unsigned int p_ = MIN(P - p, block_size_p);
+
+    // Find pointers to the submatrices
+    const int8_t *b_ = b + p;
+    int8_t *c_ = c + p;
+
+    asm volatile("vsetvli zero, %0, e16, m2, ta, ma" ::"r"(p_));
+
+    // Iterate over the rows
+    for (unsigned int m = 0; m < M; m += block_size) {
+      // Find pointer to the submatrices
+      const int8_t *a_ = a + m * N;
+      int8_t *c__ = c_ + m * P;
+
+      wbp_imatmul_vec_4x4_slice_init();
+      wbp_imatmul_vec_4x4(c__, a_, b_, N, P, shift);
+    }
+  }
+}
+
+void wbp_imatmul_vec_4x4_slice_init() {
+  // Same vl, with 32-bit elements
+  asm volatile("vsetvli zero, zero, e32, m4, ta, ma");
+  asm volatile("vmv.v.i v0,  0");
+  asm volatile("vmv.v.i v4,  0");
+  asm volatile("vmv.v.i v8,  0");
+  asm volatile("vmv.v.i v12, 0");
+  asm volatile("vsetvli zero, zero, e16, m2, ta, ma");
+}
+
+void wbp_imatmul_vec_4x4(int8_t *c, const int8_t *a, const int8_t *b,
+                         const unsigned int N, const unsigned int P,
+                         const unsigned int shift) {
+  // Temporary variables
+  int64_t t0, t1, t2, t3;
+
+  // Original pointer
+  const int8_t *a_ = a;
+
+  // Prefetch one row of matrix B
+  asm volatile("vle8.v v24, (%0);" ::"r"(b));
+  asm volatile("vsext.vf2 v16, v24");
+  b += P;
+
+  // Prefetch one row of scalar values
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t0) : [a] "r"(a));
+  a += N;
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t1) : [a] "r"(a));
+  a += N;
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t2) : [a] "r"(a));
+  a += N;
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t3) : [a] "r"(a));
+
+  // Compute the multiplication
+  unsigned int n = 1;
+
+  while (n < N) {
+    // Calculate pointer to the matrix A
+    a = (const int8_t *)a_ + n;
+
+    asm volatile("vwmacc.vx v0, %0, v16" ::"r"(t0));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t0) : [a] "r"(a));
+    a += N;
+
+    // Load one row of B
+    asm volatile("vle8.v v24, (%0);" ::"r"(b));
+    asm volatile("vsext.vf2 v20, v24");
+    b += P;
+
+    asm volatile("vwmacc.vx v4, %0, v16" ::"r"(t1));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t1) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v8, %0, v16" ::"r"(t2));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t2) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v12, %0, v16" ::"r"(t3));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t3) : [a] "r"(a));
+
+    if (++n == N)
+      break;
+
+    // Calculate pointer to the matrix A
+    a = (const int8_t *)a_ + n;
+
+    asm volatile("vwmacc.vx v0, %0, v20" ::"r"(t0));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t0) : [a] "r"(a));
+    a += N;
+
+    // Load one row of B
+    asm volatile("vle8.v v24, (%0);" ::"r"(b));
+    asm volatile("vsext.vf2 v16, v24");
+    b += P;
+
+    asm volatile("vwmacc.vx v4, %0, v20" ::"r"(t1));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t1) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v8, %0, v20" ::"r"(t2));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t2) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v12, %0, v20" ::"r"(t3));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t3) : [a] "r"(a));
+    ++n;
+  }
+
+  // Last iteration: the last row of B is in v16 if N is odd, and in v20
+  // otherwise
+  if (N & 1) {
+    asm volatile("vwmacc.vx v0, %0, v16" ::"r"(t0));
+    asm volatile("vwmacc.vx v4, %0, v16" ::"r"(t1));
+    asm volatile("vwmacc.vx v8, %0, v16" ::"r"(t2));
+    asm volatile("vwmacc.vx v12, %0, v16" ::"r"(t3));
+  } else {
+    asm volatile("vwmacc.vx v0, %0, v20" ::"r"(t0));
+    asm volatile("vwmacc.vx v4, %0, v20" ::"r"(t1));
+    asm volatile("vwmacc.vx v8, %0, v20" ::"r"(t2));
+    asm volatile("vwmacc.vx v12, %0, v20" ::"r"(t3));
+  }
+
+  // Requantize and store the results: round and shift the accumulators,
+  // then saturate them to 16 and to 8 bits
+  asm volatile("vnclip.wx v16, v0, %0" ::"r"(shift));
+  asm volatile("vnclip.wx v18, v4, %0" ::"r"(shift));
+  asm volatile("vnclip.wx v20, v8, %0" ::"r"(shift));
+  asm volatile("vnclip.wx v22, v12, %0" ::"r"(shift));
+  asm volatile("vsetvli zero, zero, e8, m1, ta, ma");
+  asm volatile("vnclip.wi v24, v16, 0");
+  asm volatile("vse8.v v24, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vnclip.wi v25, v18, 0");
+  asm volatile("vse8.v v25, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vnclip.wi v26, v20, 0");
+  asm volatile("vse8.v v26, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vnclip.wi v27, v22, 0");
+  asm volatile("vse8.v v27, (%0);" ::"r"(c));
+  asm volatile("vsetvli zero, zero, e16, m2, ta, ma");
+}
+
+// ---------------
+// 8x8
+// ---------------
+
+void wbp_imatmul_8x8(int8_t *c, const int8_t *a, const int8_t *b,
+                     const unsigned int M, const unsigned int N,
+                     const unsigned int P, const unsigned int shift) {
+  // We work on 8 rows of the matrix at once
+  unsigned int block_size = 8;
+  unsigned int block_size_p;
+
+  // Set the vector configuration
+  asm volatile("vsetvli %0, %1, e16, m1, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  // Slice the matrix into a manageable number of columns p_
+  for (unsigned int p = 0; p < P; p += block_size_p) {
+    // Set the vector length
+    unsigned int p_ = MIN(P - p, block_size_p);
+
+    // Find pointers to the submatrices
+    const int8_t *b_ = b + p;
+    int8_t *c_ = c + p;
+
+    asm volatile("vsetvli zero, %0, e16, m1, ta, ma" ::"r"(p_));
+
+    // Iterate over the rows
+    for (unsigned int m = 0; m < M; m += block_size) {
+      // Find pointer to the submatrices
+      const int8_t *a_ = a + m * N;
+      int8_t *c__ = c_ + m * P;
+
+      wbp_imatmul_vec_8x8_slice_init();
+      wbp_imatmul_vec_8x8(c__, a_, b_, N, P, shift);
+    }
+  }
+}
+
+void wbp_imatmul_vec_8x8_slice_init() {
+  // Same vl, with 32-bit elements
+  asm volatile("vsetvli zero, zero, e32, m2, ta, ma");
+  asm volatile("vmv.v.i v0,  0");
+  asm volatile("vmv.v.i v2,  0");
+  asm volatile("vmv.v.i v4,  0");
+  asm volatile("vmv.v.i v6,  0");
+  asm volatile("vmv.v.i v8,  0");
+  asm volatile("vmv.v.i v10, 0");
+  asm volatile("vmv.v.i v12, 0");
+  asm volatile("vmv.v.i v14, 0");
+  asm volatile("vsetvli zero, zero, e16, m1, ta, ma");
+}
+
+void wbp_imatmul_vec_8x8(int8_t *c, const int8_t *a, const int8_t *b,
+                         const unsigned int N, const unsigned int P,
+                         const unsigned int shift) {
+  // Temporary variables
+  int64_t t0, t1, t2, t3, t4, t5, t6, t7;
+
+  // Original pointer
+  const int8_t *a_ = a;
+
+  // Prefetch one row of matrix B
+  asm volatile("vle8.v v24, (%0);" ::"r"(b));
+  asm volatile("vsext.vf2 v16, v24");
+  b += P;
+
+  // Prefetch one row of scalar values
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t0) : [a] "r"(a));
+  a += N;
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t1) : [a] "r"(a));
+  a += N;
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t2) : [a] "r"(a));
+  a += N;
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t3) : [a] "r"(a));
+  a += N;
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t4) : [a] "r"(a));
+  a += N;
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t5) : [a] "r"(a));
+  a += N;
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t6) : [a] "r"(a));
+  a += N;
+  asm volatile("lb %[t], (%[a])" : [t] "=r"(t7) : [a] "r"(a));
+
+  // Compute the multiplication
+  unsigned int n = 1;
+
+  while (n < N) {
+    // Calculate pointer to the matrix A
+    a = (const int8_t *)a_ + n;
+
+    asm volatile("vwmacc.vx v0, %0, v16" ::"r"(t0));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t0) : [a] "r"(a));
+    a += N;
+
+    // Load one row of B
+    asm volatile("vle8.v v24, (%0);" ::"r"(b));
+    asm volatile("vsext.vf2 v18, v24");
+    b += P;
+
+    asm volatile("vwmacc.vx v2, %0, v16" ::"r"(t1));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t1) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v4, %0, v16" ::"r"(t2));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t2) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v6, %0, v16" ::"r"(t3));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t3) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v8, %0, v16" ::"r"(t4));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t4) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v10, %0, v16" ::"r"(t5));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t5) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v12, %0, v16" ::"r"(t6));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t6) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v14, %0, v16" ::"r"(t7));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t7) : [a] "r"(a));
+
+    if (++n == N)
+      break;
+
+    // Calculate pointer to the matrix A
+    a = (const int8_t *)a_ + n;
+
+    asm volatile("vwmacc.vx v0, %0, v18" ::"r"(t0));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t0) : [a] "r"(a));
+    a += N;
+
+    // Load one row of B
+    asm volatile("vle8.v v24, (%0);" ::"r"(b));
+    asm volatile("vsext.vf2 v16, v24");
+    b += P;
+
+    asm volatile("vwmacc.vx v2, %0, v18" ::"r"(t1));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t1) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v4, %0, v18" ::"r"(t2));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t2) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v6, %0, v18" ::"r"(t3));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t3) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v8, %0, v18" ::"r"(t4));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t4) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v10, %0, v18" ::"r"(t5));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t5) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v12, %0, v18" ::"r"(t6));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t6) : [a] "r"(a));
+    a += N;
+    asm volatile("vwmacc.vx v14, %0, v18" ::"r"(t7));
+    asm volatile("lb %[t], (%[a])" : [t] "=r"(t7) : [a] "r"(a));
+    ++n;
+  }
+
+  // Last iteration: the last row of B is in v16 if N is odd, and in v18
+  // otherwise
+  if (N & 1) {
+    asm volatile("vwmacc.vx v0, %0, v16" ::"r"(t0));
+    asm volatile("vwmacc.vx v2, %0, v16" ::"r"(t1));
+    asm volatile("vwmacc.vx v4, %0, v16" ::"r"(t2));
+    asm volatile("vwmacc.vx v6, %0, v16" ::"r"(t3));
+    asm volatile("vwmacc.vx v8, %0, v16" ::"r"(t4));
+    asm volatile("vwmacc.vx v10, %0, v16" ::"r"(t5));
+    asm volatile("vwmacc.vx v12, %0, v16" ::"r"(t6));
+    asm volatile("vwmacc.vx v14, %0, v16" ::"r"(t7));
+  } else {
+    asm volatile("vwmacc.vx v0, %0, v18" ::"r"(t0));
+    asm volatile("vwmacc.vx v2, %0, v18" ::"r"(t1));
+    asm volatile("vwmacc.vx v4, %0, v18" ::"r"(t2));
+    asm volatile("vwmacc.vx v6, %0, v18" ::"r"(t3));
+    asm volatile("vwmacc.vx v8, %0, v18" ::"r"(t4));
+    asm volatile("vwmacc.vx v10, %0, v18" ::"r"(t5));
+    asm volatile("vwmacc.vx v12, %0, v18" ::"r"(t6));
+    asm volatile("vwmacc.vx v14, %0, v18" ::"r"(t7));
+  }
+
+  // Requantize and store the results: round and shift the accumulators,
+  // then saturate them to 16 and to 8 bits
+  asm volatile("vnclip.wx v16, v0, %0" ::"r"(shift));
+  asm volatile("vnclip.wx v17, v2, %0" ::"r"(shift));
+  asm volatile("vnclip.wx v18, v4, %0" ::"r"(shift));
+  asm volatile("vnclip.wx v19, v6, %0" ::"r"(shift));
+  asm volatile("vnclip.wx v20, v8, %0" ::"r"(shift));
+  asm volatile("vnclip.wx v21, v10, %0" ::"r"(shift));
+  asm volatile("vnclip.wx v22, v12, %0" ::"r"(shift));
+  asm volatile("vnclip.wx v23, v14, %0" ::"r"(shift));
+  asm volatile("vsetvli zero, zero, e8, mf2, ta, ma");
+  asm volatile("vnclip.wi v24, v16, 0");
+  asm volatile("vse8.v v24, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vnclip.wi v25, v17, 0");
+  asm volatile("vse8.v v25, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vnclip.wi v26, v18, 0");
+  asm volatile("vse8.v v26, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vnclip.wi v27, v19, 0");
+  asm volatile("vse8.v v27, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vnclip.wi v28, v20, 0");
+  asm volatile("vse8.v v28, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vnclip.wi v29, v21, 0");
+  asm volatile("vse8.v v29, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vnclip.wi v30, v22, 0");
+  asm volatile("vse8.v v30, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vnclip.wi v31, v23, 0");
+  asm volatile("vse8.v v31, (%0);" ::"r"(c));
+  asm volatile("vsetvli zero, zero, e16, m1, ta, ma");
+}
@@ -0,0 +1,61 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Mixed-precision matmul: 8-bit integer inputs, 32-bit integer accumulation,
+// and 8-bit integer result, requantized on store.
+
+#ifndef WBP_IMATMUL_H
+#define WBP_IMATMUL_H
+
+#include "util.h"
+#include <stdint.h>
+#include <string.h>
+
+// Help calculate performance
+// How many parallel elements in an ELEN-wide FPU data bus?
+// The widening MACs produce 32-bit elements
+#define DTYPE_FACTOR 2
+
+extern int64_t event_trigger;
+
+// C = AB with A=[MxN], B=[NxP], C=[MxP]. M must be a multiple of the block
+// size, i.e., of 4 if M <= 4 or M > 128, and of 8 otherwise.
+// The 32-bit results are shifted right by shift bits, rounding to nearest (ties
+// up), and saturated to 8 bits.
+void wbp_imatmul(int8_t *c, const int8_t *a, const int8_t *b,
+                 const unsigned int m, const unsigned int n,
+                 const unsigned int p, const unsigned int shift);
+
+void wbp_imatmul_4x4(int8_t *c, const int8_t *a, const int8_t *b,
+                     const unsigned int m, const unsigned int n,
+                     const unsigned int p, const unsigned int shift);
+void wbp_imatmul_vec_4x4_slice_init();
+void wbp_imatmul_vec_4x4(int8_t *c, const int8_t *a, const int8_t *b,
+                         const unsigned int n, const unsigned int p,
+                         const unsigned int shift);
+
+void wbp_imatmul_8x8(int8_t *c, const int8_t *a, const int8_t *b,
+                     const unsigned int m, const unsigned int n,
+                     const unsigned int p, const unsigned int shift);
+void wbp_imatmul_vec_8x8_slice_init();
+void wbp_imatmul_vec_8x8(int8_t *c, const int8_t *a, const int8_t *b,
+                         const unsigned int n, const unsigned int p,
+                         const unsigned int shift);
+
+int wbp_imatmul_verify(int8_t *result, int8_t *gold, size_t R, size_t C);
+
+#endif
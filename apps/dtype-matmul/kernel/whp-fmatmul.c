@@ -0,0 +1,387 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "whp-fmatmul.h"
+
+// Verify the matrix
+int whp_fmatmul_verify(float *result, float *gold, size_t R, size_t C,
+                       float threshold) {
+  for (uint64_t i = 0; i < R; ++i) {
+    for (uint64_t j = 0; j < C; ++j) {
+      uint64_t idx = i * C + j;
+      if (!similarity_check_32b(result[idx], gold[idx], threshold)) {
+        return (i + j) == 0 ? -1 : idx;
+      }
+    }
+  }
+  return 0;
+}
+
+void whp_fmatmul(float *c, const _Float16 *a, const _Float16 *b,
+                 const unsigned int M, const unsigned int N,
+                 const unsigned int P) {
+  if (M <= 4) {
+    whp_fmatmul_4x4(c, a, b, M, N, P);
+  } else if (M <= 128) {
+    // The accumulators are twice as wide as the operands. With an 8x8
+    // whp_fmatmul, we can use LMUL=1 for B and LMUL=2 for C.
+    whp_fmatmul_8x8(c, a, b, M, N, P);
+  } else {
+    // With an 4x4 whp_fmatmul, we can use LMUL=2 for B and LMUL=4 for C,
+    // having a longer vl.
+    whp_fmatmul_4x4(c, a, b, M, N, P);
+  }
+}
+
+// ---------------
+// 4x4
+// ---------------
+
+void whp_fmatmul_4x4(float *c, const _Float16 *a, const _Float16 *b,
+                     const unsigned int M, const unsigned int N,
+                     const unsigned int P) {
+  // We work on 4 rows of the matrix at once
+  unsigned int block_size = 4;
+  unsigned int block_size_p;
+
+  // Set the vector configuration. The widening FMAs run with the SEW of the
+  // operands, and write back twice as wide elements.
+  asm volatile("vsetvli %0, %1, e16, m2, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  // Slice the matrix into a manageable number of columns p_
+  for (unsigned int p = 0; p < P; p += block_size_p) {
+    // Set the vector length
+    unsigned int p_ = MIN(P - p, block_size_p);
+
+    // Find pointers to the submatrices
+    const _Float16 *b_ = b + p;
+    float *c_ = c + p;
+
+    asm volatile("vsetvli zero, %0, e16, m2, ta, ma" ::"r"(p_));
+
+    // Iterate over the rows
+    for (unsigned int m = 0; m < M; m += block_size) {
+      // Find pointer to the submatrices
+      const _Float16 *a_ = a + m * N;
+      float *c__ = c_ + m * P;
+
+      whp_fmatmul_vec_4x4_slice_init();
+      whp_fmatmul_vec_4x4(c__, a_, b_, N, P);
+    }
+  }
+}
+
+void whp_fmatmul_vec_4x4_slice_init() {
+  // Same vl, with single-precision elements
+  asm volatile("vsetvli zero, zero, e32, m4, ta, ma");
+  asm volatile("vmv.v.i v0,  0");
+  asm volatile("vmv.v.i v4,  0");
+  asm volatile("vmv.v.i v8,  0");
+  asm volatile("vmv.v.i v12, 0");
+  asm volatile("vsetvli zero, zero, e16, m2, ta, ma");
+}
+
+void whp_fmatmul_vec_4x4(float *c, const _Float16 *a, const _Float16 *b,
+                         const unsigned int N, const unsigned int P) {
+  // Temporary variables
+  _Float16 t0, t1, t2, t3;
+
+  // Original pointer
+  const _Float16 *a_ = a;
+
+  // Prefetch one row of matrix B
+  asm volatile("vle16.v v16, (%0);" ::"r"(b));
+  b += P;
+
+  // Prefetch one row of scalar values
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t0) : [a] "r"(a));
+  a += N;
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t1) : [a] "r"(a));
+  a += N;
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t2) : [a] "r"(a));
+  a += N;
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t3) : [a] "r"(a));
+
+  // Compute the multiplication
+  unsigned int n = 1;
+
+  while (n < N) {
+    // Calculate pointer to the matrix A
+    a = (const _Float16 *)a_ + n;
+
+    asm volatile("vfwmacc.vf v0, %0, v16" ::"f"(t0));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t0) : [a] "r"(a));
+    a += N;
+
+    // Load one row of B
+    asm volatile("vle16.v v20, (%0);" ::"r"(b));
+    b += P;
+
+    asm volatile("vfwmacc.vf v4, %0, v16" ::"f"(t1));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t1) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v8, %0, v16" ::"f"(t2));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t2) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v12, %0, v16" ::"f"(t3));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t3) : [a] "r"(a));
+
+    if (++n == N)
+      break;
+
+    // Calculate pointer to the matrix A
+    a = (const _Float16 *)a_ + n;
+
+    asm volatile("vfwmacc.vf v0, %0, v20" ::"f"(t0));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t0) : [a] "r"(a));
+    a += N;
+
+    // Load one row of B
+    asm volatile("vle16.v v16, (%0);" ::"r"(b));
+    b += P;
+
+    asm volatile("vfwmacc.vf v4, %0, v20" ::"f"(t1));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t1) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v8, %0, v20" ::"f"(t2));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t2) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v12, %0, v20" ::"f"(t3));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t3) : [a] "r"(a));
+    ++n;
+  }
+
+  // Last iteration: the last row of B is in v16 if N is odd, and in v20
+  // otherwise
+  if (N & 1) {
+    asm volatile("vfwmacc.vf v0, %0, v16" ::"f"(t0));
+    asm volatile("vfwmacc.vf v4, %0, v16" ::"f"(t1));
+    asm volatile("vfwmacc.vf v8, %0, v16" ::"f"(t2));
+    asm volatile("vfwmacc.vf v12, %0, v16" ::"f"(t3));
+  } else {
+    asm volatile("vfwmacc.vf v0, %0, v20" ::"f"(t0));
+    asm volatile("vfwmacc.vf v4, %0, v20" ::"f"(t1));
+    asm volatile("vfwmacc.vf v8, %0, v20" ::"f"(t2));
+    asm volatile("vfwmacc.vf v12, %0, v20" ::"f"(t3));
+  }
+
+  // Store the results
+  asm volatile("vsetvli zero, zero, e32, m4, ta, ma");
+  asm volatile("vse32.v v0, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v4, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v8, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v12, (%0);" ::"r"(c));
+  asm volatile("vsetvli zero, zero, e16, m2, ta, ma");
+}
+
+// ---------------
+// 8x8
+// ---------------
+
+void whp_fmatmul_8x8(float *c, const _Float16 *a, const _Float16 *b,
+                     const unsigned int M, const unsigned int N,
+                     const unsigned int P) {
+  // We work on 8 rows of the matrix at once
+  unsigned int block_size = 8;
+  unsigned int block_size_p;
+
+  // Set the vector configuration
+  asm volatile("vsetvli %0, %1, e16, m1, ta, ma" : "=r"(block_size_p) : "r"(P));
+
+  // Slice the matrix into a manageable number of columns p_
+  for (unsigned int p = 0; p < P; p += block_size_p) {
+    // Set the vector length
+    unsigned int p_ = MIN(P - p, block_size_p);
+
+    // Find pointers to the submatrices
+    const _Float16 *b_ = b + p;
+    float *c_ = c + p;
+
+    asm volatile("vsetvli zero, %0, e16, m1, ta, ma" ::"r"(p_));
+
+    // Iterate over the rows
+    for (unsigned int m = 0; m < M; m += block_size) {
+      // Find pointer to the submatrices
+      const _Float16 *a_ = a + m * N;
+      float *c__ = c_ + m * P;
+
+      whp_fmatmul_vec_8x8_slice_init();
+      whp_fmatmul_vec_8x8(c__, a_, b_, N, P);
+    }
+  }
+}
+
+void whp_fmatmul_vec_8x8_slice_init() {
+  // Same vl, with single-precision elements
+  asm volatile("vsetvli zero, zero, e32, m2, ta, ma");
+  asm volatile("vmv.v.i v0,  0");
+  asm volatile("vmv.v.i v2,  0");
+  asm volatile("vmv.v.i v4,  0");
+  asm volatile("vmv.v.i v6,  0");
+  asm volatile("vmv.v.i v8,  0");
+  asm volatile("vmv.v.i v10, 0");
+  asm volatile("vmv.v.i v12, 0");
+  asm volatile("vmv.v.i v14, 0");
+  asm volatile("vsetvli zero, zero, e16, m1, ta, ma");
+}
+
+void whp_fmatmul_vec_8x8(float *c, const _Float16 *a, const _Float16 *b,
+                         const unsigned int N, const unsigned int P) {
+  // Temporary variables
+  _Float16 t0, t1, t2, t3, t4, t5, t6, t7;
+
+  // Original pointer
+  const _Float16 *a_ = a;
+
+  // Prefetch one row of matrix B
+  asm volatile("vle16.v v16, (%0);" ::"r"(b));
+  b += P;
+
+  // Prefetch one row of scalar values
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t0) : [a] "r"(a));
+  a += N;
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t1) : [a] "r"(a));
+  a += N;
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t2) : [a] "r"(a));
+  a += N;
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t3) : [a] "r"(a));
+  a += N;
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t4) : [a] "r"(a));
+  a += N;
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t5) : [a] "r"(a));
+  a += N;
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t6) : [a] "r"(a));
+  a += N;
+  asm volatile("flh %[t], (%[a])" : [t] "=f"(t7) : [a] "r"(a));
+
+  // Compute the multiplication
+  unsigned int n = 1;
+
+  while (n < N) {
+    // Calculate pointer to the matrix A
+    a = (const _Float16 *)a_ + n;
+
+    asm volatile("vfwmacc.vf v0, %0, v16" ::"f"(t0));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t0) : [a] "r"(a));
+    a += N;
+
+    // Load one row of B
+    asm volatile("vle16.v v18, (%0);" ::"r"(b));
+    b += P;
+
+    asm volatile("vfwmacc.vf v2, %0, v16" ::"f"(t1));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t1) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v4, %0, v16" ::"f"(t2));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t2) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v6, %0, v16" ::"f"(t3));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t3) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v8, %0, v16" ::"f"(t4));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t4) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v10, %0, v16" ::"f"(t5));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t5) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v12, %0, v16" ::"f"(t6));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t6) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v14, %0, v16" ::"f"(t7));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t7) : [a] "r"(a));
+
+    if (++n == N)
+      break;
+
+    // Calculate pointer to the matrix A
+    a = (const _Float16 *)a_ + n;
+
+    asm volatile("vfwmacc.vf v0, %0, v18" ::"f"(t0));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t0) : [a] "r"(a));
+    a += N;
+
+    // Load one row of B
+    asm volatile("vle16.v v16, (%0);" ::"r"(b));
+    b += P;
+
+    asm volatile("vfwmacc.vf v2, %0, v18" ::"f"(t1));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t1) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v4, %0, v18" ::"f"(t2));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t2) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v6, %0, v18" ::"f"(t3));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t3) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v8, %0, v18" ::"f"(t4));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t4) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v10, %0, v18" ::"f"(t5));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t5) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v12, %0, v18" ::"f"(t6));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t6) : [a] "r"(a));
+    a += N;
+    asm volatile("vfwmacc.vf v14, %0, v18" ::"f"(t7));
+    asm volatile("flh %[t], (%[a])" : [t] "=f"(t7) : [a] "r"(a));
+    ++n;
+  }
+
+  // Last iteration: the last row of B is in v16 if N is odd, and in v18
+  // otherwise
+  if (N & 1) {
+    asm volatile("vfwmacc.vf v0, %0, v16" ::"f"(t0));
+    asm volatile("vfwmacc.vf v2, %0, v16" ::"f"(t1));
+    asm volatile("vfwmacc.vf v4, %0, v16" ::"f"(t2));
+    asm volatile("vfwmacc.vf v6, %0, v16" ::"f"(t3));
+    asm volatile("vfwmacc.vf v8, %0, v16" ::"f"(t4));
+    asm volatile("vfwmacc.vf v10, %0, v16" ::"f"(t5));
+    asm volatile("vfwmacc.vf v12, %0, v16" ::"f"(t6));
+    asm volatile("vfwmacc.vf v14, %0, v16" ::"f"(t7));
+  } else {
+    asm volatile("vfwmacc.vf v0, %0, v18" ::"f"(t0));
+    asm volatile("vfwmacc.vf v2, %0, v18" ::"f"(t1));
+    asm volatile("vfwmacc.vf v4, %0, v18" ::"f"(t2));
+    asm volatile("vfwmacc.vf v6, %0, v18" ::"f"(t3));
+    asm volatile("vfwmacc.vf v8, %0, v18" ::"f"(t4));
+    asm volatile("vfwmacc.vf v10, %0, v18" ::"f"(t5));
+    asm volatile("vfwmacc.vf v12, %0, v18" ::"f"(t6));
+    asm volatile("vfwmacc.vf v14, %0, v18" ::"f"(t7));
+  }
+
+  // Store the results
+  asm volatile("vsetvli zero, zero, e32, m2, ta, ma");
+  asm volatile("vse32.v v0, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v2, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v4, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v6, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v8, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v10, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v12, (%0);" ::"r"(c));
+  c += P;
+  asm volatile("vse32.v v14, (%0);" ::"r"(c));
+  asm volatile("vsetvli zero, zero, e16, m1, ta, ma");
+}
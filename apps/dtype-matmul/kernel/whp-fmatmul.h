@@ -0,0 +1,60 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Mixed-precision matmul: half-precision inputs, single-precision accumulation
+// and result.
+
+#ifndef WHP_FMATMUL_H
+#define WHP_FMATMUL_H
+
+#include "util.h"
+#include <stdint.h>
+#include <string.h>
+
+#define THRESHOLD 0.001
+
+// Help calculate performance
+// How many parallel elements in an ELEN-wide FPU data bus?
+// The widening FMAs produce single-precision elements
+#define DTYPE_FACTOR 2
+
+extern int64_t event_trigger;
+
+// C = AB with A=[MxN], B=[NxP], C=[MxP]. M must be a multiple of the block
+// size, i.e., of 4 if M <= 4 or M > 128, and of 8 otherwise.
+void whp_fmatmul(float *c, const _Float16 *a, const _Float16 *b,
+                 const unsigned int m, const unsigned int n,
+                 const unsigned int p);
+
+void whp_fmatmul_4x4(float *c, const _Float16 *a, const _Float16 *b,
+                     const unsigned int m, const unsigned int n,
+                     const unsigned int p);
+void whp_fmatmul_vec_4x4_slice_init();
+void whp_fmatmul_vec_4x4(float *c, const _Float16 *a, const _Float16 *b,
+                         const unsigned int n, const unsigned int p);
+
+void whp_fmatmul_8x8(float *c, const _Float16 *a, const _Float16 *b,
+                     const unsigned int m, const unsigned int n,
+                     const unsigned int p);
+void whp_fmatmul_vec_8x8_slice_init();
+void whp_fmatmul_vec_8x8(float *c, const _Float16 *a, const _Float16 *b,
+                         const unsigned int n, const unsigned int p);
+
+int whp_fmatmul_verify(float *result, float *gold, size_t R, size_t C,
+                       float threshold);
+
+#endif
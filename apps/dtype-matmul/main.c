@@ -39,6 +39,9 @@
 #define INT32 5
 #define INT16 6
 #define INT8 7
+// Mixed precision: narrow inputs, wide accumulation
+#define FLOAT16_32 8
+#define INT8_32 9
 
 // Map DTYPE to the actual data type
 #ifndef DTYPE
@@ -47,55 +50,100 @@
 #define DTYPE FLOAT64
 #endif
 
+// _PAIR describes the input, accumulation and result types
 #if DTYPE == FLOAT64
 typedef double _DTYPE;
 #define _KERNEL dp_fmatmul
+#define _PAIR "float64"
+#define _OP "FLOP"
 #define _VERIFY dp_fmatmul_verify
 #include "kernel/dp-fmatmul.h"
 #elif DTYPE == FLOAT32
 typedef float _DTYPE;
 #define _KERNEL sp_fmatmul
+#define _PAIR "float32"
+#define _OP "FLOP"
 #define _VERIFY sp_fmatmul_verify
 #include "kernel/sp-fmatmul.h"
 #elif DTYPE == FLOAT16
 typedef _Float16 _DTYPE;
 #define _KERNEL hp_fmatmul
+#define _PAIR "float16"
+#define _OP "FLOP"
 #define _VERIFY hp_fmatmul_verify
 #include "kernel/hp-fmatmul.h"
 #elif DTYPE == INT64
 typedef int64_t _DTYPE;
 #define _KERNEL dp_imatmul
+#define _PAIR "int64"
+#define _OP "OP"
 #define _VERIFY dp_imatmul_verify
 #include "kernel/dp-imatmul.h"
 #elif DTYPE == INT32
 typedef int32_t _DTYPE;
 #define _KERNEL sp_imatmul
+#define _PAIR "int32"
+#define _OP "OP"
 #define _VERIFY sp_imatmul_verify
 #include "kernel/sp-imatmul.h"
 #elif DTYPE == INT16
 typedef int16_t _DTYPE;
 #define _KERNEL hp_imatmul
+#define _PAIR "int16"
+#define _OP "OP"
 #define _VERIFY hp_imatmul_verify
 #include "kernel/hp-imatmul.h"
 #elif DTYPE == INT8
 typedef int8_t _DTYPE;
 #define _KERNEL bp_imatmul
+#define _PAIR "int8"
+#define _OP "OP"
 #define _VERIFY bp_imatmul_verify
 #include "kernel/bp-imatmul.h"
+#elif DTYPE == FLOAT16_32
+typedef _Float16 _DTYPE;
+typedef float _CTYPE;
+#define _KERNEL whp_fmatmul
+#define _PAIR "float16 -> float32"
+#define _OP "FLOP"
+#define _VERIFY whp_fmatmul_verify
+#include "kernel/whp-fmatmul.h"
+#elif DTYPE == INT8_32
+typedef int8_t _DTYPE;
+typedef int8_t _CTYPE;
+#define _KERNEL wbp_imatmul
+#define _KERNEL_ARGS c, a, b, M, N, P, S
+#define _PAIR "int8 -> int32 -> int8"
+#define _OP "OP"
+#define _VERIFY wbp_imatmul_verify
+#include "kernel/wbp-imatmul.h"
 #else
 #error "Unsupported data type"
 #endif
 
+// Unless mixed precision, the result has the same type as the inputs
+#if DTYPE != FLOAT16_32 && DTYPE != INT8_32
+typedef _DTYPE _CTYPE;
+#endif
+
+#ifndef _KERNEL_ARGS
+#define _KERNEL_ARGS c, a, b, M, N, P
+#endif
+
 // Define Matrix dimensions:
 // C = AB with A=[MxN], B=[NxP], C=[MxP]
 extern uint64_t M;
 extern uint64_t N;
 extern uint64_t P;
+#if DTYPE == INT8_32
+// Requantization shift
+extern uint64_t S;
+#endif
 
 extern _DTYPE a[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
 extern _DTYPE b[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
-extern _DTYPE c[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
-extern _DTYPE g[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern _CTYPE c[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern _CTYPE g[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
 
 int main() {
   printf("\n");
@@ -116,11 +164,11 @@ int main() {
   printf("Calculating matmul...\n");
   int unsigned loop_cont = 1;
   do {
-    _KERNEL(c, a, b, M, N, P);
+    _KERNEL(_KERNEL_ARGS);
   } while (--loop_cont != 0);
 
   start_timer();
-  _KERNEL(c, a, b, M, N, P);
+  _KERNEL(_KERNEL_ARGS);
   stop_timer();
 
   // Metrics
@@ -129,12 +177,16 @@ int main() {
   float utilization = 100 * performance / (2.0 * NR_LANES * DTYPE_FACTOR);
 
   printf("The execution took %d cycles.\n", runtime);
-  printf("The performance is %f FLOP/cycle (%f%% utilization).\n", performance,
-         utilization);
+  printf("The performance is %f %s/cycle (%f%% utilization) for %s.\n",
+         performance, _OP, utilization, _PAIR);
 
   // Verify the result
   printf("Verifying result...\n");
+#ifdef THRESHOLD
   int error = _VERIFY(c, g, M, P, THRESHOLD);
+#else
+  int error = _VERIFY(c, g, M, P);
+#endif
   if (error != 0) {
     unsigned int idx = error == -1 ? 0 : error;
     printf("Error code %d\n", error);
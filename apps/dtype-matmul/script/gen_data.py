@@ -47,21 +47,42 @@ if len(sys.argv) == 5:
 else:
   print("Error. Give me four argument: dtype, M, N, P.")
   print("dtype in [float64, float32, float16, int64, int32, int16, int8]")
+  print("or, for mixed precision, in [float16-float32, int8-int32]")
   print("C = AB with A=[MxP], B=[PxN], C=[MxN]")
   sys.exit()
 
 # Matrices and results
-A = np.random.rand(M, N).astype(dtype)
-B = np.random.rand(N, P).astype(dtype)
-C = np.zeros([M, P], dtype=dtype)
-# Golden result matrix
-G = np.matmul(A, B).astype(dtype)
+if dtype == 'float16-float32':
+  # Half-precision inputs, single-precision accumulation and result
+  A = np.random.rand(M, N).astype(np.float16)
+  B = np.random.rand(N, P).astype(np.float16)
+  C = np.zeros([M, P], dtype=np.float32)
+  # Golden result matrix
+  G = np.matmul(A.astype(np.float32), B.astype(np.float32))
+elif dtype == 'int8-int32':
+  # 8-bit inputs, 32-bit accumulation, and 8-bit result
+  A = np.random.randint(-128, 128, size=(M, N)).astype(np.int8)
+  B = np.random.randint(-128, 128, size=(N, P)).astype(np.int8)
+  C = np.zeros([M, P], dtype=np.int8)
+  acc = np.matmul(A.astype(np.int64), B.astype(np.int64))
+  # Requantize: shift the largest result to 8 bits, rounding to nearest (ties
+  # up), and saturate
+  S = max(int(np.abs(acc).max()).bit_length() - 7, 1)
+  G = np.clip((acc + (1 << (S - 1))) >> S, -128, 127).astype(np.int8)
+else:
+  A = np.random.rand(M, N).astype(dtype)
+  B = np.random.rand(N, P).astype(dtype)
+  C = np.zeros([M, P], dtype=dtype)
+  # Golden result matrix
+  G = np.matmul(A, B).astype(dtype)
 
 # Create the file
 print(".section .data,\"aw\",@progbits")
 emit("M", np.array(M, dtype=np.uint64))
 emit("N", np.array(N, dtype=np.uint64))
 emit("P", np.array(P, dtype=np.uint64))
+if dtype == 'int8-int32':
+  emit("S", np.array(S, dtype=np.uint64))
 emit("a", A, 'NR_LANES*4')
 emit("b", B, 'NR_LANES*4')
 emit("c", C, 'NR_LANES*4')
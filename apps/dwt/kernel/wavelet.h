@@ -17,6 +17,9 @@
 // Author: Matteo Perotti <mperotti@iis.ee.ethz.ch>
 //         Scalar version ispired by "Matteo Pesaresi 10/10/2017"
 
+#ifndef _WAVELET_H_
+#define _WAVELET_H_
+
 #include <math.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -62,3 +65,5 @@ static inline void dwt_step(const gsl_wavelet *w, float *samples, size_t n,
                             float *buf);
 static inline void dwt_step_vector(const gsl_wavelet *w, float *samples,
                                    size_t n, float *buf);
+
+#endif
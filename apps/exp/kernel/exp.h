@@ -16,6 +16,9 @@
 //
 // Author: Matteo Perotti
 
+#ifndef _EXP_H_
+#define _EXP_H_
+
 #include <stdint.h>
 #include <string.h>
 
@@ -160,3 +163,5 @@ inline vfloat32m1_t __exp_2xf32(vfloat32m1_t x, size_t gvl) {
   y = __riscv_vfmul_vv_f32m1(y, tmp4, gvl);
   return y;
 }
+
+#endif
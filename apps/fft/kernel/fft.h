@@ -11,6 +11,42 @@ void fft_r2dif_vec(float *samples_re, float *samples_im,
                    const float *twiddles_re, const float *twiddles_im,
                    const uint8_t **mask_addr_vec, const uint32_t *index_ptr,
                    size_t n_fft);
+
+// Mixed-radix (radix-4 and radix-2) vector FFT, for any power-of-two size.
+// The twiddle factors (n floats per array) and the bit-reversed indices (n
+// words) are computed by fft_mr_setup in buffers owned by the caller.
+typedef struct {
+  size_t n;
+  unsigned int log2n;
+  const float *tw_re;
+  const float *tw_im;
+  const uint32_t *rev;
+} fft_mr_plan_t;
+
+// Real-input FFT on n points, with an n/2-point complex FFT. The setup takes
+// n floats per twiddle array, and n/2 words of indices.
+typedef struct {
+  fft_mr_plan_t half;
+  const float *tw_re;
+  const float *tw_im;
+} fft_real_plan_t;
+
+void fft_mr_setup(fft_mr_plan_t *plan, size_t n, float *tw_re, float *tw_im,
+                  uint32_t *rev);
+void fft_real_setup(fft_real_plan_t *plan, size_t n, float *tw_re,
+                    float *tw_im, uint32_t *rev);
+// Transform re/im (overwritten) into out_re/out_im, in natural order
+void fft_mr_vec(float *re, float *im, float *out_re, float *out_im,
+                const fft_mr_plan_t *plan);
+// Transform batch independent signals, with point k of signal b at
+// [k * batch + b]. One signal per vector element.
+void fft_mr_batch_vec(float *re, float *im, float *out_re, float *out_im,
+                      size_t batch, const fft_mr_plan_t *plan);
+// Transform n real samples into the n/2 + 1 non-redundant bins. buf_re and
+// buf_im hold n/2 floats, out_re and out_im n/2 + 1.
+void fft_real_vec(const float *x, float *buf_re, float *buf_im, float *out_re,
+                  float *out_im, const fft_real_plan_t *plan);
+
 static inline v2s cplxmuls(v2s x, v2s y);
 static inline v2f cplxmuls_float(v2f x, v2f y);
 static inline v2s cplxmulsdiv2(v2s x, v2s y);
@@ -0,0 +1,368 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Mixed-radix vector FFT, for any power-of-two size chosen at runtime.
+//
+// The transform is a decimation-in-frequency radix-4 FFT, with one radix-2
+// stage at the end when log2(N) is odd. The outputs of each radix-4 butterfly
+// are stored in the order X0, X2, X1, X3 (radix-2^2), so that the result is in
+// plain bit-reversed order, as with the radix-2 kernel. The bit reversal is
+// done in the registers with vrgather when the whole transform fits in one
+// LMUL = 4 register group, and with indexed stores otherwise.
+//
+// A stage is vectorized along the butterflies of the same sub-transform while
+// they are at least as many as the sub-transforms, and across the
+// sub-transforms (strided accesses, one twiddle factor per butterfly row)
+// after that. The batched version processes one transform per vector element,
+// and the real-input version computes an N/2-point complex FFT.
+//
+// Real and imaginary parts live in separate arrays, and the twiddle factors
+// are computed once by the setup functions.
+
+#include <math.h>
+
+#include "fft.h"
+
+// Bit reversal in the registers up to this many points
+#define FFT_MR_GATHER_MAX (__riscv_vsetvlmax_e32m4())
+
+void fft_mr_setup(fft_mr_plan_t *plan, size_t n, float *tw_re, float *tw_im,
+                  uint32_t *rev) {
+  unsigned int log2n = 31 - __builtin_clz(n);
+
+  plan->n = n;
+  plan->log2n = log2n;
+  plan->tw_re = tw_re;
+  plan->tw_im = tw_im;
+  plan->rev = rev;
+
+  // W_m^j, W_m^2j, W_m^3j for each radix-4 stage with sub-transforms of size m
+  for (size_t m = n; m >= 4; m >>= 2) {
+    size_t q = m / 4;
+    for (size_t p = 1; p <= 3; ++p) {
+      for (size_t j = 0; j < q; ++j) {
+        double phi = 2 * M_PI * (double)(p * j) / m;
+        tw_re[j] = (float)cos(phi);
+        tw_im[j] = (float)-sin(phi);
+      }
+      tw_re += q;
+      tw_im += q;
+    }
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t r = 0;
+    for (unsigned int b = 0; b < log2n; ++b)
+      r |= ((i >> b) & 1) << (log2n - 1 - b);
+    rev[i] = r;
+  }
+}
+
+void fft_real_setup(fft_real_plan_t *plan, size_t n, float *tw_re,
+                    float *tw_im, uint32_t *rev) {
+  size_t h = n / 2;
+
+  fft_mr_setup(&plan->half, h, tw_re, tw_im, rev);
+
+  // W_n^k for the final split
+  tw_re += h;
+  tw_im += h;
+  plan->tw_re = tw_re;
+  plan->tw_im = tw_im;
+  for (size_t k = 0; k < h; ++k) {
+    double phi = 2 * M_PI * (double)k / n;
+    tw_re[k] = (float)cos(phi);
+    tw_im[k] = (float)-sin(phi);
+  }
+}
+
+// Unit-stride or strided accesses. The stride is in bytes
+static inline vfloat32m1_t fft_ld(const float *p, ptrdiff_t stride,
+                                  size_t vl) {
+  if (stride == sizeof(float))
+    return __riscv_vle32_v_f32m1(p, vl);
+  return __riscv_vlse32_v_f32m1(p, stride, vl);
+}
+
+static inline void fft_st(float *p, ptrdiff_t stride, vfloat32m1_t v,
+                          size_t vl) {
+  if (stride == sizeof(float))
+    __riscv_vse32_v_f32m1(p, v, vl);
+  else
+    __riscv_vsse32_v_f32m1(p, stride, v, vl);
+}
+
+// Multiply (re, im) by the twiddle (w_re, w_im) and store the result
+static inline void fft_cmul_st(float *p_re, float *p_im, ptrdiff_t stride,
+                               vfloat32m1_t re, vfloat32m1_t im,
+                               vfloat32m1_t w_re, vfloat32m1_t w_im,
+                               size_t vl) {
+  vfloat32m1_t y_re = __riscv_vfmul_vv_f32m1(re, w_re, vl);
+  vfloat32m1_t y_im = __riscv_vfmul_vv_f32m1(re, w_im, vl);
+  y_re = __riscv_vfnmsac_vv_f32m1(y_re, im, w_im, vl);
+  y_im = __riscv_vfmacc_vv_f32m1(y_im, im, w_re, vl);
+  fft_st(p_re, stride, y_re, vl);
+  fft_st(p_im, stride, y_im, vl);
+}
+
+// Radix-4 DIF butterfly on vl rows. The four legs are d elements apart, and
+// consecutive rows are stride bytes apart. The outputs are stored in
+// bit-reversed order, i.e., X0, X2, X1, X3.
+static inline __attribute__((always_inline)) void
+fft_r4_bfly(float *re, float *im, size_t d, ptrdiff_t stride,
+            vfloat32m1_t w1_re, vfloat32m1_t w1_im, vfloat32m1_t w2_re,
+            vfloat32m1_t w2_im, vfloat32m1_t w3_re, vfloat32m1_t w3_im,
+            size_t vl) {
+  vfloat32m1_t x0_re = fft_ld(re, stride, vl);
+  vfloat32m1_t x2_re = fft_ld(re + 2 * d, stride, vl);
+  vfloat32m1_t x0_im = fft_ld(im, stride, vl);
+  vfloat32m1_t x2_im = fft_ld(im + 2 * d, stride, vl);
+  vfloat32m1_t x1_re = fft_ld(re + d, stride, vl);
+  vfloat32m1_t x3_re = fft_ld(re + 3 * d, stride, vl);
+  vfloat32m1_t x1_im = fft_ld(im + d, stride, vl);
+  vfloat32m1_t x3_im = fft_ld(im + 3 * d, stride, vl);
+
+  vfloat32m1_t a_re = __riscv_vfadd_vv_f32m1(x0_re, x2_re, vl);
+  vfloat32m1_t a_im = __riscv_vfadd_vv_f32m1(x0_im, x2_im, vl);
+  vfloat32m1_t b_re = __riscv_vfsub_vv_f32m1(x0_re, x2_re, vl);
+  vfloat32m1_t b_im = __riscv_vfsub_vv_f32m1(x0_im, x2_im, vl);
+  vfloat32m1_t c_re = __riscv_vfadd_vv_f32m1(x1_re, x3_re, vl);
+  vfloat32m1_t c_im = __riscv_vfadd_vv_f32m1(x1_im, x3_im, vl);
+  vfloat32m1_t d_re = __riscv_vfsub_vv_f32m1(x1_re, x3_re, vl);
+  vfloat32m1_t d_im = __riscv_vfsub_vv_f32m1(x1_im, x3_im, vl);
+
+  // X0 = a + c
+  fft_st(re, stride, __riscv_vfadd_vv_f32m1(a_re, c_re, vl), vl);
+  fft_st(im, stride, __riscv_vfadd_vv_f32m1(a_im, c_im, vl), vl);
+  // X2 = (a - c) * W^2j
+  fft_cmul_st(re + d, im + d, stride, __riscv_vfsub_vv_f32m1(a_re, c_re, vl),
+              __riscv_vfsub_vv_f32m1(a_im, c_im, vl), w2_re, w2_im, vl);
+  // X1 = (b - jd) * W^j
+  fft_cmul_st(re + 2 * d, im + 2 * d, stride,
+              __riscv_vfadd_vv_f32m1(b_re, d_im, vl),
+              __riscv_vfsub_vv_f32m1(b_im, d_re, vl), w1_re, w1_im, vl);
+  // X3 = (b + jd) * W^3j
+  fft_cmul_st(re + 3 * d, im + 3 * d, stride,
+              __riscv_vfsub_vv_f32m1(b_re, d_im, vl),
+              __riscv_vfadd_vv_f32m1(b_im, d_re, vl), w3_re, w3_im, vl);
+}
+
+// Radix-2 butterfly without twiddle factors, on vl rows
+static inline void fft_r2_bfly(float *re, float *im, size_t d, ptrdiff_t stride,
+                               size_t vl) {
+  vfloat32m1_t x0_re = fft_ld(re, stride, vl);
+  vfloat32m1_t x1_re = fft_ld(re + d, stride, vl);
+  vfloat32m1_t x0_im = fft_ld(im, stride, vl);
+  vfloat32m1_t x1_im = fft_ld(im + d, stride, vl);
+  fft_st(re, stride, __riscv_vfadd_vv_f32m1(x0_re, x1_re, vl), vl);
+  fft_st(re + d, stride, __riscv_vfsub_vv_f32m1(x0_re, x1_re, vl), vl);
+  fft_st(im, stride, __riscv_vfadd_vv_f32m1(x0_im, x1_im, vl), vl);
+  fft_st(im + d, stride, __riscv_vfsub_vv_f32m1(x0_im, x1_im, vl), vl);
+}
+
+#define FFT_TW_LD(p, q, j, vl)                                                 \
+  vfloat32m1_t w1_re = __riscv_vle32_v_f32m1(p##_re + (j), vl);                \
+  vfloat32m1_t w1_im = __riscv_vle32_v_f32m1(p##_im + (j), vl);                \
+  vfloat32m1_t w2_re = __riscv_vle32_v_f32m1(p##_re + (q) + (j), vl);          \
+  vfloat32m1_t w2_im = __riscv_vle32_v_f32m1(p##_im + (q) + (j), vl);          \
+  vfloat32m1_t w3_re = __riscv_vle32_v_f32m1(p##_re + 2 * (q) + (j), vl);      \
+  vfloat32m1_t w3_im = __riscv_vle32_v_f32m1(p##_im + 2 * (q) + (j), vl);
+
+#define FFT_TW_BCAST(p, q, j, vl)                                              \
+  vfloat32m1_t w1_re = __riscv_vfmv_v_f_f32m1(p##_re[(j)], vl);                \
+  vfloat32m1_t w1_im = __riscv_vfmv_v_f_f32m1(p##_im[(j)], vl);                \
+  vfloat32m1_t w2_re = __riscv_vfmv_v_f_f32m1(p##_re[(q) + (j)], vl);          \
+  vfloat32m1_t w2_im = __riscv_vfmv_v_f_f32m1(p##_im[(q) + (j)], vl);          \
+  vfloat32m1_t w3_re = __riscv_vfmv_v_f_f32m1(p##_re[2 * (q) + (j)], vl);      \
+  vfloat32m1_t w3_im = __riscv_vfmv_v_f_f32m1(p##_im[2 * (q) + (j)], vl);
+
+// Store the n points of re/im in bit-reversed order
+static void fft_bitrev(const float *re, const float *im, float *out_re,
+                       float *out_im, const uint32_t *rev, size_t n) {
+  size_t vl;
+
+  if (n <= FFT_MR_GATHER_MAX) {
+    vl = __riscv_vsetvl_e32m4(n);
+    vuint32m4_t idx = __riscv_vle32_v_u32m4(rev, vl);
+    vfloat32m4_t v = __riscv_vle32_v_f32m4(re, vl);
+    __riscv_vse32_v_f32m4(out_re, __riscv_vrgather_vv_f32m4(v, idx, vl), vl);
+    v = __riscv_vle32_v_f32m4(im, vl);
+    __riscv_vse32_v_f32m4(out_im, __riscv_vrgather_vv_f32m4(v, idx, vl), vl);
+    return;
+  }
+
+  for (size_t i = 0; i < n; i += vl) {
+    vl = __riscv_vsetvl_e32m4(n - i);
+    vuint32m4_t off = __riscv_vle32_v_u32m4(rev + i, vl);
+    off = __riscv_vsll_vx_u32m4(off, 2, vl);
+    __riscv_vsuxei32_v_f32m4(out_re, off, __riscv_vle32_v_f32m4(re + i, vl),
+                             vl);
+    __riscv_vsuxei32_v_f32m4(out_im, off, __riscv_vle32_v_f32m4(im + i, vl),
+                             vl);
+  }
+}
+
+void fft_mr_vec(float *re, float *im, float *out_re, float *out_im,
+                const fft_mr_plan_t *plan) {
+  const size_t n = plan->n;
+  const float *tw_re = plan->tw_re;
+  const float *tw_im = plan->tw_im;
+  size_t vl;
+
+  for (size_t m = n; m >= 4; m >>= 2) {
+    const size_t q = m / 4;
+    const size_t groups = n / m;
+
+    if (q >= groups) {
+      // Along the butterflies of each sub-transform
+      for (size_t j = 0; j < q; j += vl) {
+        vl = __riscv_vsetvl_e32m1(q - j);
+        FFT_TW_LD(tw, q, j, vl)
+        for (size_t g = 0; g < n; g += m)
+          fft_r4_bfly(re + g + j, im + g + j, q, sizeof(float), w1_re, w1_im,
+                      w2_re, w2_im, w3_re, w3_im, vl);
+      }
+    } else {
+      // Across the sub-transforms
+      for (size_t j = 0; j < q; ++j) {
+        vl = __riscv_vsetvl_e32m1(groups);
+        FFT_TW_BCAST(tw, q, j, vl)
+        for (size_t g = 0; g < groups; g += vl) {
+          vl = __riscv_vsetvl_e32m1(groups - g);
+          fft_r4_bfly(re + g * m + j, im + g * m + j, q, m * sizeof(float),
+                      w1_re, w1_im, w2_re, w2_im, w3_re, w3_im, vl);
+        }
+      }
+    }
+
+    tw_re += 3 * q;
+    tw_im += 3 * q;
+  }
+
+  // Last radix-2 stage, for odd log2(n)
+  if (plan->log2n & 1) {
+    for (size_t g = 0; g < n / 2; g += vl) {
+      vl = __riscv_vsetvl_e32m1(n / 2 - g);
+      fft_r2_bfly(re + 2 * g, im + 2 * g, 1, 2 * sizeof(float), vl);
+    }
+  }
+
+  fft_bitrev(re, im, out_re, out_im, plan->rev, n);
+}
+
+void fft_mr_batch_vec(float *re, float *im, float *out_re, float *out_im,
+                      size_t batch, const fft_mr_plan_t *plan) {
+  const size_t n = plan->n;
+  const float *tw_re = plan->tw_re;
+  const float *tw_im = plan->tw_im;
+  size_t vl;
+
+  // Point k of every transform is on row k, i.e., at [k * batch]
+  for (size_t m = n; m >= 4; m >>= 2) {
+    const size_t q = m / 4;
+
+    for (size_t j = 0; j < q; ++j) {
+      vl = __riscv_vsetvl_e32m1(batch);
+      FFT_TW_BCAST(tw, q, j, vl)
+      for (size_t g = j; g < n; g += m) {
+        for (size_t b = 0; b < batch; b += vl) {
+          vl = __riscv_vsetvl_e32m1(batch - b);
+          fft_r4_bfly(re + g * batch + b, im + g * batch + b, q * batch,
+                      sizeof(float), w1_re, w1_im, w2_re, w2_im, w3_re, w3_im,
+                      vl);
+        }
+      }
+    }
+
+    tw_re += 3 * q;
+    tw_im += 3 * q;
+  }
+
+  if (plan->log2n & 1) {
+    for (size_t g = 0; g < n; g += 2) {
+      for (size_t b = 0; b < batch; b += vl) {
+        vl = __riscv_vsetvl_e32m1(batch - b);
+        fft_r2_bfly(re + g * batch + b, im + g * batch + b, batch,
+                    sizeof(float), vl);
+      }
+    }
+  }
+
+  // The bit reversal only moves whole rows
+  for (size_t k = 0; k < n; ++k) {
+    const size_t r = plan->rev[k] * batch;
+    for (size_t b = 0; b < batch; b += vl) {
+      vl = __riscv_vsetvl_e32m4(batch - b);
+      __riscv_vse32_v_f32m4(out_re + k * batch + b,
+                            __riscv_vle32_v_f32m4(re + r + b, vl), vl);
+      __riscv_vse32_v_f32m4(out_im + k * batch + b,
+                            __riscv_vle32_v_f32m4(im + r + b, vl), vl);
+    }
+  }
+}
+
+// The n real samples are transformed as n/2 complex samples z[k] = x[2k] +
+// j x[2k+1]. With Z = FFT(z), E = (Z[k] + Z*[n/2-k]) / 2 and
+// O = (Z[k] - Z*[n/2-k]) / 2, the result is X[k] = E - j W_n^k O.
+void fft_real_vec(const float *x, float *buf_re, float *buf_im, float *out_re,
+                  float *out_im, const fft_real_plan_t *plan) {
+  const size_t h = plan->half.n;
+  size_t vl;
+
+  // Split the even and odd samples
+  for (size_t i = 0; i < h; i += vl) {
+    vl = __riscv_vsetvl_e32m4(h - i);
+    __riscv_vse32_v_f32m4(out_re + i,
+                          __riscv_vlse32_v_f32m4(x + 2 * i, 8, vl), vl);
+    __riscv_vse32_v_f32m4(out_im + i,
+                          __riscv_vlse32_v_f32m4(x + 2 * i + 1, 8, vl), vl);
+  }
+
+  fft_mr_vec(out_re, out_im, buf_re, buf_im, &plan->half);
+
+  // Z[n/2 - k] is read backwards, with a negative stride
+  for (size_t k = 1; k < h; k += vl) {
+    vl = __riscv_vsetvl_e32m1(h - k);
+    vfloat32m1_t a_re = __riscv_vle32_v_f32m1(buf_re + k, vl);
+    vfloat32m1_t a_im = __riscv_vle32_v_f32m1(buf_im + k, vl);
+    vfloat32m1_t b_re = __riscv_vlse32_v_f32m1(buf_re + h - k, -4, vl);
+    vfloat32m1_t b_im = __riscv_vlse32_v_f32m1(buf_im + h - k, -4, vl);
+    vfloat32m1_t w_re = __riscv_vle32_v_f32m1(plan->tw_re + k, vl);
+    vfloat32m1_t w_im = __riscv_vle32_v_f32m1(plan->tw_im + k, vl);
+
+    // 2E and 2O
+    vfloat32m1_t e_re = __riscv_vfadd_vv_f32m1(a_re, b_re, vl);
+    vfloat32m1_t e_im = __riscv_vfsub_vv_f32m1(a_im, b_im, vl);
+    vfloat32m1_t o_re = __riscv_vfsub_vv_f32m1(a_re, b_re, vl);
+    vfloat32m1_t o_im = __riscv_vfadd_vv_f32m1(a_im, b_im, vl);
+
+    // -j W = W_im - j W_re
+    e_re = __riscv_vfmacc_vv_f32m1(e_re, w_im, o_re, vl);
+    e_re = __riscv_vfmacc_vv_f32m1(e_re, w_re, o_im, vl);
+    e_im = __riscv_vfmacc_vv_f32m1(e_im, w_im, o_im, vl);
+    e_im = __riscv_vfnmsac_vv_f32m1(e_im, w_re, o_re, vl);
+
+    __riscv_vse32_v_f32m1(out_re + k, __riscv_vfmul_vf_f32m1(e_re, 0.5f, vl),
+                          vl);
+    __riscv_vse32_v_f32m1(out_im + k, __riscv_vfmul_vf_f32m1(e_im, 0.5f, vl),
+                          vl);
+  }
+
+  out_re[0] = buf_re[0] + buf_im[0];
+  out_im[0] = 0;
+  out_re[h] = buf_re[0] - buf_im[0];
+  out_im[h] = 0;
+}
@@ -16,6 +16,7 @@
 
 // Author: Matteo Perotti <mperotti@iis.ee.ethz.ch>
 
+#include <math.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -33,6 +34,21 @@
 
 #define MAX_NFFT 256
 
+// Largest mixed-radix FFT, and batched FFTs (FFT_BATCH signals of up to
+// FFT_BATCH_MAX points)
+#ifndef FFT_MR_MAX
+#define FFT_MR_MAX 1024
+#endif
+#ifndef FFT_BATCH
+#define FFT_BATCH 64
+#endif
+#ifndef FFT_BATCH_MAX
+#define FFT_BATCH_MAX 64
+#endif
+#define FFT_BUF_LEN                                                            \
+  (FFT_MR_MAX > FFT_BATCH * FFT_BATCH_MAX ? FFT_MR_MAX                         \
+                                          : FFT_BATCH * FFT_BATCH_MAX)
+
 #define DEBUG
 #undef DEBUG
 
@@ -50,6 +66,8 @@ v2f samples_copy[MAX_NFFT]
     __attribute__((aligned(32 * NR_LANES), section(".l2")));
 v2f samples_vec[MAX_NFFT]
     __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern float samples_reim_s[]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
 extern v2f gold_out[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
 signed short SwapTable[MAX_NFFT]
     __attribute__((aligned(32 * NR_LANES), section(".l2")));
@@ -57,6 +75,163 @@ signed short SwapTable[MAX_NFFT]
 // Threshold for FP numbers comparison during the final check
 #define THRESHOLD 1
 
+// Mixed-radix FFT buffers
+float in_re[FFT_BUF_LEN] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float in_im[FFT_BUF_LEN] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float work_re[FFT_BUF_LEN]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float work_im[FFT_BUF_LEN]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float out_re[FFT_BUF_LEN]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float out_im[FFT_BUF_LEN]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float tw_re[FFT_MR_MAX] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+float tw_im[FFT_MR_MAX] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+uint32_t rev[FFT_MR_MAX]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+double ref_re[FFT_MR_MAX];
+double ref_im[FFT_MR_MAX];
+
+// Maximum error allowed, relative to the largest output
+#define MR_THRESHOLD 1e-5
+
+// Scalar reference in double precision. The n input points are stride
+// elements apart.
+static void fft_ref(const float *re, const float *im, size_t stride, size_t n) {
+  unsigned int log2n = 31 - __builtin_clz(n);
+  for (size_t i = 0; i < n; ++i) {
+    size_t r = 0;
+    for (unsigned int b = 0; b < log2n; ++b)
+      r |= ((i >> b) & 1) << (log2n - 1 - b);
+    ref_re[r] = re[i * stride];
+    ref_im[r] = im ? im[i * stride] : 0;
+  }
+  for (size_t m = 2; m <= n; m <<= 1) {
+    for (size_t j = 0; j < m / 2; ++j) {
+      double w_re = cos(2 * M_PI * j / m);
+      double w_im = -sin(2 * M_PI * j / m);
+      for (size_t k = j; k < n; k += m) {
+        double t_re = ref_re[k + m / 2] * w_re - ref_im[k + m / 2] * w_im;
+        double t_im = ref_re[k + m / 2] * w_im + ref_im[k + m / 2] * w_re;
+        ref_re[k + m / 2] = ref_re[k] - t_re;
+        ref_im[k + m / 2] = ref_im[k] - t_im;
+        ref_re[k] += t_re;
+        ref_im[k] += t_im;
+      }
+    }
+  }
+}
+
+// Compare len outputs (stride elements apart) with the reference
+static int check_ref(const float *re, const float *im, size_t stride,
+                     size_t len) {
+  double max = 0, err = 0;
+  for (size_t k = 0; k < len; ++k) {
+    double m = fabs(ref_re[k]) + fabs(ref_im[k]);
+    double e = fabs(re[k * stride] - ref_re[k]) +
+               fabs(im[k * stride] - ref_im[k]);
+    if (m > max)
+      max = m;
+    if (e > err)
+      err = e;
+  }
+  return err > MR_THRESHOLD * max;
+}
+
+// Pseudo-random samples in [-1, 1)
+static void fill_rand(float *v, size_t len) {
+  static uint32_t seed = 12345;
+  for (size_t i = 0; i < len; ++i) {
+    seed = seed * 1664525 + 1013904223;
+    v[i] = (float)(int32_t)seed / 2147483648.0f;
+  }
+}
+
+// Mixed-radix, batched and real-input FFTs on every size, checked against the
+// scalar reference. Returns the cycles of the complex FFT on nfft points.
+static int64_t fft_mr_bench(int *error) {
+  fft_mr_plan_t plan;
+  fft_real_plan_t rplan;
+  int64_t runtime, nfft_runtime = 0;
+
+  // Same input as the radix-2 kernel
+  fft_mr_setup(&plan, NFFT, tw_re, tw_im, rev);
+  memcpy(in_re, samples_reim_s, NFFT * sizeof(float));
+  memcpy(in_im, samples_reim_s + NFFT, NFFT * sizeof(float));
+  fft_ref(in_re, in_im, 1, NFFT);
+  start_timer();
+  fft_mr_vec(in_re, in_im, out_re, out_im, &plan);
+  stop_timer();
+  nfft_runtime = get_timer();
+  if (check_ref(out_re, out_im, 1, NFFT)) {
+    printf("Mixed-radix FFT error on %d points\n", NFFT);
+    *error = 1;
+  }
+
+  printf("\n");
+  printf("Cycles per transform\n");
+  printf("%8s %12s %12s %12s\n", "points", "complex", "batched", "real");
+
+  for (size_t n = 4; n <= FFT_MR_MAX; n <<= 1) {
+    int64_t cycles[3] = {0, 0, 0};
+
+    // Complex FFT
+    fft_mr_setup(&plan, n, tw_re, tw_im, rev);
+    fill_rand(in_re, n);
+    fill_rand(in_im, n);
+    fft_ref(in_re, in_im, 1, n);
+    start_timer();
+    fft_mr_vec(in_re, in_im, out_re, out_im, &plan);
+    stop_timer();
+    cycles[0] = get_timer();
+    if (check_ref(out_re, out_im, 1, n)) {
+      printf("Mixed-radix FFT error on %d points\n", n);
+      *error = 1;
+    }
+
+    // FFT_BATCH transforms, one per vector element
+    if (n <= FFT_BATCH_MAX) {
+      fill_rand(in_re, n * FFT_BATCH);
+      fill_rand(in_im, n * FFT_BATCH);
+      memcpy(work_re, in_re, n * FFT_BATCH * sizeof(float));
+      memcpy(work_im, in_im, n * FFT_BATCH * sizeof(float));
+      start_timer();
+      fft_mr_batch_vec(in_re, in_im, out_re, out_im, FFT_BATCH, &plan);
+      stop_timer();
+      cycles[1] = get_timer() / FFT_BATCH;
+      for (size_t b = 0; b < FFT_BATCH; ++b) {
+        fft_ref(work_re + b, work_im + b, FFT_BATCH, n);
+        if (check_ref(out_re + b, out_im + b, FFT_BATCH, n)) {
+          printf("Batched FFT error on %d points, signal %d\n", n, b);
+          *error = 1;
+          break;
+        }
+      }
+    }
+
+    // Real-input FFT
+    fft_real_setup(&rplan, n, tw_re, tw_im, rev);
+    fill_rand(in_re, n);
+    fft_ref(in_re, NULL, 1, n);
+    start_timer();
+    fft_real_vec(in_re, work_re, work_im, out_re, out_im, &rplan);
+    stop_timer();
+    cycles[2] = get_timer();
+    if (check_ref(out_re, out_im, 1, n / 2 + 1)) {
+      printf("Real-input FFT error on %d points\n", n);
+      *error = 1;
+    }
+
+    if (n <= FFT_BATCH_MAX)
+      printf("%8d %12d %12d %12d\n", n, cycles[0], cycles[1], cycles[2]);
+    else
+      printf("%8d %12d %12s %12d\n", n, cycles[0], "-", cycles[2]);
+  }
+
+  return nfft_runtime;
+}
+
 int main() {
   printf("\n");
   printf("=========\n");
@@ -229,6 +404,16 @@ int main() {
     }
   */
 
+  //////////////////////
+  // Mixed-radix FFTs //
+  //////////////////////
+
+  printf("\n");
+  int64_t mr_runtime = fft_mr_bench(&error);
+  printf("\n");
+  printf("Cycles per transform on %d points: radix-2 %d, mixed-radix %d\n",
+         NFFT, runtime, mr_runtime);
+
   // Verify results
   for (unsigned int i = 0; i < NFFT; ++i) {
     if (!similarity_check(samples_reim[i], samples_copy[i][0], THRESHOLD)) {
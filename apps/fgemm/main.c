@@ -0,0 +1,117 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string.h>
+
+#include "ara_rvv.h"
+#include "runtime.h"
+#include "util.h"
+
+#ifdef SPIKE
+#include <stdio.h>
+#elif defined ARA_LINUX
+#include <stdio.h>
+#else
+#include "printf.h"
+#endif
+
+// Define Matrix dimensions:
+// C = alpha * AB + beta * C with A=[MxN], B=[NxP], C=[MxP]
+extern uint64_t M;
+extern uint64_t N;
+extern uint64_t P;
+extern double alpha;
+extern double beta;
+
+extern double a[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double b[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+extern double c[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+// Gold results
+extern double g[] __attribute__((aligned(32 * NR_LANES), section(".l2")));
+
+#define THRESHOLD 0.001
+
+// Verify the matrix
+int verify_matrix(double *result, double *gold, size_t R, size_t C,
+                  double threshold) {
+  for (uint64_t i = 0; i < R; ++i) {
+    for (uint64_t j = 0; j < C; ++j) {
+      uint64_t idx = i * C + j;
+      if (!similarity_check(result[idx], gold[idx], threshold)) {
+        return (i + j) == 0 ? -1 : idx;
+      }
+    }
+  }
+  return 0;
+}
+
+int main() {
+  printf("\n");
+  printf("===========\n");
+  printf("=  FGEMM  =\n");
+  printf("===========\n");
+  printf("\n");
+  printf("\n");
+
+  printf("\n");
+  printf("------------------------------------------------------------\n");
+  printf("Calculating a (%d x %d) x (%d x %d) matrix multiplication...\n", M,
+         N, N, P);
+  printf("------------------------------------------------------------\n");
+  printf("\n");
+
+  // Matrices are initialized --> Start calculating
+  printf("Calculating fgemm...\n");
+  start_timer();
+  fgemm(c, a, b, M, N, P, alpha, beta);
+  stop_timer();
+
+  // Metrics
+  int64_t runtime = get_timer();
+  float performance = 2.0 * M * N * P / runtime;
+  float utilization = 100 * performance / (2.0 * NR_LANES);
+
+  printf("The execution took %d cycles.\n", runtime);
+  printf("The performance is %f FLOP/cycle (%f%% utilization).\n", performance,
+         utilization);
+
+  printf("Verifying result...\n");
+  int error = verify_matrix(c, g, M, P, THRESHOLD);
+  if (error != 0) {
+    printf("Error code %d\n", error);
+    // verify_matrix returns -1 for a mismatch on the first element
+    int idx = error < 0 ? 0 : error;
+    printf("c[%d]=%f\n", idx, c[idx]);
+    return error;
+  } else {
+    printf("Passed.\n");
+  }
+
+  // Compare with the square kernel on the same problem
+  if (M == N && N == P) {
+    printf("Calculating fmatmul...\n");
+    start_timer();
+    fmatmul(c, a, b, M, N, P);
+    stop_timer();
+
+    runtime = get_timer();
+    performance = 2.0 * M * N * P / runtime;
+    printf("The execution took %d cycles.\n", runtime);
+    printf("The performance is %f FLOP/cycle.\n", performance);
+  }
+
+  return 0;
+}
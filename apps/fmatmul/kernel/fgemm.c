@@ -0,0 +1,177 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// General matrix multiplication, C = alpha * A * B + beta * C, with
+// A=[MxN], B=[NxP], C=[MxP] and any M, N, P.
+//
+// C is computed in strips of one vector register group (LMUL = 2), up to
+// FGEMM_MR rows at a time. N is tiled in panels of FGEMM_KC elements, and P in
+// panels of FGEMM_NC_STRIPS strips, sized on VLEN. Each KC x NC panel of B is
+// packed once, strip by strip, in a contiguous buffer. Each MR x KC block of A
+// is packed transposed, so that the scalar core reads its operands from
+// consecutive addresses. The row tails use the 4-, 2- and 1-row versions of
+// the micro-kernel, and the column tails a shorter vector length.
+
+#include <riscv_vector.h>
+
+#include "fmatmul.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// Tiling of N and P. Can be overridden at compile time
+#ifndef FGEMM_KC
+#define FGEMM_KC 64
+#endif
+#ifndef FGEMM_NC_STRIPS
+#define FGEMM_NC_STRIPS 2
+#endif
+
+// Rows of C computed together
+#define FGEMM_MR 8
+// Elements of a strip, i.e., of a vector register group with LMUL = 2
+#define FGEMM_STRIP (VLEN / 32)
+
+// Packed panels
+static double a_pack[FGEMM_MR * FGEMM_KC]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+static double b_pack[FGEMM_KC * FGEMM_NC_STRIPS * FGEMM_STRIP]
+    __attribute__((aligned(32 * NR_LANES), section(".l2")));
+
+// Copy a KC x NC panel of B (row stride P) strip after strip
+static void fgemm_pack_b(double *dst, const double *b, unsigned long int kc,
+                         unsigned long int nc, unsigned long int P) {
+  size_t vl;
+  for (unsigned long int p = 0; p < nc; p += vl) {
+    vl = __riscv_vsetvl_e64m2(nc - p);
+    const double *b_ = b + p;
+    for (unsigned long int k = 0; k < kc; ++k) {
+      __riscv_vse64_v_f64m2(dst, __riscv_vle64_v_f64m2(b_, vl), vl);
+      b_ += P;
+      dst += vl;
+    }
+  }
+}
+
+// Copy an R x KC block of A (row stride N), transposed
+static void fgemm_pack_a(double *dst, const double *a, unsigned long int r,
+                         unsigned long int kc, unsigned long int N) {
+  for (unsigned long int i = 0; i < r; ++i) {
+    size_t vl;
+    for (unsigned long int k = 0; k < kc; k += vl) {
+      vl = __riscv_vsetvl_e64m4(kc - k);
+      __riscv_vsse64_v_f64m4(dst + k * r + i, r * sizeof(double),
+                             __riscv_vle64_v_f64m4(a + i * N + k, vl), vl);
+    }
+  }
+}
+
+#define FGEMM_STORE_ROW(i)                                                     \
+  if (R > i) {                                                                 \
+    double *c_ = c + i * P;                                                    \
+    c##i = __riscv_vfmul_vf_f64m2(c##i, alpha, vl);                            \
+    if (beta != 0.0)                                                           \
+      c##i = __riscv_vfmacc_vf_f64m2(c##i, beta,                               \
+                                     __riscv_vle64_v_f64m2(c_, vl), vl);       \
+    __riscv_vse64_v_f64m2(c_, c##i, vl);                                       \
+  }
+
+// Compute an R x vl block of C from the packed panels. R is 1, 2, 4 or 8, and
+// is known at compile time once the function is inlined.
+static inline __attribute__((always_inline)) void
+fgemm_vec_rxv(double *c, const double *a, const double *b,
+              unsigned long int kc, size_t vl, unsigned long int P,
+              double alpha, double beta, const unsigned long int R) {
+  vfloat64m2_t c0 = __riscv_vfmv_v_f_f64m2(0, vl);
+  vfloat64m2_t c1 = c0, c2 = c0, c3 = c0, c4 = c0, c5 = c0, c6 = c0, c7 = c0;
+
+  for (unsigned long int k = 0; k < kc; ++k) {
+    vfloat64m2_t b_row = __riscv_vle64_v_f64m2(b, vl);
+    b += vl;
+
+    c0 = __riscv_vfmacc_vf_f64m2(c0, a[0], b_row, vl);
+    if (R > 1)
+      c1 = __riscv_vfmacc_vf_f64m2(c1, a[1], b_row, vl);
+    if (R > 2) {
+      c2 = __riscv_vfmacc_vf_f64m2(c2, a[2], b_row, vl);
+      c3 = __riscv_vfmacc_vf_f64m2(c3, a[3], b_row, vl);
+    }
+    if (R > 4) {
+      c4 = __riscv_vfmacc_vf_f64m2(c4, a[4], b_row, vl);
+      c5 = __riscv_vfmacc_vf_f64m2(c5, a[5], b_row, vl);
+      c6 = __riscv_vfmacc_vf_f64m2(c6, a[6], b_row, vl);
+      c7 = __riscv_vfmacc_vf_f64m2(c7, a[7], b_row, vl);
+    }
+    a += R;
+  }
+
+  FGEMM_STORE_ROW(0)
+  FGEMM_STORE_ROW(1)
+  FGEMM_STORE_ROW(2)
+  FGEMM_STORE_ROW(3)
+  FGEMM_STORE_ROW(4)
+  FGEMM_STORE_ROW(5)
+  FGEMM_STORE_ROW(6)
+  FGEMM_STORE_ROW(7)
+}
+
+void fgemm(double *c, const double *a, const double *b,
+           const unsigned long int M, const unsigned long int N,
+           const unsigned long int P, const double alpha, const double beta) {
+  const unsigned long int nc_max = FGEMM_NC_STRIPS * FGEMM_STRIP;
+
+  // With N == 0, a single empty panel scales C by beta
+  unsigned long int k0 = 0;
+  do {
+    const unsigned long int kc = MIN(N - k0, FGEMM_KC);
+    // The panels after the first one accumulate on C
+    const double beta_ = k0 ? 1.0 : beta;
+
+    for (unsigned long int p0 = 0; p0 < P; p0 += nc_max) {
+      const unsigned long int nc = MIN(P - p0, nc_max);
+      fgemm_pack_b(b_pack, b + k0 * P + p0, kc, nc, P);
+
+      unsigned long int r;
+      for (unsigned long int m0 = 0; m0 < M; m0 += r) {
+        const unsigned long int m_left = M - m0;
+        r = m_left >= 8 ? 8 : m_left >= 4 ? 4 : m_left >= 2 ? 2 : 1;
+        fgemm_pack_a(a_pack, a + m0 * N + k0, r, kc, N);
+
+        const double *b_ = b_pack;
+        size_t vl;
+        for (unsigned long int p = 0; p < nc; p += vl) {
+          vl = __riscv_vsetvl_e64m2(nc - p);
+          double *c_ = c + m0 * P + p0 + p;
+          switch (r) {
+          case 8:
+            fgemm_vec_rxv(c_, a_pack, b_, kc, vl, P, alpha, beta_, 8);
+            break;
+          case 4:
+            fgemm_vec_rxv(c_, a_pack, b_, kc, vl, P, alpha, beta_, 4);
+            break;
+          case 2:
+            fgemm_vec_rxv(c_, a_pack, b_, kc, vl, P, alpha, beta_, 2);
+            break;
+          default:
+            fgemm_vec_rxv(c_, a_pack, b_, kc, vl, P, alpha, beta_, 1);
+          }
+          b_ += kc * vl;
+        }
+      }
+    }
+
+    k0 += kc;
+  } while (k0 < N);
+}
@@ -44,6 +44,11 @@ void fmatmul_vec_16x16_slice_init();
 void fmatmul_vec_16x16(double *c, const double *a, const double *b,
                        unsigned long int n, unsigned long int p);
 
+// General matrix multiplication: C = alpha * A * B + beta * C
+void fgemm(double *c, const double *a, const double *b, unsigned long int m,
+           unsigned long int n, unsigned long int p, double alpha,
+           double beta);
+
 #define DELTA 0.000001
 
 extern int64_t event_trigger;
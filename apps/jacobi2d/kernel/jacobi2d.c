@@ -104,6 +104,13 @@ void j2d_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B,
   }
 }
 
+void j2d_tb_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B,
+              uint64_t tsteps, unsigned int T) {
+  const stencil_t jacobi = {5, 0.2, 0.2, 0};
+  // Two steps per iteration, as with DOUBLE_BUFFERING. The result is in A
+  stencil2d_run_v(r, c, A, B, &jacobi, 2 * tsteps, T);
+}
+
 // Not compatible with Linux compiler
 #ifndef ARA_LINUX
 void j2d_kernel_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B) {
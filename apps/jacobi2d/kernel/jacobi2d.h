@@ -84,6 +84,7 @@ WITH ACCESS OR USE OF THE SOFTWARE.
 #include <riscv_vector.h>
 
 #include "runtime.h"
+#include "stencil.h"
 #include "util.h"
 
 // The vector algorithm seems not to be parametrized on the data type
@@ -101,6 +102,10 @@ void j2d_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B, uint64_t tsteps);
 void j2d_kernel_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B);
 void j2d_kernel_opt_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B);
 void j2d_kernel_asm_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B);
+// Same time steps as j2d_v, T steps per pass over the grid. A and B must have
+// the same boundary.
+void j2d_tb_v(uint64_t r, uint64_t c, DATA_TYPE *A, DATA_TYPE *B,
+              uint64_t tsteps, unsigned int T);
 
 int check_result(uint64_t r, uint64_t c, DATA_TYPE *A_s, DATA_TYPE *B_s,
                  DATA_TYPE *A_v, DATA_TYPE *B_v);
@@ -0,0 +1,359 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Temporally blocked 2D stencils, and 3D stencils.
+//
+// The 2D grid is processed in vertical strips of one vector register group
+// (LMUL = 2), streaming the rows from top to bottom. Each of the T time steps
+// of a pass keeps the last two rows it produced in the registers, so that a
+// new input row lets every step produce one more row, and only the rows of the
+// last step are stored. The left and right neighbors come from vfslide1up and
+// vfslide1down. Only the first step gets them from memory: the outputs of step
+// t are valid T - 1 columns away from the strip edges, so the strips overlap
+// by 2 (T - 1) columns.
+//
+// The 3D grid is processed one time step per pass. Each strip of a row is
+// streamed along z, keeping the rows of the planes z - 1, z, z + 1 in the
+// registers.
+
+#include <riscv_vector.h>
+
+#include "stencil.h"
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+////////
+// 2D //
+////////
+
+static inline double stencil2d_point(const double *p, uint64_t c,
+                                     const stencil_t *s) {
+  double v = p[-c] + p[c];
+  double acc = (v + p[-1]) + p[1];
+  acc = acc * s->c1 + s->c0 * p[0];
+  if (s->points == 9)
+    acc += s->c2 * ((p[-c - 1] + p[c - 1]) + (p[-c + 1] + p[c + 1]));
+  return acc;
+}
+
+void stencil2d_s(uint64_t r, uint64_t c, const double *src, double *dst,
+                 const stencil_t *s) {
+  for (uint64_t i = 0; i < r; ++i)
+    for (uint64_t j = 0; j < c; ++j)
+      dst[i * c + j] = (i == 0 || i == r - 1 || j == 0 || j == c - 1)
+                           ? src[i * c + j]
+                           : stencil2d_point(&src[i * c + j], c, s);
+}
+
+// One output row from the rows up, mid, and down. The l_ and r_ scalars are
+// the neighbors outside the strip (l_v and r_v of up + down).
+static inline vfloat64m2_t stencil2d_row(vfloat64m2_t up, vfloat64m2_t mid,
+                                         vfloat64m2_t down, double l_mid,
+                                         double r_mid, double l_v, double r_v,
+                                         const stencil_t *s, const int nine,
+                                         size_t vl) {
+  vfloat64m2_t v = __riscv_vfadd_vv_f64m2(up, down, vl);
+  vfloat64m2_t acc = __riscv_vfadd_vv_f64m2(
+      v, __riscv_vfslide1up_vf_f64m2(mid, l_mid, vl), vl);
+  acc = __riscv_vfadd_vv_f64m2(
+      acc, __riscv_vfslide1down_vf_f64m2(mid, r_mid, vl), vl);
+  acc = __riscv_vfmul_vf_f64m2(acc, s->c1, vl);
+  acc = __riscv_vfmacc_vf_f64m2(acc, s->c0, mid, vl);
+  if (nine) {
+    vfloat64m2_t d = __riscv_vfadd_vv_f64m2(
+        __riscv_vfslide1up_vf_f64m2(v, l_v, vl),
+        __riscv_vfslide1down_vf_f64m2(v, r_v, vl), vl);
+    acc = __riscv_vfmacc_vf_f64m2(acc, s->c2, d, vl);
+  }
+  return acc;
+}
+
+// Row i = k - t of step t, from the rows P, Q, N (i - 1, i, i + 1) of step
+// t - 1. The first and last rows are copied.
+#define STENCIL2D_STEP(t, P, Q, N, OUT, LQ, RQ, LV, RV)                        \
+  if (k >= t && k - t < (int64_t)r) {                                          \
+    if (k == t || k - t == (int64_t)r - 1) {                                   \
+      OUT = Q;                                                                 \
+    } else {                                                                   \
+      OUT = stencil2d_row(P, Q, N, LQ, RQ, LV, RV, s, nine, vl);               \
+      if (edge)                                                                \
+        OUT = __riscv_vmerge_vvm_f64m2(Q, OUT, inner, vl);                     \
+    }                                                                          \
+  }
+
+// Shift the rows of step t, if it produced one
+#define STENCIL2D_SHIFT(t, P, Q, N)                                            \
+  if (k >= t && k - t < (int64_t)r) {                                          \
+    P = Q;                                                                     \
+    Q = N;                                                                     \
+  }
+
+// T time steps on the strip of vl columns from j0. The columns from lo are
+// stored.
+static inline __attribute__((always_inline)) void
+stencil2d_strip(uint64_t r, uint64_t c, const double *src, double *dst,
+                const stencil_t *s, uint64_t j0, size_t vl, size_t lo,
+                const unsigned int T, const int nine) {
+  // The boundary columns keep their value
+  const int edge = j0 == 0 || j0 + vl == c;
+  vuint64m2_t col = __riscv_vadd_vx_u64m2(__riscv_vid_v_u64m2(vl), j0, vl);
+  vbool32_t inner = __riscv_vmand_mm_b32(
+      __riscv_vmsgtu_vx_u64m2_b32(col, 0, vl),
+      __riscv_vmsltu_vx_u64m2_b32(col, c - 1, vl), vl);
+  vbool32_t store = __riscv_vmsgeu_vx_u64m2_b32(col, j0 + lo, vl);
+
+  vfloat64m2_t p0, q0, n0, p1, q1, n1, p2, q2, n2, p3, q3, n3, n4;
+  p0 = q0 = n0 = __riscv_vfmv_v_f_f64m2(0, vl);
+  p1 = q1 = n1 = p2 = q2 = n2 = p3 = q3 = n3 = n4 = p0;
+  // Neighbors of the input rows
+  double lp = 0, lq = 0, ln = 0, rp = 0, rq = 0, rn = 0;
+
+  for (int64_t k = 0; k < (int64_t)(r + T); ++k) {
+    if (k < (int64_t)r) {
+      const double *row = src + k * c + j0;
+      n0 = __riscv_vle64_v_f64m2(row, vl);
+      ln = j0 ? row[-1] : 0;
+      rn = j0 + vl < c ? row[vl] : 0;
+    }
+
+    STENCIL2D_STEP(1, p0, q0, n0, n1, lq, rq, lp + ln, rp + rn)
+    if (k < (int64_t)r) {
+      p0 = q0;
+      q0 = n0;
+      lp = lq;
+      lq = ln;
+      rp = rq;
+      rq = rn;
+    }
+    if (T > 1) {
+      STENCIL2D_STEP(2, p1, q1, n1, n2, 0, 0, 0, 0)
+      STENCIL2D_SHIFT(1, p1, q1, n1)
+    }
+    if (T > 2) {
+      STENCIL2D_STEP(3, p2, q2, n2, n3, 0, 0, 0, 0)
+      STENCIL2D_SHIFT(2, p2, q2, n2)
+    }
+    if (T > 3) {
+      STENCIL2D_STEP(4, p3, q3, n3, n4, 0, 0, 0, 0)
+      STENCIL2D_SHIFT(3, p3, q3, n3)
+    }
+
+    // Store the row of the last step
+    int64_t i = k - T;
+    if (i >= 0) {
+      vfloat64m2_t out = T == 1 ? n1 : T == 2 ? n2 : T == 3 ? n3 : n4;
+      double *row = dst + i * c + j0;
+      if (lo)
+        __riscv_vse64_v_f64m2_m(store, row, out, vl);
+      else
+        __riscv_vse64_v_f64m2(row, out, vl);
+    }
+  }
+}
+
+static inline __attribute__((always_inline)) void
+stencil2d_pass(uint64_t r, uint64_t c, const double *src, double *dst,
+               const stencil_t *s, const unsigned int T, const int nine) {
+  // Columns of each side of a strip that are not valid after T steps. The
+  // right halo is stored anyway, and overwritten by the next strip.
+  const size_t halo = T - 1;
+
+  for (uint64_t j0 = 0;;) {
+    size_t vl = __riscv_vsetvl_e64m2(c - j0);
+    size_t lo = j0 ? halo : 0;
+    stencil2d_strip(r, c, src, dst, s, j0, vl, lo, T, nine);
+    if (j0 + vl == c)
+      break;
+    j0 += vl - 2 * halo;
+  }
+}
+
+void stencil2d_tb_v(uint64_t r, uint64_t c, const double *src, double *dst,
+                    const stencil_t *s, unsigned int T) {
+  if (s->points == 9) {
+    switch (T) {
+    case 1:
+      stencil2d_pass(r, c, src, dst, s, 1, 1);
+      break;
+    case 2:
+      stencil2d_pass(r, c, src, dst, s, 2, 1);
+      break;
+    case 3:
+      stencil2d_pass(r, c, src, dst, s, 3, 1);
+      break;
+    default:
+      stencil2d_pass(r, c, src, dst, s, 4, 1);
+    }
+  } else {
+    switch (T) {
+    case 1:
+      stencil2d_pass(r, c, src, dst, s, 1, 0);
+      break;
+    case 2:
+      stencil2d_pass(r, c, src, dst, s, 2, 0);
+      break;
+    case 3:
+      stencil2d_pass(r, c, src, dst, s, 3, 0);
+      break;
+    default:
+      stencil2d_pass(r, c, src, dst, s, 4, 0);
+    }
+  }
+}
+
+double *stencil2d_run_s(uint64_t r, uint64_t c, double *A, double *B,
+                        const stencil_t *s, uint64_t steps) {
+  for (uint64_t t = 0; t < steps; ++t) {
+    stencil2d_s(r, c, A, B, s);
+    double *tmp = A;
+    A = B;
+    B = tmp;
+  }
+  return A;
+}
+
+double *stencil2d_run_v(uint64_t r, uint64_t c, double *A, double *B,
+                        const stencil_t *s, uint64_t steps, unsigned int T) {
+  T = T < 1 ? 1 : MIN(T, STENCIL_TB_MAX);
+  uint64_t passes = (steps + T - 1) / T;
+
+  for (uint64_t done = 0; done < steps;) {
+    unsigned int t = MIN(T, steps - done);
+    // With an odd number of passes, split the last one so that the result
+    // ends up in A
+    if ((passes & 1) && t == steps - done && t > 1) {
+      --t;
+      ++passes;
+    }
+    stencil2d_tb_v(r, c, A, B, s, t);
+    double *tmp = A;
+    A = B;
+    B = tmp;
+    done += t;
+  }
+  return A;
+}
+
+////////
+// 3D //
+////////
+
+void stencil3d_s(uint64_t nz, uint64_t ny, uint64_t nx, const double *src,
+                 double *dst, const stencil_t *s) {
+  const uint64_t pz = ny * nx;
+  for (uint64_t z = 0; z < nz; ++z)
+    for (uint64_t y = 0; y < ny; ++y)
+      for (uint64_t x = 0; x < nx; ++x) {
+        const double *p = &src[z * pz + y * nx + x];
+        if (z == 0 || z == nz - 1 || y == 0 || y == ny - 1 || x == 0 ||
+            x == nx - 1) {
+          dst[z * pz + y * nx + x] = p[0];
+        } else {
+          double acc = p[-pz] + p[pz];
+          acc = ((acc + p[-nx]) + p[nx]);
+          acc = ((acc + p[-1]) + p[1]);
+          dst[z * pz + y * nx + x] = acc * s->c1 + s->c0 * p[0];
+        }
+      }
+}
+
+static void stencil_copy(double *dst, const double *src, uint64_t len) {
+  size_t vl;
+  for (uint64_t i = 0; i < len; i += vl) {
+    vl = __riscv_vsetvl_e64m8(len - i);
+    __riscv_vse64_v_f64m8(dst + i, __riscv_vle64_v_f64m8(src + i, vl), vl);
+  }
+}
+
+void stencil3d_v(uint64_t nz, uint64_t ny, uint64_t nx, const double *src,
+                 double *dst, const stencil_t *s) {
+  const uint64_t pz = ny * nx;
+  size_t vl;
+
+  // Boundary planes and rows
+  stencil_copy(dst, src, pz);
+  stencil_copy(dst + (nz - 1) * pz, src + (nz - 1) * pz, pz);
+  for (uint64_t z = 1; z < nz - 1; ++z) {
+    stencil_copy(dst + z * pz, src + z * pz, nx);
+    stencil_copy(dst + z * pz + (ny - 1) * nx, src + z * pz + (ny - 1) * nx,
+                 nx);
+  }
+
+  for (uint64_t j0 = 0; j0 < nx; j0 += vl) {
+    vl = __riscv_vsetvl_e64m2(nx - j0);
+    const int edge = j0 == 0 || j0 + vl == nx;
+    vuint64m2_t col = __riscv_vadd_vx_u64m2(__riscv_vid_v_u64m2(vl), j0, vl);
+    vbool32_t inner = __riscv_vmand_mm_b32(
+        __riscv_vmsgtu_vx_u64m2_b32(col, 0, vl),
+        __riscv_vmsltu_vx_u64m2_b32(col, nx - 1, vl), vl);
+
+    for (uint64_t y = 1; y < ny - 1; ++y) {
+      const double *p = src + y * nx + j0;
+      double *q = dst + pz + y * nx + j0;
+      // Rows of the planes z - 1 and z
+      vfloat64m2_t back = __riscv_vle64_v_f64m2(p, vl);
+      vfloat64m2_t mid = __riscv_vle64_v_f64m2(p + pz, vl);
+
+      for (uint64_t z = 1; z < nz - 1; ++z) {
+        p += pz;
+        vfloat64m2_t front = __riscv_vle64_v_f64m2(p + pz, vl);
+        vfloat64m2_t up = __riscv_vle64_v_f64m2(p - nx, vl);
+        vfloat64m2_t down = __riscv_vle64_v_f64m2(p + nx, vl);
+        double l = j0 ? p[-1] : 0;
+        double r = j0 + vl < nx ? p[vl] : 0;
+
+        vfloat64m2_t acc = __riscv_vfadd_vv_f64m2(back, front, vl);
+        acc = __riscv_vfadd_vv_f64m2(acc, up, vl);
+        acc = __riscv_vfadd_vv_f64m2(acc, down, vl);
+        acc = __riscv_vfadd_vv_f64m2(
+            acc, __riscv_vfslide1up_vf_f64m2(mid, l, vl), vl);
+        acc = __riscv_vfadd_vv_f64m2(
+            acc, __riscv_vfslide1down_vf_f64m2(mid, r, vl), vl);
+        acc = __riscv_vfmul_vf_f64m2(acc, s->c1, vl);
+        acc = __riscv_vfmacc_vf_f64m2(acc, s->c0, mid, vl);
+        if (edge)
+          acc = __riscv_vmerge_vvm_f64m2(mid, acc, inner, vl);
+        __riscv_vse64_v_f64m2(q, acc, vl);
+        q += pz;
+
+        back = mid;
+        mid = front;
+      }
+    }
+  }
+}
+
+double *stencil3d_run_s(uint64_t nz, uint64_t ny, uint64_t nx, double *A,
+                        double *B, const stencil_t *s, uint64_t steps) {
+  for (uint64_t t = 0; t < steps; ++t) {
+    stencil3d_s(nz, ny, nx, A, B, s);
+    double *tmp = A;
+    A = B;
+    B = tmp;
+  }
+  return A;
+}
+
+double *stencil3d_run_v(uint64_t nz, uint64_t ny, uint64_t nx, double *A,
+                        double *B, const stencil_t *s, uint64_t steps) {
+  for (uint64_t t = 0; t < steps; ++t) {
+    stencil3d_v(nz, ny, nx, A, B, s);
+    double *tmp = A;
+    A = B;
+    B = tmp;
+  }
+  return A;
+}
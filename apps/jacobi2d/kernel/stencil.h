@@ -0,0 +1,61 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Stencils on double-precision grids with a fixed boundary: 5-point and
+// 9-point in 2D, 7-point in 3D. Each time step reads src and writes the whole
+// grid, boundary included, to dst.
+
+#ifndef _STENCIL_H_
+#define _STENCIL_H_
+
+#include <stdint.h>
+
+typedef struct {
+  // 5 or 9 in 2D, 7 in 3D
+  unsigned int points;
+  // Weights of the center, of the face neighbors, and of the corners (9-point)
+  double c0;
+  double c1;
+  double c2;
+} stencil_t;
+
+// Time steps applied in one pass over a 2D grid
+#define STENCIL_TB_MAX 4
+
+// One time step
+void stencil2d_s(uint64_t r, uint64_t c, const double *src, double *dst,
+                 const stencil_t *s);
+void stencil3d_s(uint64_t nz, uint64_t ny, uint64_t nx, const double *src,
+                 double *dst, const stencil_t *s);
+void stencil3d_v(uint64_t nz, uint64_t ny, uint64_t nx, const double *src,
+                 double *dst, const stencil_t *s);
+
+// T <= STENCIL_TB_MAX time steps in one pass
+void stencil2d_tb_v(uint64_t r, uint64_t c, const double *src, double *dst,
+                    const stencil_t *s, unsigned int T);
+
+// steps time steps, ping-ponging between A and B. Return the grid with the
+// result, which is A for an even number of steps.
+double *stencil2d_run_s(uint64_t r, uint64_t c, double *A, double *B,
+                        const stencil_t *s, uint64_t steps);
+double *stencil2d_run_v(uint64_t r, uint64_t c, double *A, double *B,
+                        const stencil_t *s, uint64_t steps, unsigned int T);
+double *stencil3d_run_s(uint64_t nz, uint64_t ny, uint64_t nx, double *A,
+                        double *B, const stencil_t *s, uint64_t steps);
+double *stencil3d_run_v(uint64_t nz, uint64_t ny, uint64_t nx, double *A,
+                        double *B, const stencil_t *s, uint64_t steps);
+
+#endif
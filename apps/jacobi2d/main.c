@@ -95,11 +95,79 @@ extern uint64_t R;
 extern uint64_t C;
 
 extern uint64_t TSTEPS;
+extern uint64_t TB;
 
 extern DATA_TYPE A_s[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern DATA_TYPE B_s[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern DATA_TYPE A_v[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
 extern DATA_TYPE B_v[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+// Copy of the input, for the temporally blocked run and the stencil sweep.
+// Their grids are the scalar (reference) and vector ones, once j2d_s and j2d_v
+// are checked.
+extern DATA_TYPE A_0[] __attribute__((aligned(4 * NR_LANES), section(".l2")));
+
+// Time steps per pass of the temporally blocked jacobi2d, if not given by TB
+#ifndef JACOBI2D_TB
+#define JACOBI2D_TB 2
+#endif
+
+// Time steps of each point of the stencil sweep
+#ifndef STENCIL_STEPS
+#define STENCIL_STEPS 4
+#endif
+
+// Side of the 3D grid of the sweep
+#ifndef STENCIL3D_N
+#define STENCIL3D_N 16
+#endif
+
+static int check_grid(const DATA_TYPE *ref, const DATA_TYPE *res,
+                      uint64_t len) {
+  for (uint64_t i = 0; i < len; ++i)
+    if (!similarity_check(ref[i], res[i], THRESHOLD)) {
+      printf("Error: [%d], %f, %f\n", i, ref[i], res[i]);
+      return 1;
+    }
+  return 0;
+}
+
+// Copy the top-left r x c corner of the input (row stride C) in a compact grid
+static void load_grid(DATA_TYPE *dst, uint64_t r, uint64_t c) {
+  for (uint64_t i = 0; i < r; ++i)
+    memcpy(dst + i * c, A_0 + i * C, c * sizeof(DATA_TYPE));
+}
+
+// Run a stencil on a r x c grid (2D) or r x r x r grid (3D) for every T, and
+// check it against the scalar version
+static int stencil_sweep(const char *name, const stencil_t *s, uint64_t r,
+                         uint64_t c) {
+  int error = 0;
+  const int is_3d = s->points == 7;
+  const uint64_t len = is_3d ? r * r * r : r * c;
+  const unsigned int t_max = is_3d ? 1 : STENCIL_TB_MAX;
+
+  load_grid(A_s, is_3d ? 1 : r, is_3d ? len : c);
+  memcpy(B_s, A_s, len * sizeof(DATA_TYPE));
+  DATA_TYPE *ref = is_3d ? stencil3d_run_s(r, r, r, A_s, B_s, s, STENCIL_STEPS)
+                         : stencil2d_run_s(r, c, A_s, B_s, s, STENCIL_STEPS);
+
+  for (unsigned int T = 1; T <= t_max; ++T) {
+    load_grid(A_v, is_3d ? 1 : r, is_3d ? len : c);
+    DATA_TYPE *res;
+    start_timer();
+    if (is_3d)
+      res = stencil3d_run_v(r, r, r, A_v, B_v, s, STENCIL_STEPS);
+    else
+      res = stencil2d_run_v(r, c, A_v, B_v, s, STENCIL_STEPS, T);
+    stop_timer();
+    int64_t runtime = get_timer();
+    printf("%-8s %4d %4d %2d %10d %10f\n", name, r, c, T, runtime,
+           (float)runtime / (len * STENCIL_STEPS));
+    error |= check_grid(ref, res, len);
+  }
+
+  return error;
+}
 
 int main() {
   printf("\n");
@@ -182,6 +250,41 @@ int main() {
                A_fixed_v[i * C + j]);
         error = 1;
       }
+
+  // Temporally blocked version, on fresh copies of A. B shares the boundary of
+  // A, which stays fixed over the time steps, so the reference is the scalar
+  // stencil on the same grids.
+  const stencil_t jacobi = {5, 0.2, 0.2, 0};
+  const size_t mtx_len = (mtx_offset + R * C) * sizeof(DATA_TYPE);
+  memcpy(A_s, A_0, mtx_len);
+  memcpy(B_s, A_0, mtx_len);
+  DATA_TYPE *ref =
+      stencil2d_run_s(R, C, A_fixed_s, B_fixed_s, &jacobi, 2 * TSTEPS);
+  memcpy(A_v, A_0, mtx_len);
+  memcpy(B_v, A_0, mtx_len);
+  unsigned int tb = TB ? TB : JACOBI2D_TB;
+  printf("Processing the temporally blocked benchmark (T = %d)\n", tb);
+  start_timer();
+  j2d_tb_v(R, C, A_fixed_v, B_fixed_v, TSTEPS, tb);
+  stop_timer();
+  int64_t runtime_tb = get_timer();
+  printf("Temporally blocked jacobi2d cycle count: %d (%f%% of the vector "
+         "one)\n",
+         runtime_tb, 100.0 * runtime_tb / runtime);
+  error |= check_grid(ref, A_fixed_v, R * C);
+
+  // Stencil sweep on the grid sizes, and on T
+  const stencil_t box = {9, 0.2, 0.15, 0.05};
+  const stencil_t jacobi3d = {7, 1.0 / 7, 1.0 / 7, 0};
+  printf("\n%d time steps per run\n", STENCIL_STEPS);
+  printf("stencil     rows cols  T     cycles cycles/point/step\n");
+  for (uint64_t n = 18; n <= R && n <= C; n = 2 * n - 2) {
+    error |= stencil_sweep("2D 5-pt", &jacobi, n, n);
+    error |= stencil_sweep("2D 9-pt", &box, n, n);
+  }
+  if (STENCIL3D_N * STENCIL3D_N * STENCIL3D_N <= R * C)
+    error |= stencil_sweep("3D 7-pt", &jacobi3d, STENCIL3D_N, STENCIL3D_N);
+
   if (!error)
     printf("Check successful: no errors.\n");
 
@@ -35,17 +35,19 @@ def emit(name, array, alignment='8'):
 ## SCRIPT ##
 ############
 
-if len(sys.argv) == 3:
+if len(sys.argv) >= 3 and len(sys.argv) <= 5:
   R = int(sys.argv[1])
   C = int(sys.argv[2])
+  # Optional number of time steps, and time steps per pass of the temporally
+  # blocked kernel (0: use the default kernel in the benchmark)
+  TSTEPS = int(sys.argv[3]) if len(sys.argv) > 3 else 1
+  TB     = int(sys.argv[4]) if len(sys.argv) > 4 else 0
 else:
-  print("Error. Give me one argument: the number of vector elements.")
+  print("Error. Give me the rows and the columns, and optionally the time steps and the time steps per pass.")
   sys.exit()
 
 dtype = np.float64
 
-TSTEPS = 1
-
 # Fill in the extra data to align the matrices to 4*NrLanes in SW
 maxNrLanes   = 16
 maxAlignment = 4*maxNrLanes              # [B]
@@ -62,7 +64,11 @@ print(".section .data,\"aw\",@progbits")
 emit("R", np.array(R, dtype=np.uint64))
 emit("C", np.array(C, dtype=np.uint64))
 emit("TSTEPS", np.array(TSTEPS, dtype=np.uint64))
+emit("TB", np.array(TB, dtype=np.uint64))
 emit("A_v", A, 'NR_LANES*4')
 emit("B_v", B, 'NR_LANES*4')
 emit("A_s", A, 'NR_LANES*4')
 emit("B_s", B, 'NR_LANES*4')
+# Pristine copy of A, for the temporally blocked run and the stencil sweep of
+# the jacobi2d app, which reuse the grids above once j2d_s and j2d_v are checked
+emit("A_0", A, 'NR_LANES*4')
@@ -0,0 +1,56 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Public header of libara-rvv, the library of RVV kernels shared by the
+// applications. The kernels are implemented once, in the kernel folder of
+// their application, and compiled into libara-rvv by libara-rvv.mk. Programs
+// include this header and link the library instead of compiling their own
+// copy of the kernels.
+
+#ifndef _ARA_RVV_H_
+#define _ARA_RVV_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Matrix multiplication
+#include "../fmatmul/kernel/fmatmul.h"
+#include "../imatmul/kernel/imatmul.h"
+
+// Convolutions
+#include "../fconv2d/fconv2d.h"
+#include "../fconv3d/fconv3d.h"
+#include "../iconv2d/iconv2d.h"
+#include "../conv/kernel/conv.h"
+
+// Linear algebra
+#include "../dotproduct/kernel/dotproduct.h"
+#include "../fdotproduct/kernel/fdotproduct.h"
+#include "../gemv/kernel/gemv.h"
+#include "../spmv/kernel/spmv.h"
+
+// Math functions
+#include "../cos/kernel/cos.h"
+#include "../exp/kernel/exp.h"
+#include "../log/kernel/log.h"
+#include "../softmax/kernel/softmax.h"
+#include "../vmath/kernel/vmath.h"
+
+// Signal processing
+#include "../dwt/kernel/wavelet.h"
+#include "../fft/kernel/fft.h"
+
+#endif
@@ -0,0 +1,103 @@
+# Copyright 2024 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# libara-rvv: static library of the RVV kernels shared by the applications
+#
+# The library is built from the kernel sources of the applications, with the
+# same flags as the applications themselves. There is one flavour of the
+# library per runtime: bare-metal, Linux (LINUX=1) and Spike. The objects are
+# kept in the build folder of the library, apart from the ones of the
+# applications.
+
+LIBARA_RVV_DIR := libara-rvv
+
+# Kernel sources. Their headers are collected in ara_rvv.h
+LIBARA_RVV_SRCS := fmatmul/kernel/fmatmul.c              \
+                   fmatmul/kernel/fgemm.c                \
+                   imatmul/kernel/imatmul.c              \
+                   fconv2d/fconv2d_3x3.c                 \
+                   fconv2d/fconv2d_7x7.c                 \
+                   fconv3d/fconv3d_3x7x7.c               \
+                   conv/kernel/conv.c                    \
+                   iconv2d/iconv2d_3x3.c                 \
+                   iconv2d/iconv2d_5x5.c                 \
+                   iconv2d/iconv2d_7x7.c                 \
+                   dotproduct/kernel/dotproduct.c        \
+                   fdotproduct/kernel/fdotproduct.c      \
+                   gemv/kernel/gemv.c                    \
+                   spmv/kernel/spmv.c                    \
+                   cos/kernel/cos.c                      \
+                   exp/kernel/exp.c                      \
+                   log/kernel/log.c                      \
+                   vmath/kernel/vmath.c                  \
+                   softmax/kernel/softmax.c              \
+                   dwt/kernel/wavelet.c                  \
+                   fft/kernel/fft.c                      \
+                   fft/kernel/fft_mr.c
+
+LIBARA_RVV_BUILD := $(LIBARA_RVV_DIR)/build
+LIBARA_RVV       := $(LIBARA_RVV_BUILD)/libara-rvv$(BIN_SUFFIX).a
+LIBARA_RVV_SPIKE := $(LIBARA_RVV_BUILD)/libara-rvv.spike.a
+
+LIBARA_RVV_OBJS       := $(addprefix $(LIBARA_RVV_BUILD)/obj$(BIN_SUFFIX)/, $(addsuffix .o, $(LIBARA_RVV_SRCS)))
+LIBARA_RVV_OBJS_SPIKE := $(addprefix $(LIBARA_RVV_BUILD)/obj-spike/, $(addsuffix .o, $(LIBARA_RVV_SRCS)))
+
+# The flags are expanded here, so that the objects do not inherit the
+# target-specific defines of the application that first requests them
+LIBARA_RVV_CCFLAGS       := $(RISCV_CCFLAGS)
+LIBARA_RVV_CCFLAGS_SPIKE := $(RISCV_CCFLAGS_SPIKE)
+
+# The stamps hold the flags of the objects (ENV_DEFINES, NR_LANES, VLEN, ...).
+# They are rewritten only when the flags change, which rebuilds the objects.
+LIBARA_RVV_STAMP       := $(LIBARA_RVV_BUILD)/obj$(BIN_SUFFIX)/flags.stamp
+LIBARA_RVV_STAMP_SPIKE := $(LIBARA_RVV_BUILD)/obj-spike/flags.stamp
+
+.PHONY: libara-rvv_flags
+libara-rvv_flags:
+
+$(LIBARA_RVV_STAMP): libara-rvv_flags
+	mkdir -p $(dir $@)
+	echo '$(LIBARA_RVV_CCFLAGS)' | cmp -s - $@ || echo '$(LIBARA_RVV_CCFLAGS)' > $@
+
+$(LIBARA_RVV_STAMP_SPIKE): libara-rvv_flags
+	mkdir -p $(dir $@)
+	echo '$(LIBARA_RVV_CCFLAGS_SPIKE)' | cmp -s - $@ || echo '$(LIBARA_RVV_CCFLAGS_SPIKE)' > $@
+
+# The objects also depend on the headers they include, listed by -MMD
+$(LIBARA_RVV_BUILD)/obj$(BIN_SUFFIX)/%.c.o: %.c $(LIBARA_RVV_STAMP)
+	mkdir -p $(dir $@)
+	$(RISCV_CC) $(LIBARA_RVV_CCFLAGS) -MMD -MP -c $< -o $@
+
+$(LIBARA_RVV_BUILD)/obj-spike/%.c.o: %.c $(LIBARA_RVV_STAMP_SPIKE)
+	mkdir -p $(dir $@)
+	$(RISCV_CC) $(LIBARA_RVV_CCFLAGS_SPIKE) -MMD -MP -c $< -o $@
+
+-include $(LIBARA_RVV_OBJS:.o=.d) $(LIBARA_RVV_OBJS_SPIKE:.o=.d)
+
+$(LIBARA_RVV): $(LIBARA_RVV_OBJS)
+	rm -f $@
+	$(RISCV_AR) rcs $@ $^
+
+$(LIBARA_RVV_SPIKE): $(LIBARA_RVV_OBJS_SPIKE)
+	rm -f $@
+	$(RISCV_AR) rcs $@ $^
+
+.PHONY: libara-rvv
+libara-rvv: $(LIBARA_RVV)
+
+.PHONY: libara-rvv_clean
+libara-rvv_clean:
+	rm -rvf $(LIBARA_RVV_BUILD)
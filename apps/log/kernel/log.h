@@ -32,6 +32,9 @@
   (this is the zlib license)
 */
 
+#ifndef _LOG_H_
+#define _LOG_H_
+
 #include <stdio.h>
 #include <string.h>
 
@@ -153,3 +156,5 @@ inline _MMR_f32 __log_2xf32(_MMR_f32 x, unsigned long int gvl) {
 
   return x;
 }
+
+#endif
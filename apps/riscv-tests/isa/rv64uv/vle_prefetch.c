@@ -0,0 +1,191 @@
+// Copyright 2026 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Unit-strided load streams, as seen by the prefetcher of the VLSU
+// (vlsu_prefetch=1). After two stripes of a stream, the head of the next one
+// is prefetched into a buffer. The cases write the prefetched stripe with
+// vector and scalar stores before loading it, interleave several streams on
+// the same AXI ID, and load stripes longer than the buffer and across pages.
+// Every loaded element is checked against a scalar copy of the memory.
+
+#include "vector_macros.h"
+
+#define PAGE 4096
+#define WORDS (4 * PAGE / 4)
+
+static volatile uint32_t MEM[WORDS] __attribute__((aligned(PAGE)));
+static volatile uint32_t OUT[WORDS] __attribute__((aligned(PAGE)));
+// Expected contents of MEM, only written by scalar code
+static uint32_t EXP[WORDS];
+
+// Elements of a stripe (e32, m1) and of a long stripe (e32, m8)
+static uint64_t stripe, long_stripe;
+
+static uint64_t vlmax_m1(void) {
+  uint64_t vl;
+  asm volatile("vsetvli %0, zero, e32, m1, ta, ma" : "=r"(vl));
+  return vl;
+}
+
+static uint64_t vlmax_m8(void) {
+  uint64_t vl;
+  asm volatile("vsetvli %0, zero, e32, m8, ta, ma" : "=r"(vl));
+  return vl;
+}
+
+// Let the VLSU go idle without touching the memory, so that the prefetch
+// requests are issued
+static void wait_idle(void) {
+  uint64_t cnt = 256;
+  asm volatile("1: addi %0, %0, -1\n bnez %0, 1b" : "+r"(cnt));
+}
+
+// Load n elements from MEM[first] with a single vle32, and check them
+static int vload(int casenum, uint64_t first, uint64_t n) {
+  if (n > stripe) {
+    asm volatile("vsetvli zero, %0, e32, m8, ta, ma" ::"r"(n));
+    asm volatile("vle32.v v16, (%0)" ::"r"(&MEM[first]));
+    asm volatile("vse32.v v16, (%0)" ::"r"(OUT));
+  } else {
+    asm volatile("vsetvli zero, %0, e32, m1, ta, ma" ::"r"(n));
+    asm volatile("vle32.v v8, (%0)" ::"r"(&MEM[first]));
+    asm volatile("vse32.v v8, (%0)" ::"r"(OUT));
+  }
+  MEMORY_BARRIER;
+  for (uint64_t i = 0; i < n; ++i) {
+    if (OUT[i] != EXP[first + i]) {
+      printf("Test case %d, element %d FAILED. Got %x, expected %x.\n", casenum,
+             (int)(first + i), OUT[i], EXP[first + i]);
+      num_failed++;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Store seed, seed + 1, ... to the n elements from MEM[first] with a vse32
+static void vstore(uint64_t first, uint64_t n, uint32_t seed) {
+  asm volatile("vsetvli zero, %0, e32, m1, ta, ma" ::"r"(n));
+  asm volatile("vid.v v24");
+  asm volatile("vadd.vx v24, v24, %0" ::"r"(seed));
+  asm volatile("vse32.v v24, (%0)" ::"r"(&MEM[first]));
+  for (uint64_t i = 0; i < n; ++i)
+    EXP[first + i] = seed + i;
+}
+
+// Load the stripes [from, to) of the stream starting at MEM[first]
+static int stream(int casenum, uint64_t first, int from, int to) {
+  for (int s = from; s < to; ++s)
+    if (vload(casenum, first + s * stripe, stripe))
+      return 1;
+  return 0;
+}
+
+// A stream of 6 stripes from the start of a page
+void TEST_CASE1(void) {
+  printf("Checking the results of the test case 1:\n");
+  if (stream(1, 0, 0, 6))
+    return;
+  printf("PASSED.\n");
+}
+
+// The prefetched stripe is overwritten by vector stores before it is loaded
+void TEST_CASE2(void) {
+  const uint64_t first = WORDS / 4;
+  printf("Checking the results of the test case 2:\n");
+  if (stream(2, first, 0, 2))
+    return;
+  wait_idle();
+  vstore(first + 2 * stripe, stripe, 0x20000);
+  if (stream(2, first, 2, 3))
+    return;
+  // A single element in the middle of the next prefetched stripe
+  wait_idle();
+  vstore(first + 3 * stripe + stripe / 2 + 1, 1, 0x20100);
+  if (stream(2, first, 3, 4))
+    return;
+  printf("PASSED.\n");
+}
+
+// The prefetched stripe is overwritten by a scalar store before it is loaded
+void TEST_CASE3(void) {
+  const uint64_t first = WORDS / 2;
+  const uint64_t elm = first + 2 * stripe + stripe / 2 - 1;
+  printf("Checking the results of the test case 3:\n");
+  if (stream(3, first, 0, 2))
+    return;
+  wait_idle();
+  MEM[elm] = 0x30000;
+  EXP[elm] = 0x30000;
+  if (stream(3, first, 2, 4))
+    return;
+  printf("PASSED.\n");
+}
+
+// Two interleaved streams, then a third one that replaces the oldest, so that
+// the responses to their demand and prefetch requests alternate on ID 0
+void TEST_CASE4(void) {
+  const uint64_t a = 0, b = WORDS / 4, c = WORDS / 2;
+  printf("Checking the results of the test case 4:\n");
+  for (int s = 0; s < 4; ++s) {
+    if (stream(4, a, s, s + 1) || stream(4, b, s, s + 1))
+      return;
+    if (s & 1)
+      wait_idle();
+  }
+  if (stream(4, c, 0, 3) || stream(4, a, 4, 6) || stream(4, b, 4, 5))
+    return;
+  printf("PASSED.\n");
+}
+
+// Stripes longer than the buffer take their head from it and the rest from
+// memory, and the last ones cross a page
+void TEST_CASE5(void) {
+  const uint64_t first = WORDS / 4 - long_stripe + stripe / 2;
+  printf("Checking the results of the test case 5:\n");
+  for (int s = 0; s < 4; ++s) {
+    if (first + (s + 1) * long_stripe > WORDS)
+      break;
+    if (vload(5, first + s * long_stripe, long_stripe))
+      return;
+    wait_idle();
+  }
+  printf("PASSED.\n");
+}
+
+// A stream whose prefetch is cut at the end of a page
+void TEST_CASE6(void) {
+  const uint64_t first = 3 * (WORDS / 4) - 2 * stripe - stripe / 2;
+  printf("Checking the results of the test case 6:\n");
+  for (int s = 0; s < 4; ++s) {
+    if (stream(6, first, s, s + 1))
+      return;
+    wait_idle();
+  }
+  printf("PASSED.\n");
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  // The short stripes fit in the buffer of the prefetcher (32 AXI words), the
+  // long ones do not
+  stripe = vlmax_m1() < 64 ? vlmax_m1() : 64;
+  long_stripe = vlmax_m8() < 1024 ? vlmax_m8() : 1024;
+
+  for (uint64_t i = 0; i < WORDS; ++i) {
+    EXP[i] = (uint32_t)(i * 2654435761u + 7);
+    MEM[i] = EXP[i];
+  }
+
+  TEST_CASE1();
+  TEST_CASE2();
+  TEST_CASE3();
+  TEST_CASE4();
+  TEST_CASE5();
+  TEST_CASE6();
+
+  EXIT_CHECK();
+}
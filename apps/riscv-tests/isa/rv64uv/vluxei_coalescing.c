@@ -0,0 +1,206 @@
+// Copyright 2026 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Indexed loads whose elements form contiguous runs. With vlsu_coalescing=1,
+// the address generator requests each run with as few AXI bursts as possible,
+// so the runs here start and end in the middle of AXI words, cross 4 KiB
+// pages, and are longer than a burst of 256 beats. The last case is a strided
+// load with a stride equal to the element width, which becomes unit-strided.
+// Every loaded element is checked against the bytes in memory.
+
+#include "vector_macros.h"
+
+#define PAGE 4096
+
+// Large enough for a full e32/m8 or e64/m8 register group with VLEN = 16384,
+// starting in the second page
+static volatile uint8_t BUF[6 * PAGE] __attribute__((aligned(PAGE)));
+// Byte offsets of the elements in BUF
+static volatile uint32_t IDX[4096] __attribute__((aligned(PAGE)));
+static volatile uint8_t OUT[4 * PAGE] __attribute__((aligned(PAGE)));
+
+static uint64_t vlmax(int sew) {
+  uint64_t vl;
+  switch (sew) {
+  case 8:
+    asm volatile("vsetvli %0, zero, e8, m2, ta, ma" : "=r"(vl));
+    break;
+  case 16:
+    asm volatile("vsetvli %0, zero, e16, m4, ta, ma" : "=r"(vl));
+    break;
+  case 32:
+    asm volatile("vsetvli %0, zero, e32, m8, ta, ma" : "=r"(vl));
+    break;
+  default:
+    asm volatile("vsetvli %0, zero, e64, m8, ta, ma" : "=r"(vl));
+    break;
+  }
+  return vl;
+}
+
+// Load n elements of sew bits from the byte offsets in IDX, with 32-bit
+// indices, and compare them with the bytes of BUF
+static void check_indexed(int casenum, int sew, uint64_t n) {
+  const int bytes = sew / 8;
+
+  for (uint64_t i = 0; i < n * bytes; ++i)
+    OUT[i] = 0;
+
+  asm volatile("vsetvli zero, %0, e32, m8, ta, ma" ::"r"(n));
+  asm volatile("vle32.v v8, (%0)" ::"r"(IDX));
+  switch (sew) {
+  case 8:
+    asm volatile("vsetvli zero, %0, e8, m2, ta, ma" ::"r"(n));
+    asm volatile("vluxei32.v v16, (%0), v8" ::"r"(BUF));
+    asm volatile("vse8.v v16, (%0)" ::"r"(OUT));
+    break;
+  case 16:
+    asm volatile("vsetvli zero, %0, e16, m4, ta, ma" ::"r"(n));
+    asm volatile("vluxei32.v v16, (%0), v8" ::"r"(BUF));
+    asm volatile("vse16.v v16, (%0)" ::"r"(OUT));
+    break;
+  case 32:
+    asm volatile("vsetvli zero, %0, e32, m8, ta, ma" ::"r"(n));
+    asm volatile("vluxei32.v v16, (%0), v8" ::"r"(BUF));
+    asm volatile("vse32.v v16, (%0)" ::"r"(OUT));
+    break;
+  default:
+    asm volatile("vsetvli zero, %0, e64, m8, ta, ma" ::"r"(n));
+    asm volatile("vluxei32.v v16, (%0), v8" ::"r"(BUF));
+    asm volatile("vse64.v v16, (%0)" ::"r"(OUT));
+    break;
+  }
+
+  printf("Checking the results of the test case %d (%d elements):\n", casenum,
+         (int)n);
+  MEMORY_BARRIER;
+  for (uint64_t i = 0; i < n; ++i) {
+    for (int b = 0; b < bytes; ++b) {
+      if (OUT[i * bytes + b] != BUF[IDX[i] + b]) {
+        printf("Element %d, byte %d FAILED. Got %x, expected %x.\n", (int)i, b,
+               OUT[i * bytes + b], BUF[IDX[i] + b]);
+        num_failed++;
+        return;
+      }
+    }
+  }
+  printf("PASSED.\n");
+}
+
+// One contiguous run of n elements from the byte offset start
+static void contiguous(uint32_t start, int sew, uint64_t n) {
+  for (uint64_t i = 0; i < n; ++i)
+    IDX[i] = start + i * (sew / 8);
+}
+
+// Runs of len elements, one every gap bytes, from the byte offset start
+static void runs(uint32_t start, int sew, uint64_t len, uint32_t gap,
+                 uint64_t n) {
+  for (uint64_t i = 0; i < n; ++i)
+    IDX[i] = start + (i / len) * gap + (i % len) * (sew / 8);
+}
+
+// A whole register group from the start of a page: exactly 256 beats with up to
+// 4 lanes, more than one page with 8 and 16 lanes
+void TEST_CASE1(void) {
+  uint64_t n = vlmax(32);
+  contiguous(PAGE, 32, n);
+  check_indexed(1, 32, n);
+}
+
+// A whole register group from the middle of an AXI word, just before the end
+// of a page: the run is split at the page and ends in the middle of a word
+void TEST_CASE2(void) {
+  uint64_t n = vlmax(32);
+  contiguous(2 * PAGE - 36, 32, n);
+  check_indexed(2, 32, n);
+}
+
+// Crossing the 2 KiB boundary, at which a 256-beat burst ends with 2 lanes
+void TEST_CASE3(void) {
+  uint64_t n = vlmax(32);
+  contiguous(PAGE + PAGE / 2 - 12, 32, n);
+  check_indexed(3, 32, n);
+}
+
+// Runs of 5 elements that start and end in the middle of AXI words, the last
+// ones across a page
+void TEST_CASE4(void) {
+  uint64_t n = vlmax(32) < 200 ? vlmax(32) : 200;
+  runs(2 * PAGE - 8 * 64 + 4, 32, 5, 64, n);
+  check_indexed(4, 32, n);
+}
+
+// Bytes: the head and the tail of the run are requested with single beats of
+// decreasing size
+void TEST_CASE5(void) {
+  uint64_t n = 77;
+  contiguous(2 * PAGE - 37, 8, n);
+  check_indexed(5, 8, n);
+}
+
+// Runs of 3 halfwords, separated by one halfword, across a page
+void TEST_CASE6(void) {
+  uint64_t n = 99;
+  runs(2 * PAGE - 50, 16, 3, 8, n);
+  check_indexed(6, 16, n);
+}
+
+// A whole register group of doublewords across a page
+void TEST_CASE7(void) {
+  uint64_t n = vlmax(64);
+  contiguous(2 * PAGE - 24, 64, n);
+  check_indexed(7, 64, n);
+}
+
+// Runs of a single element: descending and repeated offsets never extend a run
+void TEST_CASE8(void) {
+  uint64_t n = 64;
+  for (uint64_t i = 0; i < n; ++i)
+    IDX[i] = 2 * PAGE + 128 - (i / 2) * 4;
+  check_indexed(8, 32, n);
+}
+
+// Strided load with a stride of one element, from the middle of an AXI word
+// and across a page
+void TEST_CASE9(void) {
+  uint64_t n = vlmax(32);
+  contiguous(2 * PAGE - 20, 32, n);
+  for (uint64_t i = 0; i < n * 4; ++i)
+    OUT[i] = 0;
+  asm volatile("vsetvli zero, %0, e32, m8, ta, ma" ::"r"(n));
+  asm volatile("vlse32.v v16, (%0), %1" ::"r"(&BUF[IDX[0]]), "r"(4));
+  asm volatile("vse32.v v16, (%0)" ::"r"(OUT));
+  printf("Checking the results of the test case 9 (%d elements):\n", (int)n);
+  MEMORY_BARRIER;
+  for (uint64_t i = 0; i < n * 4; ++i) {
+    if (OUT[i] != BUF[IDX[0] + i]) {
+      printf("Byte %d FAILED. Got %x, expected %x.\n", (int)i, OUT[i],
+             BUF[IDX[0] + i]);
+      num_failed++;
+      return;
+    }
+  }
+  printf("PASSED.\n");
+}
+
+int main(void) {
+  INIT_CHECK();
+  enable_vec();
+
+  for (uint64_t i = 0; i < sizeof(BUF); ++i)
+    BUF[i] = (uint8_t)(i * 37 + (i >> 8) * 11 + 5);
+
+  TEST_CASE1();
+  TEST_CASE2();
+  TEST_CASE3();
+  TEST_CASE4();
+  TEST_CASE5();
+  TEST_CASE6();
+  TEST_CASE7();
+  TEST_CASE8();
+  TEST_CASE9();
+
+  EXIT_CHECK();
+}
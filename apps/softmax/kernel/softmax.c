@@ -27,6 +27,14 @@
 // The following macro is just a trick and should NOT be used
 #define RESET_VREGS
 
+// Channels fetched together by the online softmax
+#define SOFTMAX_BLOCK 4
+
+// Newton-Raphson steps after vfrec7. Two are needed to reach fp32 precision.
+#ifndef SOFTMAX_NEWTON_STEPS
+#define SOFTMAX_NEWTON_STEPS 2
+#endif
+
 // Scalar implmentation inspired by OpenCV softmax:
 // https://github.com/opencv/opencv/blob/master/modules/dnn/src/layers/softmax_layer.cpp
 void softmax(const float *i, const float *o, const float *buf,
@@ -211,3 +219,185 @@ void softmax_vec(const float *i, const float *o, uint64_t channels,
     __o = _o;
   }
 }
+
+// Reciprocal of a vector of sums, which are all >= 1. vfrec7 gives 7 bits,
+// and each Newton-Raphson step, r = r * (2 - d * r), doubles them.
+static inline vfloat32m1_t softmax_rec(vfloat32m1_t d, size_t vl) {
+  vfloat32m1_t two = __riscv_vfmv_v_f_f32m1(2.0f, vl);
+  vfloat32m1_t r = __riscv_vfrec7_v_f32m1(d, vl);
+  for (int k = 0; k < SOFTMAX_NEWTON_STEPS; ++k)
+    r = __riscv_vfmul_vv_f32m1(r, __riscv_vfnmsac_vv_f32m1(two, d, r, vl), vl);
+  return r;
+}
+
+// Online softmax along the channel dimension. The first sweep keeps the
+// running maximum m and the sum d of exp(x - m) in registers, and rescales d
+// whenever m grows. The channels are fetched in blocks of SOFTMAX_BLOCK, so
+// that d is rescaled once per block. The second sweep computes the outputs
+// from the input, and multiplies them by the reciprocal of d.
+void softmax_vec_online(const float *i, const float *o, uint64_t channels,
+                        uint64_t innerSize) {
+  size_t avl = innerSize;
+  size_t vl;
+
+  // Stripmining pointers
+  float *_i = (float *)i;
+  float *_o = (float *)o;
+
+  // Stripmine on innerSize
+  for (; avl > 0; avl -= vl) {
+    vl = __riscv_vsetvl_e32m1(avl);
+
+    float *__i = _i;
+    float *__o = _o;
+
+    // Running maximum and sum, from the first channel
+    vfloat32m1_t max_chunk_v = __riscv_vle32_v_f32m1(__i, vl);
+    vfloat32m1_t den_chunk_v = __riscv_vfmv_v_f_f32m1(1.0f, vl);
+    __i += innerSize;
+
+    uint64_t ch = 1;
+    for (; ch + SOFTMAX_BLOCK <= channels; ch += SOFTMAX_BLOCK) {
+      vfloat32m1_t x0 = __riscv_vle32_v_f32m1(__i, vl);
+      vfloat32m1_t x1 = __riscv_vle32_v_f32m1(__i + innerSize, vl);
+      vfloat32m1_t x2 = __riscv_vle32_v_f32m1(__i + 2 * innerSize, vl);
+      vfloat32m1_t x3 = __riscv_vle32_v_f32m1(__i + 3 * innerSize, vl);
+      __i += SOFTMAX_BLOCK * innerSize;
+
+      // New maximum
+      vfloat32m1_t blk_max_v = __riscv_vfmax_vv_f32m1(
+          __riscv_vfmax_vv_f32m1(x0, x1, vl),
+          __riscv_vfmax_vv_f32m1(x2, x3, vl), vl);
+      blk_max_v = __riscv_vfmax_vv_f32m1(blk_max_v, max_chunk_v, vl);
+
+      // Rescale the sum, and accumulate the block
+      den_chunk_v = __riscv_vfmul_vv_f32m1(
+          den_chunk_v,
+          __exp_2xf32(__riscv_vfsub_vv_f32m1(max_chunk_v, blk_max_v, vl), vl),
+          vl);
+      den_chunk_v = __riscv_vfadd_vv_f32m1(
+          den_chunk_v,
+          __exp_2xf32(__riscv_vfsub_vv_f32m1(x0, blk_max_v, vl), vl), vl);
+      den_chunk_v = __riscv_vfadd_vv_f32m1(
+          den_chunk_v,
+          __exp_2xf32(__riscv_vfsub_vv_f32m1(x1, blk_max_v, vl), vl), vl);
+      den_chunk_v = __riscv_vfadd_vv_f32m1(
+          den_chunk_v,
+          __exp_2xf32(__riscv_vfsub_vv_f32m1(x2, blk_max_v, vl), vl), vl);
+      den_chunk_v = __riscv_vfadd_vv_f32m1(
+          den_chunk_v,
+          __exp_2xf32(__riscv_vfsub_vv_f32m1(x3, blk_max_v, vl), vl), vl);
+      max_chunk_v = blk_max_v;
+    }
+    // Leftover channels, one at a time
+    for (; ch < channels; ++ch) {
+      vfloat32m1_t x = __riscv_vle32_v_f32m1(__i, vl);
+      __i += innerSize;
+
+      vfloat32m1_t new_max_v = __riscv_vfmax_vv_f32m1(max_chunk_v, x, vl);
+      den_chunk_v = __riscv_vfmul_vv_f32m1(
+          den_chunk_v,
+          __exp_2xf32(__riscv_vfsub_vv_f32m1(max_chunk_v, new_max_v, vl), vl),
+          vl);
+      den_chunk_v = __riscv_vfadd_vv_f32m1(
+          den_chunk_v,
+          __exp_2xf32(__riscv_vfsub_vv_f32m1(x, new_max_v, vl), vl), vl);
+      max_chunk_v = new_max_v;
+    }
+
+    vfloat32m1_t rec_chunk_v = softmax_rec(den_chunk_v, vl);
+
+    // Normalize
+    __i = _i;
+    for (ch = 0; ch < channels; ++ch) {
+      vfloat32m1_t x = __riscv_vle32_v_f32m1(__i, vl);
+      x = __exp_2xf32(__riscv_vfsub_vv_f32m1(x, max_chunk_v, vl), vl);
+      __riscv_vse32_v_f32m1(__o, __riscv_vfmul_vv_f32m1(x, rec_chunk_v, vl),
+                            vl);
+      __i += innerSize;
+      __o += innerSize;
+    }
+
+    // Bump stripmining pointers
+    _i += vl;
+    _o += vl;
+  }
+}
+
+// Scalar softmax along the last axis of a row-major rows x len tensor
+void softmax_lastaxis(const float *i, const float *o, uint64_t rows,
+                      uint64_t len) {
+  float *dstPtr = (float *)o;
+
+  for (uint64_t r = 0; r < rows; ++r) {
+    const float *src = i + r * len;
+    float *dst = dstPtr + r * len;
+
+    float max = src[0];
+    for (uint64_t k = 1; k < len; ++k)
+      max = fmax(max, src[k]);
+
+    float sum = 0.f;
+    for (uint64_t k = 0; k < len; ++k) {
+      dst[k] = exp(src[k] - max);
+      sum += dst[k];
+    }
+
+    for (uint64_t k = 0; k < len; ++k)
+      dst[k] /= sum;
+  }
+}
+
+// Online softmax along the last axis of a row-major rows x len tensor, e.g.,
+// the rows of an attention score matrix. Each lane keeps the running maximum
+// and sum of the elements it sees while stripmining on the row. The shorter
+// last strip leaves the tail lanes undisturbed. The lanes are merged by one
+// max and one sum reduction per row, before the normalization sweep.
+void softmax_vec_lastaxis(const float *i, const float *o, uint64_t rows,
+                          uint64_t len) {
+  for (uint64_t r = 0; r < rows; ++r) {
+    const float *src = i + r * len;
+    float *dst = (float *)o + r * len;
+
+    // The first strip is the longest one
+    size_t vl_row = __riscv_vsetvl_e32m1(len);
+    size_t vl = vl_row;
+
+    vfloat32m1_t max_v = __riscv_vle32_v_f32m1(src, vl);
+    vfloat32m1_t den_v = __riscv_vfmv_v_f_f32m1(1.0f, vl);
+
+    for (uint64_t k = vl; k < len; k += vl) {
+      vl = __riscv_vsetvl_e32m1(len - k);
+      vfloat32m1_t x = __riscv_vle32_v_f32m1(src + k, vl);
+
+      vfloat32m1_t new_max_v = __riscv_vfmax_vv_f32m1(max_v, x, vl);
+      vfloat32m1_t scale_v =
+          __exp_2xf32(__riscv_vfsub_vv_f32m1(max_v, new_max_v, vl), vl);
+      x = __exp_2xf32(__riscv_vfsub_vv_f32m1(x, new_max_v, vl), vl);
+      den_v = __riscv_vfmul_vv_f32m1_tu(den_v, den_v, scale_v, vl);
+      den_v = __riscv_vfadd_vv_f32m1_tu(den_v, den_v, x, vl);
+      max_v = __riscv_vmv_v_v_f32m1_tu(max_v, new_max_v, vl);
+    }
+
+    // Merge the lanes
+    vl = vl_row;
+    vfloat32m1_t red_v = __riscv_vfmv_s_f_f32m1(src[0], 1);
+    red_v = __riscv_vfredmax_vs_f32m1_f32m1(max_v, red_v, vl);
+    float max = __riscv_vfmv_f_s_f32m1_f32(red_v);
+
+    den_v = __riscv_vfmul_vv_f32m1(
+        den_v, __exp_2xf32(__riscv_vfsub_vf_f32m1(max_v, max, vl), vl), vl);
+    red_v = __riscv_vfmv_s_f_f32m1(0.0f, 1);
+    red_v = __riscv_vfredusum_vs_f32m1_f32m1(den_v, red_v, vl);
+    // A single division per row
+    float rec = 1.0f / __riscv_vfmv_f_s_f32m1_f32(red_v);
+
+    // Normalize
+    for (uint64_t k = 0; k < len; k += vl) {
+      vl = __riscv_vsetvl_e32m1(len - k);
+      vfloat32m1_t x = __riscv_vle32_v_f32m1(src + k, vl);
+      x = __exp_2xf32(__riscv_vfsub_vf_f32m1(x, max, vl), vl);
+      __riscv_vse32_v_f32m1(dst + k, __riscv_vfmul_vf_f32m1(x, rec, vl), vl);
+    }
+  }
+}
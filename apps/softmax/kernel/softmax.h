@@ -25,4 +25,13 @@ void softmax(const float *i, const float *o, const float *buf,
 void softmax_vec(const float *i, const float *o, uint64_t channels,
                  uint64_t innerSize);
 
+void softmax_vec_online(const float *i, const float *o, uint64_t channels,
+                        uint64_t innerSize);
+
+void softmax_lastaxis(const float *i, const float *o, uint64_t rows,
+                      uint64_t len);
+
+void softmax_vec_lastaxis(const float *i, const float *o, uint64_t rows,
+                          uint64_t len);
+
 #endif
@@ -50,6 +50,35 @@ extern float buf[] __attribute__((aligned(4 * NR_LANES)));
 extern float o_s[] __attribute__((aligned(4 * NR_LANES)));
 extern float o_v[] __attribute__((aligned(4 * NR_LANES)));
 
+// Compare the vector results against the scalar ones
+int check_results(const float *o_s, const float *o_v, uint64_t size) {
+  int error = 0;
+
+#ifdef PRINT_RESULTS
+  for (uint64_t k = 0; k < size; ++k) {
+    printf("%lu) Vector, Scalar: %x, %x\n", k, *((uint32_t *)&(o_v[k])),
+           *((uint32_t *)&(o_s[k])));
+  }
+#endif
+
+#ifdef CHECK
+  for (uint64_t k = 0; k < size; ++k) {
+#ifdef SANITY_CHECK
+    if (o_s[k] != o_v[k]) {
+#else
+    if (!similarity_check(o_s[k], o_v[k], THRESHOLD)) {
+#endif
+      error = 1;
+      printf("Error at index %d. %f != %f\n", k, o_v[k], o_s[k]);
+    }
+  }
+  if (!error)
+    printf("Check okay. No errors.\n");
+#endif
+
+  return error;
+}
+
 int main() {
   printf("\n");
   printf("=============\n");
@@ -79,27 +108,36 @@ int main() {
   runtime = get_timer();
   printf("The vector Softmax execution took %d cycles.\n", runtime);
 
-#ifdef PRINT_RESULTS
-  for (uint64_t k = 0; k < channels * innerSize; ++k) {
-    printf("%lu) Vector, Scalar: %x, %x\n", k, *((uint32_t *)&(o_v[k])),
-           *((uint32_t *)&(o_s[k])));
-  }
-#endif
+  error |= check_results(o_s, o_v, channels * innerSize);
 
-#ifdef CHECK
-  for (uint64_t k = 0; k < channels * innerSize; ++k) {
-#ifdef SANITY_CHECK
-    if (o_s[k] != o_v[k]) {
-#else
-    if (!similarity_check(o_s[k], o_v[k], THRESHOLD)) {
-#endif
-      error = 1;
-      printf("Error at index %d. %f != %f\n", k, o_v[k], o_s[k]);
-    }
-  }
-  if (!error)
-    printf("Check okay. No errors.\n");
-#endif
+  printf("Online vector Softmax...\n");
+  start_timer();
+  softmax_vec_online(i, o_v, channels, innerSize);
+  stop_timer();
+
+  runtime = get_timer();
+  printf("The online vector Softmax execution took %d cycles.\n", runtime);
+
+  error |= check_results(o_s, o_v, channels * innerSize);
+
+  // Same input, seen as a row-major channels x innerSize tensor
+  printf("Scalar last-axis Softmax...\n");
+  start_timer();
+  softmax_lastaxis(i, o_s, channels, innerSize);
+  stop_timer();
+
+  runtime = get_timer();
+  printf("The scalar last-axis Softmax execution took %d cycles.\n", runtime);
+
+  printf("Vector last-axis Softmax...\n");
+  start_timer();
+  softmax_vec_lastaxis(i, o_v, channels, innerSize);
+  stop_timer();
+
+  runtime = get_timer();
+  printf("The vector last-axis Softmax execution took %d cycles.\n", runtime);
+
+  error |= check_results(o_s, o_v, channels * innerSize);
 
   return error;
 }
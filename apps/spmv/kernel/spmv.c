@@ -123,6 +123,101 @@ void spmv_csr_idx32(int32_t N_ROW, int32_t *CSR_PROW, int32_t *CSR_INDEX,
   }
 }
 
+double spmv_dot_csr_idx32(int32_t N_ROW, int32_t *CSR_PROW, int32_t *CSR_INDEX,
+                          double *CSR_DATA, double *IN_VEC, double *OUT_VEC) {
+  size_t vl;
+  double dot;
+
+  // Clear the accumulator of the dot product
+  asm volatile("vsetvli %0, %1, e64, m2, ta, ma" : "=r"(vl) : "r"(SLICE_SIZE));
+  asm volatile("vmv.v.i v20, 0");
+  size_t vl_dot = vl;
+
+  for (int i = 0; i < N_ROW; ++i) {
+    int32_t len = CSR_PROW[i + 1] - CSR_PROW[i];
+    double *data = CSR_DATA + CSR_PROW[i];
+    int32_t *index = CSR_INDEX + CSR_PROW[i];
+    double in_i = IN_VEC[i];
+
+    asm volatile("vsetvli zero, %0, e64, m2, ta, ma" ::"r"(1));
+    asm volatile("vmv.v.i v16, 0");
+
+    // SpVV. The tails of the accumulator of the dot product are undisturbed
+    for (; len > 0; len -= vl) {
+      asm volatile("vsetvli %0, %1, e64, m2, tu, ma"
+                   : "=r"(vl)
+                   : "r"(MIN(len, SLICE_SIZE)));
+      asm volatile("vle64.v v4, (%0)" ::"r"(data));          // fetch entries
+      asm volatile("vle32.v v8, (%0)" ::"r"(index));         // fetch indices
+      asm volatile("vloxei32.v v0, (%0), v8" ::"r"(IN_VEC)); // load data
+      asm volatile("vfmul.vv v12, v4, v0");      // vector multiply
+      asm volatile("vfredusum.vs v16, v12, v16"); // reduction
+      asm volatile("vfmacc.vf v20, %0, v12" ::"f"(in_i)); // dot product
+      data = data + vl;
+      index = index + vl;
+    }
+
+    // Store the row from the vector register, without moving it to the core
+    asm volatile("vsetvli zero, %0, e64, m2, ta, ma" ::"r"(1));
+    asm volatile("vse64.v v16, (%0)" ::"r"(OUT_VEC + i));
+  }
+
+  // Reduce the dot product
+  asm volatile("vsetvli zero, %0, e64, m2, ta, ma" ::"r"(vl_dot));
+  asm volatile("vmv.s.x v16, zero");
+  asm volatile("vfredusum.vs v16, v20, v16");
+  asm volatile("vfmv.f.s %0, v16" : "=f"(dot));
+
+  return dot;
+}
+
+void spmv_sell_idx32(int32_t N_ROW, int32_t SLICE_H, int32_t *SELL_SLICE_PTR,
+                     int32_t *SELL_INDEX, double *SELL_DATA,
+                     int32_t *SELL_PERM, double *IN_VEC, double *OUT_VEC) {
+  size_t vl;
+  int32_t s = 0;
+  for (int32_t r0 = 0; r0 < N_ROW; r0 += SLICE_H, ++s) {
+    // Rows of the slice, which is padded to SLICE_H rows
+    int32_t h = MIN(SLICE_H, N_ROW - r0);
+    int32_t width = (SELL_SLICE_PTR[s + 1] - SELL_SLICE_PTR[s]) / SLICE_H;
+
+    // One vector element per row. Slices taller than the vector length are
+    // processed in chunks.
+    for (int32_t k = 0; k < h; k += vl) {
+      asm volatile("vsetvli %0, %1, e64, m4, ta, ma" : "=r"(vl) : "r"(h - k));
+      double *data = SELL_DATA + SELL_SLICE_PTR[s] + k;
+      int32_t *index = SELL_INDEX + SELL_SLICE_PTR[s] + k;
+
+      asm volatile("vmv.v.i v0,  0");
+
+      // Two columns of the slice at a time, with alternating registers
+      int32_t j = 0;
+      for (; j + 1 < width; j += 2) {
+        asm volatile("vle32.v v24, (%0)" ::"r"(index));         // fetch indices
+        asm volatile("vle64.v v8, (%0)" ::"r"(data));           // fetch entries
+        asm volatile("vloxei32.v v16, (%0), v24" ::"r"(IN_VEC)); // load data
+        asm volatile("vle32.v v26, (%0)" ::"r"(index + SLICE_H));
+        asm volatile("vle64.v v12, (%0)" ::"r"(data + SLICE_H));
+        asm volatile("vloxei32.v v20, (%0), v26" ::"r"(IN_VEC));
+        asm volatile("vfmacc.vv v0, v8, v16");
+        asm volatile("vfmacc.vv v0, v12, v20");
+        data += 2 * SLICE_H;
+        index += 2 * SLICE_H;
+      }
+      if (j < width) {
+        asm volatile("vle32.v v24, (%0)" ::"r"(index));
+        asm volatile("vle64.v v8, (%0)" ::"r"(data));
+        asm volatile("vloxei32.v v16, (%0), v24" ::"r"(IN_VEC));
+        asm volatile("vfmacc.vv v0, v8, v16");
+      }
+
+      // Store the results in the original rows
+      asm volatile("vle32.v v28, (%0)" ::"r"(SELL_PERM + r0 + k));
+      asm volatile("vsuxei32.v v0, (%0), v28" ::"r"(OUT_VEC));
+    }
+  }
+}
+
 int spmv_verify(int32_t N_ROW, int32_t *CSR_PROW, int32_t *CSR_INDEX,
                 double *CSR_DATA, double *IN_VEC, double *OUT_VEC) {
   for (int32_t i = 0; i < N_ROW; ++i) {
@@ -24,6 +24,21 @@
 void spmv_csr_idx32(int32_t N_ROW, int32_t *CSR_PROW, int32_t *CSR_INDEX,
                     double *CSR_DATA, double *IN_VEC, double *OUT_VEC);
 
+// OUT_VEC = A * IN_VEC, on a square CSR matrix, fused with the dot product
+// (OUT_VEC, IN_VEC), which is returned. The dot product is accumulated on the
+// products of the rows, and reduced once at the end.
+double spmv_dot_csr_idx32(int32_t N_ROW, int32_t *CSR_PROW, int32_t *CSR_INDEX,
+                          double *CSR_DATA, double *IN_VEC, double *OUT_VEC);
+
+// SpMV on a matrix in the SELL-C-sigma format: the rows are sorted by length
+// within windows of sigma rows, and grouped in slices of C (SLICE_H) rows. Each
+// slice is padded to its longest row and stored column by column, so that the
+// rows of a slice are processed in parallel, without reductions. SELL_PERM
+// holds the byte offset of the original row of each sorted row.
+void spmv_sell_idx32(int32_t N_ROW, int32_t SLICE_H, int32_t *SELL_SLICE_PTR,
+                     int32_t *SELL_INDEX, double *SELL_DATA,
+                     int32_t *SELL_PERM, double *IN_VEC, double *OUT_VEC);
+
 int spmv_verify(int32_t N_ROW, int32_t *CSR_PROW, int32_t *CSR_INDEX,
                 double *CSR_DATA, double *IN_VEC, double *OUT_VEC);
 
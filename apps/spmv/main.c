@@ -45,6 +45,18 @@ extern double CSR_IN_VECTOR[]
 extern double CSR_OUT_VECTOR[]
     __attribute__((aligned(4 * NR_LANES), section(".l2")));
 
+// Same matrix, in the SELL-C-sigma format
+extern uint64_t SELL_C;
+extern uint64_t SELL_NZ;
+extern int32_t SELL_SLICE_PTR[]
+    __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern int32_t SELL_INDEX[]
+    __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern double SELL_DATA[]
+    __attribute__((aligned(4 * NR_LANES), section(".l2")));
+extern int32_t SELL_PERM[]
+    __attribute__((aligned(4 * NR_LANES), section(".l2")));
+
 int main() {
   printf("\n");
   printf("==========\n");
@@ -68,7 +80,7 @@ int main() {
       "-------------------------------------------------------------------\n");
   printf("\n");
 
-  printf("calculating ... \n");
+  printf("calculating (CSR) ... \n");
   start_timer();
   spmv_csr_idx32(R, CSR_PROW, CSR_INDEX, CSR_DATA, CSR_IN_VECTOR,
                  CSR_OUT_VECTOR);
@@ -83,6 +95,38 @@ int main() {
   printf("The performance is %f FLOP/cycle (%f%% utilization) at %d lanes.\n",
          performance, utilization, NR_LANES);
 
+  printf("Verifying ...\n");
+  if (spmv_verify(R, CSR_PROW, CSR_INDEX, CSR_DATA, CSR_IN_VECTOR,
+                  CSR_OUT_VECTOR)) {
+    return 1;
+  } else {
+    printf("Passed.\n");
+  }
+
+  printf("\n");
+  printf("SELL-C-sigma format with C = %d: %d stored elements, %f padding\n",
+         SELL_C, SELL_NZ, ((double)(SELL_NZ - NZ)) / SELL_NZ);
+  printf("\n");
+
+  for (uint64_t i = 0; i < R; ++i)
+    CSR_OUT_VECTOR[i] = 0;
+
+  printf("calculating (SELL-C-sigma) ... \n");
+  start_timer();
+  spmv_sell_idx32(R, SELL_C, SELL_SLICE_PTR, SELL_INDEX, SELL_DATA, SELL_PERM,
+                  CSR_IN_VECTOR, CSR_OUT_VECTOR);
+  stop_timer();
+
+  // Metrics
+  int64_t runtime_sell = get_timer();
+  performance = 2.0 * NZ / runtime_sell;
+  utilization = 100 * performance / (2.0 * NR_LANES);
+
+  printf("The execution took %d cycles.\n", runtime_sell);
+  printf("The performance is %f FLOP/cycle (%f%% utilization) at %d lanes.\n",
+         performance, utilization, NR_LANES);
+  printf("Speedup over CSR: %f\n", ((double)runtime) / runtime_sell);
+
   printf("Verifying ...\n");
   if (spmv_verify(R, CSR_PROW, CSR_INDEX, CSR_DATA, CSR_IN_VECTOR,
                   CSR_OUT_VECTOR)) {
@@ -19,6 +19,14 @@
 
 
 # arg1: row, arg2: column, arg3: density
+# arg4 (optional): distribution of the row lengths
+#   uniform: the nonzeros are spread uniformly over the matrix (default)
+#   fixed: all the rows have the same length, as in FEM matrices
+#   powerlaw: few long rows and many short ones
+# arg5 (optional): height C of the slices of the SELL-C-sigma format. Tie it to
+#   the vector length, e.g., VLEN/16 elements (e64, LMUL=4). Default: 64
+# arg6 (optional): sorting window sigma of the SELL-C-sigma format, in rows.
+#   Default: 8 * C
 # default configuration:
 # # INT32 idx
 # # FP64  data
@@ -115,27 +123,115 @@ def randomCSR(num_row, num_col, density, element_byte):
 
   pass
 
+#generate random CSR format sparse matrix with a given distribution of the row
+#lengths, and as many nonzeros as randomCSR
+def randomCSR_dist(num_row, num_col, density, element_byte, dist):
+  non_zero = int(num_row * num_col * density)
+
+  if dist == 'fixed':
+    lengths = [non_zero // num_row + (1 if x < non_zero % num_row else 0) for x in range(num_row)]
+  else:
+    # Row r gets a share of the nonzeros proportional to 1/(r+1), up to a full row
+    weights = [1 / (x + 1) for x in range(num_row)]
+    lengths = [0] * num_row
+    left = non_zero
+    while left > 0:
+      open_rows = [x for x in range(num_row) if lengths[x] < num_col]
+      total = sum(weights[x] for x in open_rows)
+      added = 0
+      for x in open_rows:
+        n = min(num_col - lengths[x], int(left * weights[x] / total))
+        lengths[x] += n
+        added += n
+      # Hand out the remainder one by one
+      if added == 0:
+        for x in open_rows[:left]:
+          lengths[x] += 1
+          added += 1
+      left -= added
+    random.shuffle(lengths)
+
+  p_row = [0]
+  index_list = []
+  for x in range(num_row):
+    p_row.append(p_row[-1] + lengths[x])
+    index_list += sorted(random.sample(range(0, num_col*element_byte, element_byte), lengths[x]))
+
+  data_list = list(range(non_zero))
+  vector_list = [random.random() for x in range(num_col)]
+
+  return non_zero, p_row, index_list, data_list, vector_list
+
+#convert a CSR matrix in the SELL-C-sigma format
+def CSR2SELL(num_row, p_row, index_list, data_list, element_byte, slice_h, sigma):
+  lengths = [p_row[x+1] - p_row[x] for x in range(num_row)]
+
+  # Sort the rows by decreasing length within each window of sigma rows
+  perm = []
+  for w in range(0, num_row, sigma):
+    perm += sorted(range(w, min(w + sigma, num_row)), key=lambda x: -lengths[x])
+
+  # Pad each slice to its longest row and to slice_h rows, and store it column
+  # by column. The padding multiplies zero by the first element of the vector.
+  slice_ptr = [0]
+  sell_index = []
+  sell_data = []
+  for s in range(0, num_row, slice_h):
+    rows = perm[s:s+slice_h]
+    width = max(lengths[x] for x in rows)
+    for j in range(width):
+      for k in range(slice_h):
+        if k < len(rows) and j < lengths[rows[k]]:
+          sell_index.append(index_list[p_row[rows[k]] + j])
+          sell_data.append(data_list[p_row[rows[k]] + j])
+        else:
+          sell_index.append(0)
+          sell_data.append(0)
+    slice_ptr.append(len(sell_data))
+
+  # Byte offsets of the original rows
+  sell_perm = [x * element_byte for x in perm]
+
+  return slice_ptr, sell_index, sell_data, sell_perm
+
 ############
 ## SCRIPT ##
 ############
 
 
 
-if len(sys.argv) == 4:
+if len(sys.argv) >= 4 and len(sys.argv) <= 7:
   R = int(sys.argv[1])
   C = int(sys.argv[2])
   D = float(sys.argv[3])
+  dist = str(sys.argv[4]) if len(sys.argv) > 4 else 'uniform'
+  slice_h = int(sys.argv[5]) if len(sys.argv) > 5 else 64
+  sigma = int(sys.argv[6]) if len(sys.argv) > 6 else 8 * slice_h
 else:
-  print("Error. Give me one argument: the number of vector elements.")
+  print("Error. Give me three to six arguments: rows, columns, density,")
+  print("and optionally the distribution of the row lengths, C, and sigma.")
+  print("distribution in [uniform, fixed, powerlaw]")
   sys.exit()
 
+if dist not in ['uniform', 'fixed', 'powerlaw']:
+  sys.exit("Error. Unknown distribution of the row lengths: " + dist)
+
+# The formats are compared on the same matrix
+random.seed(0)
+
 data_type = np.float64
 idx_type = np.int32
 element_byte = 8
 idx_byte = 4
 
 #generate sparse matrix
-non_zero, p_row, index_list, data_list, vector_list = randomCSR(R, C, D, element_byte)
+if dist == 'uniform':
+  non_zero, p_row, index_list, data_list, vector_list = randomCSR(R, C, D, element_byte)
+else:
+  non_zero, p_row, index_list, data_list, vector_list = randomCSR_dist(R, C, D, element_byte, dist)
+
+#convert it to SELL-C-sigma
+slice_ptr, sell_index, sell_data, sell_perm = CSR2SELL(R, p_row, index_list, data_list, element_byte, slice_h, sigma)
 
 # Create the file
 print(".section .data,\"aw\",@progbits")
@@ -146,7 +242,13 @@ emit("CSR_PROW", np.array(p_row, dtype=idx_type), 'NR_LANES*4')
 emit("CSR_INDEX", np.array(index_list, dtype=idx_type), 'NR_LANES*4')
 emit("CSR_DATA", np.array(data_list, dtype=data_type), 'NR_LANES*4')
 emit("CSR_IN_VECTOR", np.array(vector_list, dtype=data_type), 'NR_LANES*4')
-emit("CSR_OUT_VECTOR", np.zeros([C], dtype=data_type), 'NR_LANES*4')
+emit("CSR_OUT_VECTOR", np.zeros([R], dtype=data_type), 'NR_LANES*4')
+emit("SELL_C", np.array(slice_h, dtype=np.uint64))
+emit("SELL_NZ", np.array(len(sell_data), dtype=np.uint64))
+emit("SELL_SLICE_PTR", np.array(slice_ptr, dtype=idx_type), 'NR_LANES*4')
+emit("SELL_INDEX", np.array(sell_index, dtype=idx_type), 'NR_LANES*4')
+emit("SELL_DATA", np.array(sell_data, dtype=data_type), 'NR_LANES*4')
+emit("SELL_PERM", np.array(sell_perm, dtype=idx_type), 'NR_LANES*4')
 
 
 # TSTEPS = 1
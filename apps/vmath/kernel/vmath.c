@@ -0,0 +1,56 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Array versions of the vector math functions, stripmined on len
+
+#include "vmath.h"
+
+#define VMATH_ARRAY(name, type, sew, lmul)                                     \
+  void vmath_##name##_f##sew##m##lmul(const type *x, type *y, size_t len) {    \
+    size_t vl;                                                                 \
+    for (; len > 0; len -= vl) {                                               \
+      vl = __riscv_vsetvl_e##sew##m##lmul(len);                                \
+      vfloat##sew##m##lmul##_t v;                                              \
+      v = __riscv_vle##sew##_v_f##sew##m##lmul(x, vl);                         \
+      v = vm_##name##_f##sew##m##lmul(v, vl);                                  \
+      __riscv_vse##sew##_v_f##sew##m##lmul(y, v, vl);                          \
+      x += vl;                                                                 \
+      y += vl;                                                                 \
+    }                                                                          \
+  }
+
+#define VMATH_ARRAY_ALL(type, sew, lmul)                                       \
+  VMATH_ARRAY(exp, type, sew, lmul)                                            \
+  VMATH_ARRAY(log, type, sew, lmul)                                            \
+  VMATH_ARRAY(sin, type, sew, lmul)                                            \
+  VMATH_ARRAY(cos, type, sew, lmul)                                            \
+  VMATH_ARRAY(tanh, type, sew, lmul)                                           \
+  VMATH_ARRAY(sigmoid, type, sew, lmul)
+
+VMATH_ARRAY_ALL(float, 32, 1)
+VMATH_ARRAY_ALL(float, 32, 2)
+VMATH_ARRAY_ALL(float, 32, 4)
+VMATH_ARRAY_ALL(float, 32, 8)
+VMATH_ARRAY_ALL(double, 64, 1)
+VMATH_ARRAY_ALL(double, 64, 2)
+VMATH_ARRAY_ALL(double, 64, 4)
+VMATH_ARRAY_ALL(double, 64, 8)
+#if defined(__riscv_zvfh)
+VMATH_ARRAY_ALL(_Float16, 16, 1)
+VMATH_ARRAY_ALL(_Float16, 16, 2)
+VMATH_ARRAY_ALL(_Float16, 16, 4)
+VMATH_ARRAY_ALL(_Float16, 16, 8)
+#endif
@@ -0,0 +1,268 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Vector math library: exp, log, sin, cos, tanh and sigmoid.
+//
+// Each function exists for every floating-point type and LMUL, both on vector
+// registers and on arrays:
+//
+//   vfloat32m4_t vm_exp_f32m4(vfloat32m4_t x, size_t vl);
+//   void vmath_exp_f32m4(const float *x, float *y, size_t len);
+//
+// The register versions are inlined in the caller. fp32 and fp64 are
+// available with LMUL = 1, 2, 4, 8. fp16 (with Zvfh) is computed in fp32, on
+// the widened register group, and rounded back. fp16 with LMUL = 8 processes
+// its two halves with LMUL = 4.
+
+#ifndef _VMATH_H_
+#define _VMATH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "riscv_vector.h"
+
+#define VM_PASTE_(a, b) a##b
+#define VM_PASTE(a, b) VM_PASTE_(a, b)
+
+// Intrinsics and function names for the type being stamped
+#define VM_F(op) VM_PASTE(__riscv_##op##_, VM_SFX)
+#define VM_I(op) VM_PASTE(__riscv_##op##_, VM_ISFX)
+#define VM_B(op) VM_PASTE(__riscv_##op##_, VM_BSFX)
+#define VM_FB(op) VM_PASTE(VM_F(op), VM_PASTE(_, VM_BSFX))
+#define VM_IB(op) VM_PASTE(VM_I(op), VM_PASTE(_, VM_BSFX))
+#define VM_F2I(v)                                                              \
+  VM_PASTE(VM_PASTE(__riscv_vreinterpret_v_, VM_SFX), VM_PASTE(_, VM_ISFX))(v)
+#define VM_I2F(v)                                                              \
+  VM_PASTE(VM_PASTE(__riscv_vreinterpret_v_, VM_ISFX), VM_PASTE(_, VM_SFX))(v)
+#define VM_MU(fn) VM_PASTE(fn, _mu)
+#define VM_FN(name) VM_PASTE(vm_##name##_, VM_SFX)
+#define VM_FN_(name) VM_PASTE(__vm_##name##_, VM_SFX)
+
+// fp32
+#define VM_SEW 32
+#define VM_ST float
+#define VM_IST int32_t
+
+#define VM_SFX f32m1
+#define VM_ISFX i32m1
+#define VM_BSFX b32
+#define VM_FT vfloat32m1_t
+#define VM_IT vint32m1_t
+#define VM_BT vbool32_t
+#include "vmath_impl.h"
+#undef VM_SFX
+#undef VM_ISFX
+#undef VM_BSFX
+#undef VM_FT
+#undef VM_IT
+#undef VM_BT
+
+#define VM_SFX f32m2
+#define VM_ISFX i32m2
+#define VM_BSFX b16
+#define VM_FT vfloat32m2_t
+#define VM_IT vint32m2_t
+#define VM_BT vbool16_t
+#include "vmath_impl.h"
+#undef VM_SFX
+#undef VM_ISFX
+#undef VM_BSFX
+#undef VM_FT
+#undef VM_IT
+#undef VM_BT
+
+#define VM_SFX f32m4
+#define VM_ISFX i32m4
+#define VM_BSFX b8
+#define VM_FT vfloat32m4_t
+#define VM_IT vint32m4_t
+#define VM_BT vbool8_t
+#include "vmath_impl.h"
+#undef VM_SFX
+#undef VM_ISFX
+#undef VM_BSFX
+#undef VM_FT
+#undef VM_IT
+#undef VM_BT
+
+#define VM_SFX f32m8
+#define VM_ISFX i32m8
+#define VM_BSFX b4
+#define VM_FT vfloat32m8_t
+#define VM_IT vint32m8_t
+#define VM_BT vbool4_t
+#include "vmath_impl.h"
+#undef VM_SFX
+#undef VM_ISFX
+#undef VM_BSFX
+#undef VM_FT
+#undef VM_IT
+#undef VM_BT
+
+#undef VM_SEW
+#undef VM_ST
+#undef VM_IST
+
+// fp64
+#define VM_SEW 64
+#define VM_ST double
+#define VM_IST int64_t
+
+#define VM_SFX f64m1
+#define VM_ISFX i64m1
+#define VM_BSFX b64
+#define VM_FT vfloat64m1_t
+#define VM_IT vint64m1_t
+#define VM_BT vbool64_t
+#include "vmath_impl.h"
+#undef VM_SFX
+#undef VM_ISFX
+#undef VM_BSFX
+#undef VM_FT
+#undef VM_IT
+#undef VM_BT
+
+#define VM_SFX f64m2
+#define VM_ISFX i64m2
+#define VM_BSFX b32
+#define VM_FT vfloat64m2_t
+#define VM_IT vint64m2_t
+#define VM_BT vbool32_t
+#include "vmath_impl.h"
+#undef VM_SFX
+#undef VM_ISFX
+#undef VM_BSFX
+#undef VM_FT
+#undef VM_IT
+#undef VM_BT
+
+#define VM_SFX f64m4
+#define VM_ISFX i64m4
+#define VM_BSFX b16
+#define VM_FT vfloat64m4_t
+#define VM_IT vint64m4_t
+#define VM_BT vbool16_t
+#include "vmath_impl.h"
+#undef VM_SFX
+#undef VM_ISFX
+#undef VM_BSFX
+#undef VM_FT
+#undef VM_IT
+#undef VM_BT
+
+#define VM_SFX f64m8
+#define VM_ISFX i64m8
+#define VM_BSFX b8
+#define VM_FT vfloat64m8_t
+#define VM_IT vint64m8_t
+#define VM_BT vbool8_t
+#include "vmath_impl.h"
+#undef VM_SFX
+#undef VM_ISFX
+#undef VM_BSFX
+#undef VM_FT
+#undef VM_IT
+#undef VM_BT
+
+#undef VM_SEW
+#undef VM_ST
+#undef VM_IST
+
+#undef VM_FN_
+#undef VM_FN
+#undef VM_MU
+#undef VM_I2F
+#undef VM_F2I
+#undef VM_IB
+#undef VM_FB
+#undef VM_B
+#undef VM_I
+#undef VM_F
+#undef VM_PASTE
+#undef VM_PASTE_
+
+// fp16, computed in fp32
+#if defined(__riscv_zvfh)
+#define VM_F16_WIDEN(name, lmul, wlmul)                                        \
+  static inline vfloat16m##lmul##_t vm_##name##_f16m##lmul(                    \
+      vfloat16m##lmul##_t x, size_t vl) {                                      \
+    vfloat32m##wlmul##_t y = __riscv_vfwcvt_f_f_v_f32m##wlmul(x, vl);          \
+    y = vm_##name##_f32m##wlmul(y, vl);                                        \
+    return __riscv_vfncvt_f_f_w_f16m##lmul(y, vl);                             \
+  }
+
+#define VM_F16_SPLIT(name)                                                     \
+  static inline vfloat16m8_t vm_##name##_f16m8(vfloat16m8_t x, size_t vl) {    \
+    size_t vl_half = __riscv_vsetvlmax_e16m4();                                \
+    vfloat16m4_t x0 = __riscv_vget_v_f16m8_f16m4(x, 0);                        \
+    vfloat16m4_t x1 = __riscv_vget_v_f16m8_f16m4(x, 1);                        \
+    if (vl <= vl_half)                                                         \
+      return __riscv_vset_v_f16m4_f16m8(x, 0, vm_##name##_f16m4(x0, vl));      \
+    x = __riscv_vset_v_f16m4_f16m8(x, 0, vm_##name##_f16m4(x0, vl_half));      \
+    return __riscv_vset_v_f16m4_f16m8(x, 1,                                    \
+                                      vm_##name##_f16m4(x1, vl - vl_half));    \
+  }
+
+#define VM_F16(name)                                                           \
+  VM_F16_WIDEN(name, 1, 2)                                                     \
+  VM_F16_WIDEN(name, 2, 4)                                                     \
+  VM_F16_WIDEN(name, 4, 8)                                                     \
+  VM_F16_SPLIT(name)
+
+VM_F16(exp)
+VM_F16(log)
+VM_F16(sin)
+VM_F16(cos)
+VM_F16(tanh)
+VM_F16(sigmoid)
+
+#undef VM_F16
+#undef VM_F16_SPLIT
+#undef VM_F16_WIDEN
+#endif
+
+// Array versions, in vmath.c
+#define VMATH_DECLARE(name, type, sfx)                                         \
+  void vmath_##name##_##sfx(const type *x, type *y, size_t len);
+
+#define VMATH_DECLARE_ALL(type, sfx)                                           \
+  VMATH_DECLARE(exp, type, sfx)                                                \
+  VMATH_DECLARE(log, type, sfx)                                                \
+  VMATH_DECLARE(sin, type, sfx)                                                \
+  VMATH_DECLARE(cos, type, sfx)                                                \
+  VMATH_DECLARE(tanh, type, sfx)                                               \
+  VMATH_DECLARE(sigmoid, type, sfx)
+
+VMATH_DECLARE_ALL(float, f32m1)
+VMATH_DECLARE_ALL(float, f32m2)
+VMATH_DECLARE_ALL(float, f32m4)
+VMATH_DECLARE_ALL(float, f32m8)
+VMATH_DECLARE_ALL(double, f64m1)
+VMATH_DECLARE_ALL(double, f64m2)
+VMATH_DECLARE_ALL(double, f64m4)
+VMATH_DECLARE_ALL(double, f64m8)
+#if defined(__riscv_zvfh)
+VMATH_DECLARE_ALL(_Float16, f16m1)
+VMATH_DECLARE_ALL(_Float16, f16m2)
+VMATH_DECLARE_ALL(_Float16, f16m4)
+VMATH_DECLARE_ALL(_Float16, f16m8)
+#endif
+
+#undef VMATH_DECLARE_ALL
+#undef VMATH_DECLARE
+
+#endif
@@ -0,0 +1,253 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Type-generic body of the vector math functions. This file has no include
+// guard: vmath.h includes it once per floating-point type and LMUL, after
+// defining the VM_* type macros. Do not include it directly.
+//
+// All the functions reduce the argument with a Cody-Waite scheme and evaluate
+// a polynomial with Horner's rule. The polynomials are truncated Taylor
+// series, with enough terms for the precision of VM_ST.
+
+#if VM_SEW == 32
+#define VM_MANT 23
+#define VM_BIAS 127
+#define VM_MANT_MASK 0x007fffff
+#else
+#define VM_MANT 52
+#define VM_BIAS 1023
+#define VM_MANT_MASK 0x000fffffffffffff
+#endif
+
+// Evaluate the polynomial with coefficients c (highest degree first) in z
+#define VM_HORNER(q, z, c)                                                     \
+  do {                                                                         \
+    q = VM_F(vfmv_v_f)(c[0], vl);                                              \
+    for (unsigned int k_ = 1; k_ < sizeof(c) / sizeof(c[0]); ++k_)             \
+      q = VM_F(vfmadd_vv)(q, z, VM_F(vfmv_v_f)(c[k_], vl), vl);                \
+  } while (0)
+
+// 2^n, for n within the normal exponent range
+static inline VM_FT VM_FN_(pow2i)(VM_IT n, size_t vl) {
+  n = VM_I(vadd_vx)(n, VM_BIAS, vl);
+  return VM_I2F(VM_I(vsll_vx)(n, VM_MANT, vl));
+}
+
+// exp(r) - 1, for |r| <= ln(2) / 2
+static inline VM_FT VM_FN_(expm1_poly)(VM_FT r, size_t vl) {
+#if VM_SEW == 32
+  static const VM_ST c[] = {1.0 / 5040, 1.0 / 720, 1.0 / 120,
+                            1.0 / 24,   1.0 / 6,   1.0 / 2};
+#else
+  static const VM_ST c[] = {
+      1.0 / 6227020800, 1.0 / 479001600, 1.0 / 39916800, 1.0 / 3628800,
+      1.0 / 362880,     1.0 / 40320,     1.0 / 5040,     1.0 / 720,
+      1.0 / 120,        1.0 / 24,        1.0 / 6,        1.0 / 2};
+#endif
+  VM_FT q;
+  VM_HORNER(q, r, c);
+  // r + r^2 * q
+  return VM_F(vfmacc_vv)(r, VM_F(vfmul_vv)(r, r, vl), q, vl);
+}
+
+// x = n * ln(2) + r, with |r| <= ln(2) / 2. Returns r, n is in nf.
+// ln(2) is split in a part exact on the bits of n, and a correction.
+static inline VM_FT VM_FN_(exp_reduce)(VM_FT x, VM_FT nf, size_t vl) {
+#if VM_SEW == 32
+  const VM_ST ln2_hi = 0.693359375, ln2_lo = -2.12194440e-4;
+#else
+  const VM_ST ln2_hi = 6.93147180369123816490e-01,
+              ln2_lo = 1.90821492927058770002e-10;
+#endif
+  x = VM_F(vfnmsac_vf)(x, ln2_hi, nf, vl);
+  return VM_F(vfnmsac_vf)(x, ln2_lo, nf, vl);
+}
+
+// exp(x). Results below the smallest normal number are flushed to zero.
+static inline VM_FT VM_FN(exp)(VM_FT x, size_t vl) {
+#if VM_SEW == 32
+  const VM_ST hi = 88.72283935546875, lo = -87.33654475;
+#else
+  const VM_ST hi = 709.782712893384, lo = -708.3964185322641;
+#endif
+  VM_FT xc = VM_F(vfmin_vf)(VM_F(vfmax_vf)(x, lo, vl), hi, vl);
+
+  VM_IT n = VM_I(vfcvt_x_f_v)(VM_F(vfmul_vf)(xc, 1.44269504088896341, vl), vl);
+  VM_FT r = VM_FN_(exp_reduce)(xc, VM_F(vfcvt_f_x_v)(n, vl), vl);
+  VM_FT y = VM_F(vfadd_vf)(VM_FN_(expm1_poly)(r, vl), 1.0, vl);
+
+  // Scale by 2^n in two steps, since 2^n can be out of range at the bounds
+  VM_IT n1 = VM_I(vsra_vx)(n, 1, vl);
+  VM_IT n2 = VM_I(vsub_vv)(n, n1, vl);
+  y = VM_F(vfmul_vv)(y, VM_FN_(pow2i)(n1, vl), vl);
+  y = VM_F(vfmul_vv)(y, VM_FN_(pow2i)(n2, vl), vl);
+
+  y = VM_F(vfmerge_vfm)(y, __builtin_inf(), VM_FB(vmfgt_vf)(x, hi, vl), vl);
+  y = VM_F(vfmerge_vfm)(y, 0.0, VM_FB(vmflt_vf)(x, lo, vl), vl);
+  return VM_F(vmerge_vvm)(y, x, VM_FB(vmfne_vv)(x, x, vl), vl);
+}
+
+// exp(x) - 1, for 0 <= x <= 64
+static inline VM_FT VM_FN_(expm1)(VM_FT x, size_t vl) {
+  VM_IT n = VM_I(vfcvt_x_f_v)(VM_F(vfmul_vf)(x, 1.44269504088896341, vl), vl);
+  VM_FT r = VM_FN_(exp_reduce)(x, VM_F(vfcvt_f_x_v)(n, vl), vl);
+  VM_FT s = VM_FN_(pow2i)(n, vl);
+  // 2^n * expm1(r) + (2^n - 1), exact for n = 0
+  return VM_F(vfmacc_vv)(VM_F(vfsub_vf)(s, 1.0, vl), s,
+                         VM_FN_(expm1_poly)(r, vl), vl);
+}
+
+// Natural logarithm. x = 2^e * m, with sqrt(2)/2 < m <= sqrt(2), and
+// log(m) = 2 * atanh(s), with s = (m - 1) / (m + 1).
+static inline VM_FT VM_FN(log)(VM_FT x, size_t vl) {
+#if VM_SEW == 32
+  const VM_ST min_normal = 1.17549435e-38, sub_scale = 16777216.0;
+  const int sub_exp = 24;
+  const VM_ST ln2_hi = 0.693359375, ln2_lo = -2.12194440e-4;
+  static const VM_ST c[] = {2.0 / 9, 2.0 / 7, 2.0 / 5, 2.0 / 3};
+#else
+  const VM_ST min_normal = 2.2250738585072014e-308,
+              sub_scale = 18014398509481984.0;
+  const int sub_exp = 54;
+  const VM_ST ln2_hi = 6.93147180369123816490e-01,
+              ln2_lo = 1.90821492927058770002e-10;
+  static const VM_ST c[] = {2.0 / 21, 2.0 / 19, 2.0 / 17, 2.0 / 15, 2.0 / 13,
+                            2.0 / 11, 2.0 / 9,  2.0 / 7,  2.0 / 5,  2.0 / 3};
+#endif
+  VM_BT nan_m = VM_B(vmor_mm)(VM_FB(vmfne_vv)(x, x, vl),
+                              VM_FB(vmflt_vf)(x, 0.0, vl), vl);
+  VM_BT zero_m = VM_FB(vmfeq_vf)(x, 0.0, vl);
+  VM_BT inf_m = VM_FB(vmfeq_vf)(x, __builtin_inf(), vl);
+
+  // Bring the subnormals in the normal range
+  VM_BT sub_m = VM_FB(vmflt_vf)(x, min_normal, vl);
+  VM_FT xs = VM_MU(VM_F(vfmul_vf))(sub_m, x, x, sub_scale, vl);
+
+  VM_IT bits = VM_F2I(xs);
+  VM_IT e = VM_I(vsub_vx)(VM_I(vsra_vx)(bits, VM_MANT, vl), VM_BIAS, vl);
+  e = VM_MU(VM_I(vsub_vx))(sub_m, e, e, sub_exp, vl);
+  bits = VM_I(vand_vx)(bits, VM_MANT_MASK, vl);
+  VM_FT m = VM_I2F(VM_I(vor_vx)(bits, (VM_IST)VM_BIAS << VM_MANT, vl));
+
+  VM_BT big_m = VM_FB(vmfgt_vf)(m, 1.41421356237309504880, vl);
+  m = VM_MU(VM_F(vfmul_vf))(big_m, m, m, 0.5, vl);
+  e = VM_MU(VM_I(vadd_vx))(big_m, e, e, 1, vl);
+
+  VM_FT s = VM_F(vfdiv_vv)(VM_F(vfsub_vf)(m, 1.0, vl),
+                           VM_F(vfadd_vf)(m, 1.0, vl), vl);
+  VM_FT z = VM_F(vfmul_vv)(s, s, vl);
+  VM_FT q;
+  VM_HORNER(q, z, c);
+  // 2s + s * z * q
+  VM_FT y = VM_F(vfmacc_vv)(VM_F(vfadd_vv)(s, s, vl), VM_F(vfmul_vv)(s, z, vl),
+                            q, vl);
+
+  // + e * ln(2)
+  VM_FT ef = VM_F(vfcvt_f_x_v)(e, vl);
+  y = VM_F(vfmacc_vf)(y, ln2_lo, ef, vl);
+  y = VM_F(vfmacc_vf)(y, ln2_hi, ef, vl);
+
+  y = VM_F(vfmerge_vfm)(y, -__builtin_inf(), zero_m, vl);
+  y = VM_F(vfmerge_vfm)(y, __builtin_inf(), inf_m, vl);
+  return VM_F(vfmerge_vfm)(y, __builtin_nan(""), nan_m, vl);
+}
+
+// sin(x + quadrant * pi/2). x = n * pi/2 + r, with |r| <= pi/4. pi/2 is split
+// in three parts. The error stays within a few ULPs for |x| up to about 1e3
+// in fp32, and 1e5 in fp64.
+static inline VM_FT VM_FN_(sin_quadrant)(VM_FT x, unsigned int quadrant,
+                                         size_t vl) {
+#if VM_SEW == 32
+  const VM_ST pio2_1 = 1.5703125, pio2_2 = 4.837512969970703125e-4,
+              pio2_3 = 7.54978995489188216e-8;
+  static const VM_ST cs[] = {-1.0 / 39916800, 1.0 / 362880, -1.0 / 5040,
+                             1.0 / 120, -1.0 / 6};
+  static const VM_ST cc[] = {-1.0 / 3628800, 1.0 / 40320, -1.0 / 720,
+                             1.0 / 24};
+#else
+  const VM_ST pio2_1 = 1.57079632673412561417e+00,
+              pio2_2 = 6.07710050630396597660e-11,
+              pio2_3 = 2.02226624871116645580e-21;
+  static const VM_ST cs[] = {
+      -1.0 / 121645100408832000.0, 1.0 / 355687428096000.0,
+      -1.0 / 1307674368000.0,      1.0 / 6227020800.0,
+      -1.0 / 39916800,             1.0 / 362880,
+      -1.0 / 5040,                 1.0 / 120,
+      -1.0 / 6};
+  static const VM_ST cc[] = {
+      -1.0 / 6402373705728000.0, 1.0 / 20922789888000.0, -1.0 / 87178291200.0,
+      1.0 / 479001600,           -1.0 / 3628800,         1.0 / 40320,
+      -1.0 / 720,                1.0 / 24};
+#endif
+  VM_FT xn = VM_F(vfmul_vf)(x, 0.63661977236758134308, vl);
+  VM_IT n = VM_I(vfcvt_x_f_v)(xn, vl);
+  VM_FT nf = VM_F(vfcvt_f_x_v)(n, vl);
+  VM_FT r = VM_F(vfnmsac_vf)(x, pio2_1, nf, vl);
+  r = VM_F(vfnmsac_vf)(r, pio2_2, nf, vl);
+  r = VM_F(vfnmsac_vf)(r, pio2_3, nf, vl);
+  VM_FT z = VM_F(vfmul_vv)(r, r, vl);
+
+  // sin(r) = r + r * z * q
+  VM_FT q;
+  VM_HORNER(q, z, cs);
+  VM_FT s = VM_F(vfmacc_vv)(r, VM_F(vfmul_vv)(r, z, vl), q, vl);
+
+  // cos(r) = 1 - z / 2 + z^2 * q
+  VM_HORNER(q, z, cc);
+  VM_FT c = VM_F(vfnmsac_vf)(VM_F(vfmv_v_f)(1.0, vl), 0.5, z, vl);
+  c = VM_F(vfmacc_vv)(c, VM_F(vfmul_vv)(z, z, vl), q, vl);
+
+  // Odd quadrants take the cosine, the last two ones flip the sign
+  n = VM_I(vadd_vx)(n, quadrant, vl);
+  VM_BT odd_m = VM_IB(vmsne_vx)(VM_I(vand_vx)(n, 1, vl), 0, vl);
+  VM_FT y = VM_F(vmerge_vvm)(s, c, odd_m, vl);
+  VM_IT sign = VM_I(vsll_vx)(VM_I(vand_vx)(n, 2, vl), VM_SEW - 2, vl);
+  return VM_I2F(VM_I(vxor_vv)(VM_F2I(y), sign, vl));
+}
+
+static inline VM_FT VM_FN(sin)(VM_FT x, size_t vl) {
+  return VM_FN_(sin_quadrant)(x, 0, vl);
+}
+
+static inline VM_FT VM_FN(cos)(VM_FT x, size_t vl) {
+  return VM_FN_(sin_quadrant)(x, 1, vl);
+}
+
+// tanh(|x|) = expm1(2|x|) / (expm1(2|x|) + 2), which is 1 in VM_ST precision
+// above tanh_sat
+static inline VM_FT VM_FN(tanh)(VM_FT x, size_t vl) {
+#if VM_SEW == 32
+  const VM_ST tanh_sat = 9.1;
+#else
+  const VM_ST tanh_sat = 19.1;
+#endif
+  VM_FT a = VM_F(vfmin_vf)(VM_F(vfabs_v)(x, vl), tanh_sat, vl);
+  VM_FT em = VM_FN_(expm1)(VM_F(vfadd_vv)(a, a, vl), vl);
+  VM_FT y = VM_F(vfdiv_vv)(em, VM_F(vfadd_vf)(em, 2.0, vl), vl);
+  y = VM_F(vfsgnj_vv)(y, x, vl);
+  return VM_F(vmerge_vvm)(y, x, VM_FB(vmfne_vv)(x, x, vl), vl);
+}
+
+// 1 / (1 + exp(-x))
+static inline VM_FT VM_FN(sigmoid)(VM_FT x, size_t vl) {
+  VM_FT e = VM_FN(exp)(VM_F(vfneg_v)(x, vl), vl);
+  return VM_F(vfrdiv_vf)(VM_F(vfadd_vf)(e, 1.0, vl), 1.0, vl);
+}
+
+#undef VM_HORNER
+#undef VM_MANT
+#undef VM_BIAS
+#undef VM_MANT_MASK
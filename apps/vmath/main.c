@@ -0,0 +1,197 @@
+// Copyright 2024 ETH Zurich and University of Bologna.
+//
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Accuracy and throughput of the vector math library. Every function runs on
+// N elements of its domain, for every data type and LMUL. The results are
+// compared with libm, and the maximum error is reported in ULPs, next to the
+// cycles per element.
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel/vmath.h"
+#include "runtime.h"
+#include "util.h"
+
+#ifdef SPIKE
+#include <stdio.h>
+#elif defined ARA_LINUX
+#include <stdio.h>
+#else
+#include "printf.h"
+#endif
+
+// Maximum error allowed, in ULPs
+#ifndef MAX_ULP
+#define MAX_ULP 4
+#endif
+
+extern uint64_t N;
+extern double u[] __attribute__((aligned(4 * NR_LANES)));
+extern double x_buf[] __attribute__((aligned(4 * NR_LANES)));
+extern double y_buf[] __attribute__((aligned(4 * NR_LANES)));
+extern double ref_buf[] __attribute__((aligned(4 * NR_LANES)));
+
+static double sigmoid(double x) { return 1.0 / (1.0 + exp(-x)); }
+
+typedef struct {
+  const char *name;
+  // libm reference
+  double (*ref)(double);
+  // Domain for fp64, fp32, fp16. With log_domain, the inputs are 2^[lo, hi).
+  double lo[3];
+  double hi[3];
+  int log_domain;
+  // LMUL = 1, 2, 4, 8
+  void (*f64[4])(const double *, double *, size_t);
+  void (*f32[4])(const float *, float *, size_t);
+#if defined(__riscv_zvfh)
+  void (*f16[4])(const _Float16 *, _Float16 *, size_t);
+#endif
+} vmath_test_t;
+
+#if defined(__riscv_zvfh)
+#define VMATH_F16_FNS(name)                                                    \
+  , {vmath_##name##_f16m1, vmath_##name##_f16m2, vmath_##name##_f16m4,         \
+     vmath_##name##_f16m8}
+#else
+#define VMATH_F16_FNS(name)
+#endif
+
+#define VMATH_FNS(name)                                                        \
+  {vmath_##name##_f64m1, vmath_##name##_f64m2, vmath_##name##_f64m4,           \
+   vmath_##name##_f64m8},                                                      \
+      {vmath_##name##_f32m1, vmath_##name##_f32m2, vmath_##name##_f32m4,       \
+       vmath_##name##_f32m8} VMATH_F16_FNS(name)
+
+static const vmath_test_t tests[] = {
+    {"exp", exp, {-708, -87, -9.5}, {709.5, 88.5, 11}, 0, VMATH_FNS(exp)},
+    {"log", log, {-1000, -126, -14}, {1000, 127, 15}, 1, VMATH_FNS(log)},
+    {"sin", sin, {-1000, -100, -10}, {1000, 100, 10}, 0, VMATH_FNS(sin)},
+    {"cos", cos, {-1000, -100, -10}, {1000, 100, 10}, 0, VMATH_FNS(cos)},
+    {"tanh", tanh, {-20, -10, -5}, {20, 10, 5}, 0, VMATH_FNS(tanh)},
+    {"sigmoid", sigmoid, {-700, -80, -9.5}, {700, 80, 9.5}, 0,
+     VMATH_FNS(sigmoid)},
+};
+
+// Distance in ULPs. The floating-point numbers are mapped on integers that
+// keep their order, so that the distance is also valid across the exponents.
+static uint64_t ulp_distance(int64_t a, int64_t b) {
+  return a > b ? a - b : b - a;
+}
+
+static uint64_t ulp_f64(double a, double b) {
+  if (isnan(a) || isnan(b))
+    return (isnan(a) && isnan(b)) ? 0 : UINT64_MAX;
+  int64_t ia, ib;
+  memcpy(&ia, &a, sizeof(a));
+  memcpy(&ib, &b, sizeof(b));
+  return ulp_distance(ia < 0 ? INT64_MIN - ia : ia,
+                      ib < 0 ? INT64_MIN - ib : ib);
+}
+
+static uint64_t ulp_f32(float a, float b) {
+  if (isnan(a) || isnan(b))
+    return (isnan(a) && isnan(b)) ? 0 : UINT64_MAX;
+  int32_t ia, ib;
+  memcpy(&ia, &a, sizeof(a));
+  memcpy(&ib, &b, sizeof(b));
+  return ulp_distance(ia < 0 ? INT32_MIN - (int64_t)ia : ia,
+                      ib < 0 ? INT32_MIN - (int64_t)ib : ib);
+}
+
+#if defined(__riscv_zvfh)
+static uint64_t ulp_f16(_Float16 a, _Float16 b) {
+  if (a != a || b != b)
+    return (a != a && b != b) ? 0 : UINT64_MAX;
+  int16_t ia, ib;
+  memcpy(&ia, &a, sizeof(a));
+  memcpy(&ib, &b, sizeof(b));
+  return ulp_distance(ia < 0 ? INT16_MIN - (int64_t)ia : ia,
+                      ib < 0 ? INT16_MIN - (int64_t)ib : ib);
+}
+#endif
+
+// Run one function on one data type, for every LMUL
+#define VMATH_TEST(type, sfx, idx)                                             \
+  static int test_##sfx(const vmath_test_t *t) {                               \
+    type *x = (type *)x_buf;                                                   \
+    type *y = (type *)y_buf;                                                   \
+    type *ref = (type *)ref_buf;                                               \
+    int error = 0;                                                             \
+                                                                               \
+    for (uint64_t k = 0; k < N; ++k) {                                         \
+      double v = t->lo[idx] + u[k] * (t->hi[idx] - t->lo[idx]);                \
+      x[k] = (type)(t->log_domain ? exp2(v) : v);                              \
+      ref[k] = (type)t->ref((double)x[k]);                                     \
+    }                                                                          \
+                                                                               \
+    for (int l = 0; l < 4; ++l) {                                              \
+      start_timer();                                                           \
+      t->sfx[l](x, y, N);                                                      \
+      stop_timer();                                                            \
+      int64_t runtime = get_timer();                                           \
+                                                                               \
+      uint64_t max_ulp = 0;                                                    \
+      for (uint64_t k = 0; k < N; ++k) {                                       \
+        uint64_t d = ulp_##sfx(y[k], ref[k]);                                  \
+        if (d > max_ulp)                                                       \
+          max_ulp = d;                                                         \
+      }                                                                        \
+      if (max_ulp > MAX_ULP)                                                   \
+        error = 1;                                                             \
+                                                                               \
+      printf("%-8s %-4s m%d %10lu %14f\n", t->name, #sfx, 1 << l, max_ulp,     \
+             (float)runtime / N);                                              \
+    }                                                                          \
+    return error;                                                              \
+  }
+
+VMATH_TEST(double, f64, 0)
+VMATH_TEST(float, f32, 1)
+#if defined(__riscv_zvfh)
+VMATH_TEST(_Float16, f16, 2)
+#endif
+
+int main() {
+  printf("\n");
+  printf("===========\n");
+  printf("=  VMATH  =\n");
+  printf("===========\n");
+  printf("\n");
+  printf("\n");
+
+  int error = 0;
+
+  printf("Elements per function: %lu\n\n", N);
+  printf("function type LMUL  max-ULP  cycles/element\n");
+
+  for (unsigned int i = 0; i < sizeof(tests) / sizeof(tests[0]); ++i) {
+    error |= test_f64(&tests[i]);
+    error |= test_f32(&tests[i]);
+#if defined(__riscv_zvfh)
+    error |= test_f16(&tests[i]);
+#endif
+  }
+
+  if (error)
+    printf("\nError: some results are more than %d ULPs off.\n", MAX_ULP);
+  else
+    printf("\nTest result: PASS. No errors found.\n");
+
+  return error;
+}
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+# Copyright 2024 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# arg1: number of elements per function
+#
+# main.c maps the samples in [0, 1) on the domain of each function and data
+# type, and computes the reference results with libm.
+
+import numpy as np
+import sys
+
+def emit(name, array, alignment='8'):
+  print(".global %s" % name)
+  print(".balign " + alignment)
+  print("%s:" % name)
+  bs = array.tobytes()
+  for i in range(0, len(bs), 4):
+    s = ""
+    for n in range(4):
+      s += "%02x" % bs[i+3-n]
+    print("    .word 0x%s" % s)
+
+############
+## SCRIPT ##
+############
+
+if len(sys.argv) == 2:
+  N = int(sys.argv[1])
+else:
+  print("Error. Give me one argument: the number of elements per function.")
+  sys.exit()
+
+# Samples
+u = np.random.rand(N).astype(np.float64)
+
+# Input, output, and reference buffers, for the largest data type
+x_buf = np.zeros(N, dtype=np.float64)
+y_buf = np.zeros(N, dtype=np.float64)
+ref_buf = np.zeros(N, dtype=np.float64)
+
+# Create the file
+print(".section .data,\"aw\",@progbits")
+emit("N", np.array(N, dtype=np.uint64))
+emit("u", u, 'NR_LANES*4')
+emit("x_buf", x_buf, 'NR_LANES*4')
+emit("y_buf", y_buf, 'NR_LANES*4')
+emit("ref_buf", ref_buf, 'NR_LANES*4')
@@ -23,3 +23,17 @@ nr_lanes ?= 4
 # Length of each vector register (in bits)
 # Constraints: VLEN > 128
 vlen ?= 4096
+
+# Size of the main memory (in bytes)
+# Constraints: power of two, at most 0x40000000 (1 GiB)
+dram_size ?= 0x02000000
+
+# Number of vector instructions in flight
+# Constraints: 2, 4, or 8
+nr_vinsn ?= 8
+
+# Depth of the instruction queues of the MFPU, of the load unit, and of the slide unit
+# Constraints: 2 or 4
+mfpu_insn_queue_depth ?= 4
+vldu_insn_queue_depth ?= 4
+sldu_insn_queue_depth ?= 2
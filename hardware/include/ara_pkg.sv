@@ -19,7 +19,12 @@ package ara_pkg;
   localparam int unsigned ELENB = ELEN / 8;
 
   // Number of vector instructions that can run in parallel.
+  // Set by nr_vinsn in the configuration. Constraints: 2, 4, or 8.
+`ifdef NR_VINSN
+  localparam int unsigned NrVInsn = `NR_VINSN;
+`else
   localparam int unsigned NrVInsn = 8;
+`endif
 
   // Maximum number of lanes that Ara can support.
   localparam int unsigned MaxNrLanes = 16;
@@ -99,19 +104,42 @@ package ara_pkg;
   // Define the maximum FPU latency
   localparam int unsigned LatFMax = LatFCompEW64;
 
-  // Define the maximum instruction queue depth
-  localparam MaxVInsnQueueDepth = 4;
   // FUs instruction queue depth.
+  // The depths of the MFPU, load unit, and slide unit queues are set by mfpu_insn_queue_depth,
+  // vldu_insn_queue_depth, and sldu_insn_queue_depth in the configuration.
+  // Constraints: 2 or 4.
+`ifdef MFPU_INSN_QUEUE_DEPTH
+  localparam int unsigned MfpuInsnQueueDepth = `MFPU_INSN_QUEUE_DEPTH;
+`else
   localparam int unsigned MfpuInsnQueueDepth = 4;
+`endif
   localparam int unsigned ValuInsnQueueDepth = 4;
+`ifdef VLDU_INSN_QUEUE_DEPTH
+  localparam int unsigned VlduInsnQueueDepth = `VLDU_INSN_QUEUE_DEPTH;
+`else
   localparam int unsigned VlduInsnQueueDepth = 4;
+`endif
   localparam int unsigned VstuInsnQueueDepth = 4;
   localparam int unsigned VaddrgenInsnQueueDepth = 4;
+`ifdef SLDU_INSN_QUEUE_DEPTH
+  localparam int unsigned SlduInsnQueueDepth = `SLDU_INSN_QUEUE_DEPTH;
+`else
   localparam int unsigned SlduInsnQueueDepth = 2;
+`endif
   localparam int unsigned NoneInsnQueueDepth = 1;
   // Ara supports MaskuInsnQueueDepth = 1 only.
   localparam int unsigned MaskuInsnQueueDepth = 1;
 
+  function automatic int unsigned max_depth(int unsigned a, int unsigned b);
+    return a > b ? a : b;
+  endfunction
+
+  // Define the maximum instruction queue depth, among the queues tracked by the main sequencer
+  localparam int unsigned MaxVInsnQueueDepth = max_depth(
+    max_depth(max_depth(ValuInsnQueueDepth, MfpuInsnQueueDepth), max_depth(SlduInsnQueueDepth,
+      MaskuInsnQueueDepth)), max_depth(max_depth(VlduInsnQueueDepth, VstuInsnQueueDepth),
+      NoneInsnQueueDepth));
+
   ///////////////////
   //  Definitions  //
   ///////////////////
@@ -375,6 +403,23 @@ typedef struct packed {
     OffsetLoad, OffsetStore, OffsetMask, OffsetSlide
   } vfu_offset_e;
 
+  //////////////////////////
+  //  Performance events  //
+  //////////////////////////
+
+  // Events counted by the performance counters of the SoC control registers.
+  // The first NrVFUs-1 events count, for each VFU (in the vfu_e order), the
+  // cycles with a vector instruction in flight. The next NrVFUs-1 events count
+  // the cycles in which such an instruction waits for its operands (for the
+  // load unit, for the memory). The last one counts the cycles with a VRF bank
+  // conflict in any of the lanes.
+  typedef enum int unsigned {
+    PerfAluBusy, PerfMFpuBusy, PerfSlduBusy, PerfMaskuBusy, PerfVlduBusy, PerfVstuBusy,
+    PerfAluStarved, PerfMFpuStarved, PerfSlduStarved, PerfMaskuStarved, PerfVlduStarved,
+    PerfVstuStarved, PerfVrfBankConflict
+  } perf_event_e;
+  localparam int unsigned NrPerfEvents = PerfVrfBankConflict + 1;
+
   /* The VRF data is stored into the lanes in a shuffled way, similar to how it was done
    * in version 0.9 of the RISC-V Vector Specification, when SLEN < VLEN. In fact, VRF
    * data is organized in lanes as in section 4.3 of the RVV Specification v0.9, with
@@ -927,6 +972,14 @@ typedef struct packed {
   // Each lane has eight VRF banks
   localparam int unsigned NrVRFBanksPerLane = 8;
 
+  // Forward the results that the ALU, the MFPU, and the load unit write to the VRF directly to the
+  // operand queues of the instructions that depend on them (see operand_requester.sv).
+`ifdef OPERAND_FORWARDING
+  localparam bit OperandForwarding = 1'b1;
+`else
+  localparam bit OperandForwarding = 1'b0;
+`endif
+
   // Find the starting address (in bytes) of a vector register chunk of vid
   function automatic logic [63:0] vaddr(logic [4:0] vid, int NrLanes, int vlen);
     int vlenb = vlen / 8;
@@ -999,6 +1052,25 @@ typedef struct packed {
     logic is_exception;
   } addrgen_axi_req_t;
 
+  // Coalesce the memory accesses of strided and indexed operations. Strided accesses with a
+  // stride equal to the element width become unit-strided bursts, and runs of contiguous
+  // elements of indexed loads are requested with AXI bursts instead of one request each.
+`ifdef VLSU_COALESCING
+  localparam bit VlsuCoalescing = 1'b1;
+`else
+  localparam bit VlsuCoalescing = 1'b0;
+`endif
+
+  // Next-stripe prefetcher of the unit-strided loads (see vlsu_prefetcher.sv), with the number
+  // of streams it tracks and the size of the buffer of each stream [AXI words].
+`ifdef VLSU_PREFETCH
+  localparam bit VlsuPrefetch = 1'b1;
+`else
+  localparam bit VlsuPrefetch = 1'b0;
+`endif
+  localparam int unsigned VlsuPrefetchStreams = 2;
+  localparam int unsigned VlsuPrefetchBeats   = 32;
+
   //////////////////////////
   // VRGATHER / VCOMPRESS //
   //////////////////////////
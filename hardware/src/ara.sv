@@ -59,7 +59,9 @@ module ara import ara_pkg::*; #(
     output acc_to_cva6_t      acc_resp_o,
     // AXI interface
     output axi_req_t          axi_req_o,
-    input  axi_resp_t         axi_resp_i
+    input  axi_resp_t         axi_resp_i,
+    // Performance events (see ara_pkg::perf_event_e)
+    output logic [NrPerfEvents-1:0] perf_events_o
   );
 
   `include "common_cells/registers.svh"
@@ -272,6 +274,9 @@ module ara import ara_pkg::*; #(
   elen_t     result_scalar;
   logic      result_scalar_valid;
 
+  // Performance events
+  logic [NrVFUs-1:0] vfu_busy;
+
   ara_sequencer #(
     .NrLanes    (NrLanes   ),
     .VLEN       (VLEN      ),
@@ -309,7 +314,9 @@ module ara import ara_pkg::*; #(
     .addrgen_exception_i   (addrgen_exception        ),
     .addrgen_exception_vstart_i(addrgen_exception_vstart),
     .addrgen_fof_exception_i(addrgen_fof_exception),
-    .lsu_current_burst_exception_i(lsu_current_burst_exception)
+    .lsu_current_burst_exception_i(lsu_current_burst_exception),
+    // Performance events
+    .vfu_busy_o            (vfu_busy                 )
   );
 
   // Scalar move support
@@ -336,6 +343,10 @@ module ara import ara_pkg::*; #(
   sldu_mux_e                                   sldu_mux_sel;
   logic                                        addrgen_operand_ready;
   logic      [NrLanes-1:0]                     sldu_red_valid;
+  // Performance events
+  logic      [NrLanes-1:0]                     alu_operand_empty;
+  logic      [NrLanes-1:0]                     mfpu_operand_empty;
+  logic      [NrLanes-1:0]                     vrf_bank_conflict;
 
   // Results
   // Load Unit
@@ -444,7 +455,11 @@ module ara import ara_pkg::*; #(
       .masku_vrgat_req_i               (masku_vrgat_req                     ),
       .mask_i                          (mask[lane]                          ),
       .mask_valid_i                    (mask_valid[lane] & mask_valid_lane  ),
-      .mask_ready_o                    (lane_mask_ready[lane]               )
+      .mask_ready_o                    (lane_mask_ready[lane]               ),
+      // Performance events
+      .alu_operand_empty_o             (alu_operand_empty[lane]             ),
+      .mfpu_operand_empty_o            (mfpu_operand_empty[lane]            ),
+      .vrf_bank_conflict_o             (vrf_bank_conflict[lane]             )
     );
   end: gen_lanes
 
@@ -657,6 +672,37 @@ module ara import ara_pkg::*; #(
     .sldu_mask_ready_i       (sldu_mask_ready                 )
   );
 
+  //////////////////////////
+  //  Performance events  //
+  //////////////////////////
+
+  // A VFU with a vector instruction in flight is starved if none of the lanes
+  // provides it with an operand. The load unit waits for the memory instead.
+  logic [NrPerfEvents-1:0] perf_events_d;
+
+  always_comb begin: p_perf_events
+    perf_events_d = '0;
+
+    perf_events_d[PerfAluBusy]   = vfu_busy[VFU_Alu];
+    perf_events_d[PerfMFpuBusy]  = vfu_busy[VFU_MFpu];
+    perf_events_d[PerfSlduBusy]  = vfu_busy[VFU_SlideUnit];
+    perf_events_d[PerfMaskuBusy] = vfu_busy[VFU_MaskUnit];
+    perf_events_d[PerfVlduBusy]  = vfu_busy[VFU_LoadUnit];
+    perf_events_d[PerfVstuBusy]  = vfu_busy[VFU_StoreUnit];
+
+    perf_events_d[PerfAluStarved]   = vfu_busy[VFU_Alu] && &alu_operand_empty;
+    perf_events_d[PerfMFpuStarved]  = vfu_busy[VFU_MFpu] && &mfpu_operand_empty;
+    perf_events_d[PerfSlduStarved]  = vfu_busy[VFU_SlideUnit] && !(|sldu_operand_valid);
+    perf_events_d[PerfMaskuStarved] = vfu_busy[VFU_MaskUnit] && !(|masku_operand_valid);
+    perf_events_d[PerfVlduStarved]  = vfu_busy[VFU_LoadUnit] && !axi_resp_i.r_valid;
+    perf_events_d[PerfVstuStarved]  = vfu_busy[VFU_StoreUnit] && !(|stu_operand_valid);
+
+    perf_events_d[PerfVrfBankConflict] = |vrf_bank_conflict;
+  end: p_perf_events
+
+  // Cut the paths towards the counters
+  `FF(perf_events_o, perf_events_d, '0, clk_i, rst_ni);
+
   //////////////////
   //  Assertions  //
   //////////////////
@@ -681,4 +727,14 @@ module ara import ara_pkg::*; #(
   if (VLEN != 2**$clog2(VLEN))
     $error("[ara] The vector length must be a power of two.");
 
+  // Larger values than the defaults have not been verified
+  if (NrVInsn < 2 || NrVInsn > 8 || NrVInsn != 2**$clog2(NrVInsn))
+    $error("[ara] The number of vector instructions in flight must be 2, 4, or 8.");
+
+  // The instruction queues of the units wrap their pointers around
+  if (MfpuInsnQueueDepth < 2 || MfpuInsnQueueDepth > 4 || MfpuInsnQueueDepth != 2**$clog2(MfpuInsnQueueDepth) ||
+      VlduInsnQueueDepth < 2 || VlduInsnQueueDepth > 4 || VlduInsnQueueDepth != 2**$clog2(VlduInsnQueueDepth) ||
+      SlduInsnQueueDepth < 2 || SlduInsnQueueDepth > 4 || SlduInsnQueueDepth != 2**$clog2(SlduInsnQueueDepth))
+    $error("[ara] The depths of the instruction queues must be 2 or 4.");
+
 endmodule : ara
@@ -51,7 +51,9 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
     input  vlen_t                           addrgen_exception_vstart_i,
     input  logic                            addrgen_fof_exception_i,
     // Interface with the store unit
-    input  logic                            lsu_current_burst_exception_i
+    input  logic                            lsu_current_burst_exception_i,
+    // Performance events: a VFU has a vector instruction in flight
+    output logic               [NrVFUs-1:0] vfu_busy_o
   );
 
   `include "common_cells/registers.svh"
@@ -117,6 +119,28 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
   end
   assign stall_lanes_desynch = |stall_lanes_desynch_vec;
 
+  //////////////////////////
+  //  Performance events  //
+  //////////////////////////
+
+  // The lanes host both the ALU and the MFPU: remember which one of them
+  // executes each vector instruction.
+  vfu_e [NrVInsn-1:0] vinsn_vfu_d, vinsn_vfu_q;
+
+  always_comb begin: p_vfu_busy
+    vfu_busy_o = '0;
+    // As for the instruction counters, lane 0 is representative of all the lanes
+    for (int unsigned v = 0; v < NrVInsn; v++)
+      if (pe_vinsn_running_q[0][v] && vinsn_vfu_q[v] inside {VFU_Alu, VFU_MFpu})
+        vfu_busy_o[vinsn_vfu_q[v]] = 1'b1;
+    vfu_busy_o[VFU_LoadUnit]  = |pe_vinsn_running_q[NrLanes + OffsetLoad];
+    vfu_busy_o[VFU_StoreUnit] = |pe_vinsn_running_q[NrLanes + OffsetStore];
+    vfu_busy_o[VFU_SlideUnit] = |pe_vinsn_running_q[NrLanes + OffsetSlide];
+    vfu_busy_o[VFU_MaskUnit]  = |pe_vinsn_running_q[NrLanes + OffsetMask];
+  end: p_vfu_busy
+
+  `FF(vinsn_vfu_q, vinsn_vfu_d, '0, clk_i, rst_ni);
+
   /////////////////////////
   // Global Hazard table //
   /////////////////////////
@@ -356,6 +380,7 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
     // Default assignments
     state_d               = state_q;
     pe_vinsn_running_d    = pe_vinsn_running_q;
+    vinsn_vfu_d           = vinsn_vfu_q;
     read_list_d           = read_list_q;
     write_list_d          = write_list_q;
     global_hazard_table_d = global_hazard_table_o;
@@ -492,6 +517,7 @@ module ara_sequencer import ara_pkg::*; import rvv_pkg::*; import cf_math_pkg::i
               ara_req_ready_o = 1'b1;
 
               // Remember that the vector instruction is running
+              vinsn_vfu_d[vinsn_id_n] = vfu(ara_req_i.op);
               unique case (vfu(ara_req_i.op))
                 VFU_LoadUnit : pe_vinsn_running_d[NrLanes + OffsetLoad][vinsn_id_n]  = 1'b1;
                 VFU_StoreUnit: pe_vinsn_running_d[NrLanes + OffsetStore][vinsn_id_n] = 1'b1;
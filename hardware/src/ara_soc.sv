@@ -76,6 +76,8 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   // Memory Map
   // 1GByte of DDR (split between two chips on Genesys2)
   localparam logic [63:0] DRAMLength = 64'h40000000;
+  // Size of the L2 memory, which is aliased over the whole DRAM region
+  localparam logic [63:0] L2Length   = 64'(L2NumWords) * AxiDataWidth / 8;
   localparam logic [63:0] UARTLength = 64'h1000;
   localparam logic [63:0] CTRLLength = 64'h1000;
 
@@ -207,18 +209,30 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   );
 
   logic                      l2_req;
+  logic                      l2_gnt;
   logic                      l2_we;
   logic [AxiAddrWidth-1:0]   l2_addr;
   logic [AxiDataWidth/8-1:0] l2_be;
   logic [AxiDataWidth-1:0]   l2_wdata;
   logic [AxiDataWidth-1:0]   l2_rdata;
   logic                      l2_rvalid;
+  // Port of the memory itself
+  logic                      l2_mem_req;
+  logic [AxiDataWidth-1:0]   l2_mem_rdata;
+
+`ifdef DRAM_MODEL
+  // Requests in flight in the DRAM timing model
+  localparam int unsigned L2BufDepth = 64;
+`else
+  localparam int unsigned L2BufDepth = 1;
+`endif
 
   axi_to_mem #(
     .AddrWidth (AxiAddrWidth   ),
     .DataWidth (AxiDataWidth   ),
     .IdWidth   (AxiSocIdWidth  ),
     .NumBanks  (1              ),
+    .BufDepth  (L2BufDepth     ),
     .axi_req_t (soc_wide_req_t ),
     .axi_resp_t(soc_wide_resp_t)
   ) i_axi_to_mem (
@@ -227,7 +241,7 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
     .axi_req_i   (l2mem_wide_axi_req_wo_atomics ),
     .axi_resp_o  (l2mem_wide_axi_resp_wo_atomics),
     .mem_req_o   (l2_req                        ),
-    .mem_gnt_i   (l2_req                        ), // Always available
+    .mem_gnt_i   (l2_gnt                        ),
     .mem_we_o    (l2_we                         ),
     .mem_addr_o  (l2_addr                       ),
     .mem_strb_o  (l2_be                         ),
@@ -239,6 +253,22 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   );
 
 `ifndef SPYGLASS
+`ifdef SPARSE_DRAM
+  // Simulation-only memory, which only allocates the pages that are accessed
+  ara_sparse_dram #(
+    .NumWords (L2NumWords  ),
+    .DataWidth(AxiDataWidth)
+  ) i_dram (
+    .clk_i  (clk_i                                                                      ),
+    .rst_ni (rst_ni                                                                     ),
+    .req_i  (l2_mem_req                                                                 ),
+    .we_i   (l2_we                                                                      ),
+    .addr_i (l2_addr[$clog2(L2NumWords)-1+$clog2(AxiDataWidth/8):$clog2(AxiDataWidth/8)]),
+    .wdata_i(l2_wdata                                                                   ),
+    .be_i   (l2_be                                                                      ),
+    .rdata_o(l2_mem_rdata                                                               )
+  );
+`else
   tc_sram #(
     .NumWords (L2NumWords  ),
     .NumPorts (1           ),
@@ -247,19 +277,43 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   ) i_dram (
     .clk_i  (clk_i                                                                      ),
     .rst_ni (rst_ni                                                                     ),
-    .req_i  (l2_req                                                                     ),
+    .req_i  (l2_mem_req                                                                 ),
     .we_i   (l2_we                                                                      ),
     .addr_i (l2_addr[$clog2(L2NumWords)-1+$clog2(AxiDataWidth/8):$clog2(AxiDataWidth/8)]),
     .wdata_i(l2_wdata                                                                   ),
     .be_i   (l2_be                                                                      ),
-    .rdata_o(l2_rdata                                                                   )
+    .rdata_o(l2_mem_rdata                                                               )
   );
+`endif
 `else
-  assign l2_rdata = '0;
+  assign l2_mem_rdata = '0;
 `endif
 
-  // One-cycle latency
+`ifdef DRAM_MODEL
+  // Simulation-only timing model of a DRAM, which delays the responses
+  ara_dram_model #(
+    .DataWidth(AxiDataWidth),
+    .AddrWidth(AxiAddrWidth),
+    .MaxTxns  (L2BufDepth  )
+  ) i_dram_model (
+    .clk_i      (clk_i       ),
+    .rst_ni     (rst_ni      ),
+    .req_i      (l2_req      ),
+    .gnt_o      (l2_gnt      ),
+    .we_i       (l2_we       ),
+    .addr_i     (l2_addr     ),
+    .rvalid_o   (l2_rvalid   ),
+    .rdata_o    (l2_rdata    ),
+    .mem_req_o  (l2_mem_req  ),
+    .mem_rdata_i(l2_mem_rdata)
+  );
+`else
+  // Always available, with one-cycle latency
+  assign l2_gnt     = l2_req;
+  assign l2_mem_req = l2_req;
+  assign l2_rdata   = l2_mem_rdata;
   `FF(l2_rvalid, l2_req, 1'b0);
+`endif
 
   ////////////
   //  UART  //
@@ -371,6 +425,7 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
   soc_narrow_lite_resp_t axi_lite_ctrl_registers_resp;
 
   logic [63:0] event_trigger;
+  logic [NrPerfEvents-1:0] perf_events;
 
   axi_to_axi_lite #(
     .AxiAddrWidth   (AxiAddrWidth          ),
@@ -396,9 +451,10 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
 
   ctrl_registers #(
     .DRAMBaseAddr   (DRAMBase              ),
-    .DRAMLength     (DRAMLength            ),
+    .DRAMLength     (L2Length              ),
     .DataWidth      (AxiNarrowDataWidth    ),
     .AddrWidth      (AxiAddrWidth          ),
+    .NrPerfCounters (NrPerfEvents          ),
     .axi_lite_req_t (soc_narrow_lite_req_t ),
     .axi_lite_resp_t(soc_narrow_lite_resp_t)
   ) i_ctrl_registers (
@@ -410,7 +466,8 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
     .dram_base_addr_o     (/* Unused */                ),
     .dram_end_addr_o      (/* Unused */                ),
     .exit_o               (exit_o                      ),
-    .event_trigger_o      (event_trigger)
+    .event_trigger_o      (event_trigger               ),
+    .perf_events_i        (perf_events                 )
   );
 
   axi_dw_converter #(
@@ -549,12 +606,16 @@ module ara_soc import axi_pkg::*; import ara_pkg::*; #(
     .scan_data_o  (/* Unconnected */        ),
 `ifndef TARGET_GATESIM
     .axi_req_o    (system_axi_req           ),
-    .axi_resp_i   (system_axi_resp          )
+    .axi_resp_i   (system_axi_resp          ),
+    .perf_events_o(perf_events              )
   );
 `else
     .axi_req_o    (system_axi_req_spill     ),
     .axi_resp_i   (system_axi_resp_spill_del)
   );
+
+  // The performance events are not part of the netlist
+  assign perf_events = '0;
 `endif
 
 
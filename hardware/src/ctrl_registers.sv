@@ -4,7 +4,7 @@
 //
 // Author: Matheus Cavalcante <matheusd@iis.ee.ethz.ch>
 // Description: AXI-LITE accessible control registers, holding
-// static information about Ara's SoC.
+// static information about Ara's SoC and its performance counters.
 
 module ctrl_registers #(
     parameter int   unsigned                 DataWidth       = 32,
@@ -12,6 +12,7 @@ module ctrl_registers #(
     // Parameters
     parameter logic          [DataWidth-1:0] DRAMBaseAddr    = 0,
     parameter logic          [DataWidth-1:0] DRAMLength      = 0,
+    parameter int   unsigned                 NrPerfCounters  = ara_pkg::NrPerfEvents,
     // AXI Structs
     parameter type                           axi_lite_req_t  = logic,
     parameter type                           axi_lite_resp_t = logic
@@ -26,7 +27,9 @@ module ctrl_registers #(
     output logic           [DataWidth-1:0] dram_base_addr_o,
     output logic           [DataWidth-1:0] dram_end_addr_o,
     output logic           [DataWidth-1:0] event_trigger_o,
-    output logic           [DataWidth-1:0] hw_cnt_en_o
+    output logic           [DataWidth-1:0] hw_cnt_en_o,
+    // Performance events, each one increments its counter
+    input  logic      [NrPerfCounters-1:0] perf_events_i
   );
 
   `include "common_cells/registers.svh"
@@ -35,7 +38,8 @@ module ctrl_registers #(
   //  Definitions  //
   ///////////////////
 
-  localparam int unsigned NumRegs          = 5;
+  localparam int unsigned NumBaseRegs      = 5;
+  localparam int unsigned NumRegs          = NumBaseRegs + NrPerfCounters;
   localparam int unsigned DataWidthInBytes = (DataWidth + 7) / 8;
   localparam int unsigned RegNumBytes      = NumRegs * DataWidthInBytes;
 
@@ -43,19 +47,22 @@ module ctrl_registers #(
   localparam logic [DataWidthInBytes-1:0] ReadWriteReg = {DataWidthInBytes{1'b0}};
 
   // Memory map
+  // [8*i+47:8*i+40]: perf_cnt[i] (ro)
   // [39:32]: hw_cnt_en      (rw)
   // [25:31]: event_trigger  (rw)
   // [23:16]: dram_end_addr  (ro)
   // [15:8]:  dram_base_addr (ro)
   // [7:0]:   exit           (rw)
-  localparam logic [NumRegs-1:0][DataWidth-1:0] RegRstVal = '{
-    0,
-    0,
-    DRAMBaseAddr + DRAMLength,
-    DRAMBaseAddr,
-    0
+  localparam logic [NumRegs-1:0][DataWidth-1:0] RegRstVal = {
+    {NrPerfCounters{DataWidth'(0)}},
+    DataWidth'(0),
+    DataWidth'(0),
+    DataWidth'(DRAMBaseAddr + DRAMLength),
+    DataWidth'(DRAMBaseAddr),
+    DataWidth'(0)
   };
-  localparam logic [NumRegs-1:0][DataWidthInBytes-1:0] AxiReadOnly = '{
+  localparam logic [NumRegs-1:0][DataWidthInBytes-1:0] AxiReadOnly = {
+    {NrPerfCounters{ReadOnlyReg}},
     ReadWriteReg,
     ReadWriteReg,
     ReadOnlyReg,
@@ -75,6 +82,21 @@ module ctrl_registers #(
   logic [DataWidth-1:0] dram_end_address;
   logic [DataWidth-1:0] exit;
 
+  logic [NrPerfCounters-1:0][DataWidth-1:0] perf_cnt;
+
+  // The performance counters are incremented through the load port
+  logic [NumRegs-1:0][DataWidth-1:0]        reg_d;
+  logic [NumRegs-1:0][DataWidthInBytes-1:0] reg_load;
+
+  always_comb begin: p_perf_cnt
+    reg_d    = '0;
+    reg_load = '0;
+    for (int unsigned c = 0; c < NrPerfCounters; c++) begin
+      reg_d[NumBaseRegs + c]    = perf_cnt[c] + 1;
+      reg_load[NumBaseRegs + c] = {DataWidthInBytes{perf_events_i[c]}};
+    end
+  end: p_perf_cnt
+
   axi_lite_regs #(
     .RegNumBytes (RegNumBytes    ),
     .AxiAddrWidth(AddrWidth      ),
@@ -90,9 +112,9 @@ module ctrl_registers #(
     .axi_resp_o (axi_lite_slave_resp_o                      ),
     .wr_active_o(wr_active_d                                ),
     .rd_active_o(/* Unused */                               ),
-    .reg_d_i    ('0                                         ),
-    .reg_load_i ('0                                         ),
-    .reg_q_o    ({hw_cnt_en, event_trigger, dram_end_address, dram_base_address, exit})
+    .reg_d_i    (reg_d                                      ),
+    .reg_load_i (reg_load                                   ),
+    .reg_q_o    ({perf_cnt, hw_cnt_en, event_trigger, dram_end_address, dram_base_address, exit})
   );
 
   `FF(wr_active_q, wr_active_d, '0);
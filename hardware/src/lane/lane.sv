@@ -106,7 +106,11 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     // Interface between the Mask unit and the VFUs
     input  strb_t                                          mask_i,
     input  logic                                           mask_valid_i,
-    output logic                                           mask_ready_o
+    output logic                                           mask_ready_o,
+    // Performance events
+    output logic                                           alu_operand_empty_o,
+    output logic                                           mfpu_operand_empty_o,
+    output logic                                           vrf_bank_conflict_o
   );
 
   `include "common_cells/registers.svh"
@@ -291,6 +295,8 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
   logic               [NrOperandQueues-1:0]   operand_issued;
   operand_queue_cmd_t [NrOperandQueues-1:0]   operand_queue_cmd;
   logic               [NrOperandQueues-1:0]   operand_queue_cmd_valid;
+  elen_t              [NrOperandQueues-1:0]   fwd_operand;
+  logic               [NrOperandQueues-1:0]   fwd_operand_valid;
   // Interface with the VFUs
   // ALU
   logic                                       alu_result_req;
@@ -343,6 +349,8 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .operand_queue_ready_i    (operand_queue_ready     ),
     .operand_queue_cmd_o      (operand_queue_cmd       ),
     .operand_queue_cmd_valid_o(operand_queue_cmd_valid ),
+    .fwd_operand_o            (fwd_operand             ),
+    .fwd_operand_valid_o      (fwd_operand_valid       ),
     // Interface with the VFUs
     // ALU
     .alu_result_req_i         (alu_result_req          ),
@@ -381,7 +389,9 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .ldu_result_wdata_i       (ldu_result_wdata_i      ),
     .ldu_result_be_i          (ldu_result_be_i         ),
     .ldu_result_gnt_o         (ldu_result_gnt_o        ),
-    .ldu_result_final_gnt_o   (ldu_result_final_gnt_o  )
+    .ldu_result_final_gnt_o   (ldu_result_final_gnt_o  ),
+    // Performance events
+    .vrf_bank_conflict_o      (vrf_bank_conflict_o     )
   );
 
   ////////////////////////////
@@ -411,6 +421,15 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .operand_valid_o(vrf_operand_valid)
   );
 
+  // Each operand queue receives a word either from the VRF or from the operand forwarding
+  elen_t [NrOperandQueues-1:0] operand;
+  logic  [NrOperandQueues-1:0] operand_valid;
+
+  for (genvar q = 0; q < NrOperandQueues; q++) begin: gen_operand_mux
+    assign operand[q]       = fwd_operand_valid[q] ? fwd_operand[q] : vrf_operand[q];
+    assign operand_valid[q] = fwd_operand_valid[q] || vrf_operand_valid[q];
+  end: gen_operand_mux
+
   //////////////////////
   //  Operand queues  //
   //////////////////////
@@ -425,6 +444,10 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
   logic  [2:0] mfpu_operand_valid;
   logic  [2:0] mfpu_operand_ready;
 
+  // No operand is available to the lane VFUs
+  assign alu_operand_empty_o  = ~|alu_operand_valid;
+  assign mfpu_operand_empty_o = ~|mfpu_operand_valid;
+
   elen_t sldu_addrgen_operand_opqueues;
   target_fu_e sldu_addrgen_operand_target_fu;
   logic sldu_addrgen_cmd_pop;
@@ -442,8 +465,8 @@ module lane import ara_pkg::*; import rvv_pkg::*; #(
     .rst_ni                           (rst_ni                             ),
     .lane_id_i                        (lane_id_i                          ),
     // Interface with the Vector Register File
-    .operand_i                        (vrf_operand                        ),
-    .operand_valid_i                  (vrf_operand_valid                  ),
+    .operand_i                        (operand                            ),
+    .operand_valid_i                  (operand_valid                      ),
     // Interface with the operand requester
     .operand_issued_i                 (operand_issued                     ),
     .operand_queue_ready_o            (operand_queue_ready                ),
@@ -7,6 +7,9 @@
 // This stage is responsible for requesting individual elements from the vector
 // register file, in order, and sending them to the corresponding operand
 // queues. This stage also includes the VRF arbiter.
+// With OperandForwarding, an operand requester stalled on a hazard takes the
+// word it waits for directly from the result of the ALU, MFPU, or load unit
+// that is written to the VRF in the same cycle, instead of reading it back.
 
 module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     parameter  int  unsigned NrLanes               = 0,
@@ -42,6 +45,9 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     output logic                 [NrOperandQueues-1:0] operand_issued_o,
     output operand_queue_cmd_t   [NrOperandQueues-1:0] operand_queue_cmd_o,
     output logic                 [NrOperandQueues-1:0] operand_queue_cmd_valid_o,
+    // Operands forwarded from the results of the VFUs, with the latency of the VRF
+    output elen_t                [NrOperandQueues-1:0] fwd_operand_o,
+    output logic                 [NrOperandQueues-1:0] fwd_operand_valid_o,
     // Interface with the VFUs
     // ALU
     input  logic                                       alu_result_req_i,
@@ -80,7 +86,9 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     input  elen_t                                      ldu_result_wdata_i,
     input  strb_t                                      ldu_result_be_i,
     output logic                                       ldu_result_gnt_o,
-    output logic                                       ldu_result_final_gnt_o
+    output logic                                       ldu_result_final_gnt_o,
+    // Performance event: a VRF bank request was not granted
+    output logic                                       vrf_bank_conflict_o
   );
 
   import cf_math_pkg::idx_width;
@@ -204,6 +212,26 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     end
   end
 
+  //////////////////////////
+  //  Operand forwarding  //
+  //////////////////////////
+
+  // Results that can be forwarded to the operand requesters: only whole words,
+  // since a partial write merges with the old contents of the VRF. The results
+  // of the mask unit and of the slide unit are never forwarded.
+  localparam int unsigned NrFwdSources = 3;
+
+  logic   [NrFwdSources-1:0] fwd_src_valid;
+  vid_t   [NrFwdSources-1:0] fwd_src_id;
+  vaddr_t [NrFwdSources-1:0] fwd_src_addr;
+  elen_t  [NrFwdSources-1:0] fwd_src_wdata;
+
+  assign fwd_src_valid = {ldu_result_gnt && &ldu_result_be, mfpu_result_gnt_o && &mfpu_result_be_i,
+                          alu_result_gnt_o && &alu_result_be_i};
+  assign fwd_src_id    = {ldu_result_id, mfpu_result_id_i, alu_result_id_i};
+  assign fwd_src_addr  = {ldu_result_addr, mfpu_result_addr_i, alu_result_addr_i};
+  assign fwd_src_wdata = {ldu_result_wdata, mfpu_result_wdata_i, alu_result_wdata_i};
+
   ///////////////////////
   //  Operand request  //
   ///////////////////////
@@ -269,11 +297,34 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
 
     requester_metadata_t requester_metadata_d, requester_metadata_q;
 
+    // A forwarded word already used the write that follows it in vinsn_result_written_q
+    logic [NrVInsn-1:0] vinsn_result_forwarded_q;
+    logic [NrVInsn-1:0] vinsn_result_written;
+    assign vinsn_result_written = vinsn_result_written_q & ~vinsn_result_forwarded_q;
+
     // Is there a hazard during this cycle?
     logic stall;
-    assign stall = |(requester_metadata_q.hazard & ~(vinsn_result_written_q &
+    assign stall = |(requester_metadata_q.hazard & ~(vinsn_result_written &
                    (~{NrVInsn{requester_metadata_q.is_widening}} | requester_metadata_q.waw_hazard_counter)));
 
+    // Is the next word to read being written by the only instruction we wait for?
+    logic  fwd_hit;
+    elen_t fwd_data;
+    always_comb begin: p_fwd_hit
+      fwd_hit  = 1'b0;
+      fwd_data = '0;
+      if (OperandForwarding && state_q == REQUESTING && !requester_metadata_q.is_widening)
+        for (int src = 0; src < NrFwdSources; src++)
+          if (fwd_src_valid[src] && fwd_src_addr[src] == requester_metadata_q.addr &&
+              requester_metadata_q.hazard == (NrVInsn'(1) << fwd_src_id[src])) begin
+            fwd_hit  = 1'b1;
+            fwd_data = fwd_src_wdata[src];
+          end
+    end: p_fwd_hit
+
+    // Take the word from the result, instead of waiting to read it from the VRF
+    logic operand_fwd;
+
     // Did we get a grant?
     logic [NrBanks-1:0] operand_requester_gnt;
     for (genvar bank = 0; bank < NrBanks; bank++) begin: gen_operand_requester_gnt
@@ -281,7 +332,7 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     end
 
     // Did we issue a word to this operand queue?
-    assign operand_issued_o[requester_index] = |(operand_requester_gnt);
+    assign operand_issued_o[requester_index] = |(operand_requester_gnt) || operand_fwd;
 
     always_comb begin: operand_requester
       // Helper local variables
@@ -305,6 +356,7 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
       // Make no requests to the VRF
       operand_payload[requester_index] = '0;
       for (int b = 0; b < NrBanks; b++) lane_operand_req_transposed[requester_index][b] = 1'b0;
+      operand_fwd = 1'b0;
 
       // Do not acknowledge any operand requester_index commands
       operand_request_ready_o[requester_index] = 1'b0;
@@ -408,9 +460,12 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
               opqueue: opqueue_e'(requester_index),
               default: '0 // this is a read operation
             };
+            // A stalled requester never competes for the VRF, so the forwarding
+            // does not depend on its own request
+            operand_fwd = stall && fwd_hit;
 
-            // Received a grant.
-            if (|operand_requester_gnt) begin : op_req_grant
+            // Received a grant, or a forwarded word.
+            if (|operand_requester_gnt || operand_fwd) begin : op_req_grant
               // Bump the address pointer
               requester_metadata_d.addr = requester_metadata_q.addr + 1'b1;
 
@@ -474,6 +529,7 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
         requester_metadata_d = '0;
         // Flush this request
         lane_operand_req_transposed[requester_index][bank] = '0;
+        operand_fwd = 1'b0;
       end : vlsu_exception_idle
     end : operand_requester
 
@@ -486,6 +542,20 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
         requester_metadata_q <= requester_metadata_d;
       end
     end
+
+    // The forwarded word reaches the operand queue when a VRF read would
+    always_ff @(posedge clk_i or negedge rst_ni) begin: p_operand_fwd
+      if (!rst_ni) begin
+        fwd_operand_valid_o[requester_index] <= 1'b0;
+        fwd_operand_o[requester_index]       <= '0;
+        vinsn_result_forwarded_q             <= '0;
+      end else begin
+        fwd_operand_valid_o[requester_index] <= operand_fwd;
+        vinsn_result_forwarded_q             <= operand_fwd ? requester_metadata_q.hazard : '0;
+        if (operand_fwd)
+          fwd_operand_o[requester_index] <= fwd_data;
+      end
+    end: p_operand_fwd
   end : gen_operand_requester
 
   ////////////////
@@ -646,4 +716,11 @@ module operand_requester import ara_pkg::*; import rvv_pkg::*; #(
     );
   end : gen_vrf_arbiters
 
+  // A VRF bank has a pending request that was not granted
+  always_comb begin: p_vrf_bank_conflict
+    vrf_bank_conflict_o = 1'b0;
+    for (int bank = 0; bank < NrBanks; bank++)
+      vrf_bank_conflict_o |= |({ext_operand_req[bank], lane_operand_req[bank]} & ~operand_gnt[bank]);
+  end: p_vrf_bank_conflict
+
 endmodule : operand_requester
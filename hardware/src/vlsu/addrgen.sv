@@ -366,7 +366,9 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
           vew     : pe_req_q.vtype.vsew[1:0],
           is_load : is_load(pe_req_q.op),
           // Unit-strided loads/stores trigger incremental AXI bursts.
-          is_burst: (pe_req_q.op inside {VLE, VSE}),
+          // So do the strided ones whose elements are contiguous.
+          is_burst: (pe_req_q.op inside {VLE, VSE}) || (VlsuCoalescing &&
+            (pe_req_q.op inside {VLSE, VSSE}) && (pe_req_q.stride == (1 << pe_req_q.vtype.vsew[1:0]))),
           fault_only_first: pe_req_q.fault_only_first,
           vstart  : pe_req_q.vstart
         };
@@ -641,6 +643,14 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
   logic [clog2_AxiStrobeWidth:0]            eff_axi_dw_d, eff_axi_dw_q;
   logic [idx_width(clog2_AxiStrobeWidth):0] eff_axi_dw_log_d, eff_axi_dw_log_q;
 
+  // Coalescing of indexed loads. The contiguous elements of a run are requested together,
+  // within a window that a single AXI burst can cover: at most 256 beats, in a 4 KiB page.
+  localparam int unsigned IdxRunWinWidth = (clog2_AxiStrobeWidth + 8 < 12) ? clog2_AxiStrobeWidth + 8 : 12;
+
+  // First byte and number of bytes of the run of elements not requested yet
+  axi_addr_t                 idx_run_addr_d, idx_run_addr_q;
+  logic [IdxRunWinWidth:0]   idx_run_bytes_d, idx_run_bytes_q;
+
   function automatic void set_end_addr (
       input  logic [($bits(axi_addr_t) - 12)-1:0]       next_2page_msb,
       input  vlen_t                                     num_bytes,
@@ -690,6 +700,9 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
     eff_axi_dw_d     = eff_axi_dw_q;
     eff_axi_dw_log_d = eff_axi_dw_log_q;
 
+    idx_run_addr_d  = idx_run_addr_q;
+    idx_run_bytes_d = idx_run_bytes_q;
+
     idx_vaddr_ready_d    = 1'b0;
     addrgen_exception_vstart_d  = '0;
 
@@ -730,6 +743,8 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
       AXI_ADDRGEN_IDLE: begin : axi_addrgen_state_AXI_ADDRGEN_IDLE
         // Clear exception buffer
         mmu_exception_d = '0;
+        // No pending run of indexed elements
+        idx_run_bytes_d = '0;
 
         // This computation is timing-critical. Look ahead and compute even if addr not valid.
         axi_addrgen_d = addrgen_req;
@@ -806,6 +821,9 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
 
       AXI_ADDRGEN_REQUESTING : begin : axi_addrgen_state_AXI_ADDRGEN_REQUESTING
         automatic logic axi_ax_ready = (axi_addrgen_q.is_load && axi_ar_ready_i) || (!axi_addrgen_q.is_load && axi_aw_ready_i);
+        // Indexed loads without address translation are coalesced
+        automatic logic idx_coalesce = VlsuCoalescing && (state_q == ADDRGEN_IDX_OP) &&
+          axi_addrgen_q.is_load && !en_ld_st_translation_i;
         automatic logic [12:0] num_bytes; // Cannot consume more than 4 KiB
         automatic vlen_t remaining_bytes;
 
@@ -953,6 +971,97 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
               // Calculate the addresses for the next iteration, adding the correct stride
               next_addr_strided_temp = axi_addrgen_q.addr + axi_addrgen_q.stride;
             end : strided_data
+            else if (idx_coalesce) begin : coalesced_indexed
+              ////////////////////////////////
+              //  Coalesced indexed access  //
+              ////////////////////////////////
+
+              // The elements are collected in a run as long as they are contiguous. The run is
+              // requested when the next element does not extend it, or when there are no more
+              // elements: first a burst up to its last AXI word boundary, if any, then single
+              // beats of decreasing size. The load unit takes all the bytes from the start address
+              // to the end of the beat, so that each request covers exactly a part of the run.
+              automatic logic [IdxRunWinWidth:0] run_start, run_end, line_end, req_end;
+              automatic axi_pkg::size_t          req_size;
+              automatic logic                    elm_valid, elm_extends;
+
+              run_start = idx_run_addr_q[IdxRunWinWidth-1:0];
+              run_end   = run_start + idx_run_bytes_q;
+              line_end  = run_end & ~((AxiDataWidth/8) - 1);
+
+              // Is the next element aligned, and can it be added to the run?
+              elm_valid   = idx_vaddr_valid_q && !is_addr_error(idx_final_vaddr_q, axi_addrgen_q.vew[1:0]);
+              elm_extends = elm_valid && (idx_run_bytes_q != '0) &&
+                (idx_final_vaddr_q == idx_run_addr_q + idx_run_bytes_q) &&
+                (idx_final_vaddr_q[AxiAddrWidth-1:IdxRunWinWidth] == idx_run_addr_q[AxiAddrWidth-1:IdxRunWinWidth]);
+
+              if (elm_extends) begin : run_extend
+                idx_vaddr_ready_d = 1'b1;
+                idx_run_bytes_d   = idx_run_bytes_q + (1 << axi_addrgen_q.vew);
+              end : run_extend
+              else if (idx_run_bytes_q != '0) begin : run_request
+                // Wait for the next element, unless the run holds all the remaining ones
+                if (idx_vaddr_valid_q || (axi_addrgen_q.len == idx_run_bytes_q)) begin : run_ready
+                  if (line_end > run_start) begin
+                    req_size = clog2_AxiStrobeWidth;
+                    req_end  = line_end;
+                  end else begin
+                    // Largest naturally aligned block whose tail, from the run start, is in the run
+                    req_size = axi_addrgen_q.vew;
+                    req_end  = run_start + (1 << axi_addrgen_q.vew);
+                    for (int unsigned s = 1; s < clog2_AxiStrobeWidth; s++)
+                      if (s > axi_addrgen_q.vew && ((run_start | ((1 << s) - 1)) + 1) <= run_end) begin
+                        req_size = s;
+                        req_end  = (run_start | ((1 << s) - 1)) + 1;
+                      end
+                  end
+
+                  axi_ar_o = '{
+                    addr   : idx_run_addr_q,
+                    len    : ((req_end - 1) >> clog2_AxiStrobeWidth) - (run_start >> clog2_AxiStrobeWidth),
+                    size   : req_size,
+                    cache  : CACHE_MODIFIABLE,
+                    burst  : BURST_INCR,
+                    default: '0
+                  };
+                  axi_ar_valid_o = 1'b1;
+
+                  // Send this request to the load unit
+                  axi_addrgen_queue = '{
+                    addr         : idx_run_addr_q,
+                    size         : req_size,
+                    len          : axi_ar_o.len,
+                    is_load      : 1'b1,
+                    is_exception : 1'b0
+                  };
+                  axi_addrgen_queue_push = 1'b1;
+
+                  // Account for the requested bytes
+                  axi_addrgen_d.len = axi_addrgen_q.len - (req_end - run_start);
+                  idx_run_addr_d    = idx_run_addr_q + (req_end - run_start);
+                  idx_run_bytes_d   = idx_run_bytes_q - (req_end - run_start);
+
+                  // Start the next run right away
+                  if (elm_valid && idx_run_bytes_d == '0) begin : run_next
+                    idx_vaddr_ready_d = 1'b1;
+                    idx_run_addr_d    = idx_final_vaddr_q;
+                    idx_run_bytes_d   = 1 << axi_addrgen_q.vew;
+                  end : run_next
+                end : run_ready
+              end : run_request
+              else if (elm_valid) begin : run_first
+                idx_vaddr_ready_d = 1'b1;
+                idx_run_addr_d    = idx_final_vaddr_q;
+                idx_run_bytes_d   = 1 << axi_addrgen_q.vew;
+              end : run_first
+              else if (idx_vaddr_valid_q) begin : eew_misaligned_error
+                // All the previous elements were requested
+                idx_op_error_d             = 1'b1;
+                addrgen_exception_vstart_d = (addrgen_req.len - axi_addrgen_q.len) >> axi_addrgen_q.vew - 1;
+                addrgen_req_ready          = 1'b1;
+                axi_addrgen_state_d        = AXI_ADDRGEN_IDLE;
+              end : eew_misaligned_error
+            end : coalesced_indexed
             else begin : indexed_data
               // NOTE: address translation is not yet been implemented/tested for indexed
 
@@ -1057,7 +1166,7 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
                 axi_addrgen_d.len = len_temp;
                 axi_addrgen_d.addr = next_addr_strided_temp;
               end : strided
-              else begin : indexed // INDEXED ACCESS
+              else if (!idx_coalesce) begin : indexed // INDEXED ACCESS
                 automatic logic [CVA6Cfg.PLEN-1:0] idx_final_paddr;
                 // TODO: check if idx_vaddr_valid_q is stable
                 if (idx_vaddr_valid_q) begin : if_idx_vaddr_valid_q
@@ -1148,6 +1257,8 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
       eff_axi_dw_q              <= '0;
       eff_axi_dw_log_q          <= '0;
       next_2page_msb_q          <= '0;
+      idx_run_addr_q            <= '0;
+      idx_run_bytes_q           <= '0;
     end else begin
       axi_addrgen_state_q       <= axi_addrgen_state_d;
       axi_addrgen_q             <= axi_addrgen_d;
@@ -1158,6 +1269,8 @@ module addrgen import ara_pkg::*; import rvv_pkg::*; #(
       eff_axi_dw_q              <= eff_axi_dw_d;
       eff_axi_dw_log_q          <= eff_axi_dw_log_d;
       next_2page_msb_q          <= next_2page_msb_d;
+      idx_run_addr_q            <= idx_run_addr_d;
+      idx_run_bytes_q           <= idx_run_bytes_d;
     end
   end
 
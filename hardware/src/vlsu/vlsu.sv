@@ -122,8 +122,8 @@ module vlsu import ara_pkg::*; import rvv_pkg::*; #(
   ///////////////
 
   // Internal AXI request signals
-  axi_req_t  axi_req;
-  axi_resp_t axi_resp;
+  axi_req_t  axi_req, axi_cut_req;
+  axi_resp_t axi_resp, axi_cut_resp;
 
   axi_cut #(
     .ar_chan_t (axi_ar_t  ),
@@ -138,10 +138,38 @@ module vlsu import ara_pkg::*; import rvv_pkg::*; #(
     .rst_ni    (rst_ni    ),
     .mst_req_o (axi_req_o ),
     .mst_resp_i(axi_resp_i),
-    .slv_req_i (axi_req   ),
-    .slv_resp_o(axi_resp  )
+    .slv_req_i (axi_cut_req ),
+    .slv_resp_o(axi_cut_resp)
   );
 
+  //////////////////
+  //  Prefetcher  //
+  //////////////////
+
+  if (VlsuPrefetch) begin : gen_prefetcher
+    vlsu_prefetcher #(
+      .NrStreams   (VlsuPrefetchStreams),
+      .Beats       (VlsuPrefetchBeats  ),
+      .AxiDataWidth(AxiDataWidth       ),
+      .AxiAddrWidth(AxiAddrWidth       ),
+      .axi_ar_t    (axi_ar_t           ),
+      .axi_r_t     (axi_r_t            ),
+      .axi_req_t   (axi_req_t          ),
+      .axi_resp_t  (axi_resp_t         )
+    ) i_prefetcher (
+      .clk_i            (clk_i            ),
+      .rst_ni           (rst_ni           ),
+      .core_st_pending_i(core_st_pending_i),
+      .slv_req_i        (axi_req          ),
+      .slv_resp_o       (axi_resp         ),
+      .mst_req_o        (axi_cut_req      ),
+      .mst_resp_i       (axi_cut_resp     )
+    );
+  end else begin : gen_no_prefetcher
+    assign axi_cut_req = axi_req;
+    assign axi_resp    = axi_cut_resp;
+  end
+
   //////////////////////////
   //  Address Generation  //
   //////////////////////////
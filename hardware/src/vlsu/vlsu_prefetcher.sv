@@ -0,0 +1,478 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Next-stripe prefetcher of the VLSU. It sits on the AXI port of the VLSU and
+// detects sequential streams of full-width INCR bursts on the AR channel, as
+// generated by stripmined unit-strided loads. When a burst starts where one of
+// the tracked streams ended, the head of the next stripe (up to Beats words,
+// within the same 4 KiB page) is requested ahead of time into a small buffer.
+// A later burst starting at the prefetched address takes its first beats from
+// the buffer, and only the rest is requested from memory.
+//
+// The AW, W, and B channels are passed through. A buffer is dropped when a
+// write overlaps it, and no prefetch is issued while writes are in flight or
+// while CVA6 has pending stores, so that the buffers never hold stale data.
+// All the AR requests of the VLSU use ID 0, so the responses to the demand and
+// to the prefetch requests come back in order (checked in simulation). A prefetch request is only raised
+// when the VLSU has no request pending, and the demand requests wait until it
+// is accepted.
+
+module vlsu_prefetcher import axi_pkg::*; #(
+    // Number of streams tracked, each with its buffer
+    parameter int  unsigned NrStreams    = 2,
+    // Size of each buffer [AXI words]
+    parameter int  unsigned Beats        = 32,
+    // Maximum number of AR bursts outstanding at the same time
+    parameter int  unsigned MaxTxns      = 8,
+    // AXI Interface parameters
+    parameter int  unsigned AxiDataWidth = 0,
+    parameter int  unsigned AxiAddrWidth = 0,
+    parameter type          axi_ar_t     = logic,
+    parameter type          axi_r_t      = logic,
+    parameter type          axi_req_t    = logic,
+    parameter type          axi_resp_t   = logic
+  ) (
+    input  logic      clk_i,
+    input  logic      rst_ni,
+    // Interface with the dispatcher
+    input  logic      core_st_pending_i,
+    // Input / Slave Port
+    input  axi_req_t  slv_req_i,
+    output axi_resp_t slv_resp_o,
+    // Output / Master Port
+    output axi_req_t  mst_req_o,
+    input  axi_resp_t mst_resp_i
+  );
+
+  import cf_math_pkg::idx_width;
+
+  ///////////////////
+  //  Definitions  //
+  ///////////////////
+
+  localparam int unsigned LineOffset = $clog2(AxiDataWidth/8);
+  // Number of AXI words in a 4 KiB page
+  localparam int unsigned PageLines  = 4096 / (AxiDataWidth/8);
+
+  // Address of an AXI word
+  typedef logic [AxiAddrWidth-LineOffset-1:0] line_t;
+  typedef logic [idx_width(NrStreams)-1:0]    stream_t;
+  typedef logic [idx_width(Beats+1)-1:0]      beats_t;
+  typedef logic [idx_width(Beats)-1:0]        beat_idx_t;
+  typedef stream_t [NrStreams-1:0]            ages_t;
+
+  // Demand bursts, in the order of their responses
+  typedef struct packed {
+    stream_t stream;
+    // Beats taken from the buffer of the stream
+    beats_t hit_beats;
+    // The rest of the burst was requested from memory
+    logic fwd;
+  } dmd_t;
+
+  // Bursts requested from memory, in the order of their responses
+  typedef struct packed {
+    logic    prefetch;
+    stream_t stream;
+  } mem_t;
+
+  ///////////////
+  //  Streams  //
+  ///////////////
+
+  // Address following the last burst of each stream, and age (0 is the most recent)
+  logic    [NrStreams-1:0] tbl_valid_d, tbl_valid_q;
+  line_t   [NrStreams-1:0] tbl_line_d, tbl_line_q;
+  ages_t                   tbl_age_d, tbl_age_q;
+  // The next stripe of the stream should be prefetched
+  logic    [NrStreams-1:0] pf_pending_d, pf_pending_q;
+
+  // Buffers
+  // - valid: a new burst can take its first beats from the buffer
+  // - busy:  a burst is taking its first beats from the buffer
+  // - rcv:   beats of the prefetch request still to be received
+  logic    [NrStreams-1:0] buf_valid_d, buf_valid_q;
+  logic    [NrStreams-1:0] buf_busy_d, buf_busy_q;
+  line_t   [NrStreams-1:0] buf_line_d, buf_line_q;
+  beats_t  [NrStreams-1:0] buf_beats_d, buf_beats_q;
+  beats_t  [NrStreams-1:0] buf_rcv_d, buf_rcv_q;
+  logic    [AxiDataWidth-1:0] buf_data_q [NrStreams][Beats];
+  resp_t                      buf_resp_q [NrStreams][Beats];
+
+  // Write into the buffers
+  logic      buf_we;
+  stream_t   buf_we_stream;
+  beat_idx_t buf_we_beat;
+
+  // Writes in flight
+  logic [7:0] writes_d, writes_q;
+
+  // Prefetch request raised on the AR channel and not accepted yet. AXI does
+  // not allow to change or drop it, so it is kept until the handshake, and the
+  // demand requests wait behind it.
+  logic    pf_ar_valid_d, pf_ar_valid_q;
+  axi_ar_t pf_ar_d, pf_ar_q;
+  stream_t pf_ar_stream_d, pf_ar_stream_q;
+
+  // Mark a stream as the most recent one
+  function automatic ages_t touch(stream_t s, ages_t age);
+    touch = age;
+    for (int unsigned i = 0; i < NrStreams; i++)
+      if (age[i] < age[s])
+        touch[i] = age[i] + 1;
+    touch[s] = '0;
+  endfunction : touch
+
+  /////////////
+  //  FIFOs  //
+  /////////////
+
+  dmd_t dmd_fifo_data, dmd_fifo_head;
+  logic dmd_fifo_push, dmd_fifo_pop, dmd_fifo_full, dmd_fifo_empty;
+  mem_t mem_fifo_data, mem_fifo_head;
+  logic mem_fifo_push, mem_fifo_pop, mem_fifo_full, mem_fifo_empty;
+
+  fifo_v3 #(
+    .DEPTH(MaxTxns),
+    .dtype(dmd_t  )
+  ) i_dmd_fifo (
+    .clk_i     (clk_i         ),
+    .rst_ni    (rst_ni        ),
+    .flush_i   (1'b0          ),
+    .testmode_i(1'b0          ),
+    .full_o    (dmd_fifo_full ),
+    .empty_o   (dmd_fifo_empty),
+    .usage_o   (/* Unused */  ),
+    .data_i    (dmd_fifo_data ),
+    .push_i    (dmd_fifo_push ),
+    .data_o    (dmd_fifo_head ),
+    .pop_i     (dmd_fifo_pop  )
+  );
+
+  fifo_v3 #(
+    .DEPTH(MaxTxns + NrStreams),
+    .dtype(mem_t              )
+  ) i_mem_fifo (
+    .clk_i     (clk_i         ),
+    .rst_ni    (rst_ni        ),
+    .flush_i   (1'b0          ),
+    .testmode_i(1'b0          ),
+    .full_o    (mem_fifo_full ),
+    .empty_o   (mem_fifo_empty),
+    .usage_o   (/* Unused */  ),
+    .data_i    (mem_fifo_data ),
+    .push_i    (mem_fifo_push ),
+    .data_o    (mem_fifo_head ),
+    .pop_i     (mem_fifo_pop  )
+  );
+
+  // Beats of the oldest demand burst already taken from the buffer
+  beats_t dmd_ptr_d, dmd_ptr_q;
+
+  ///////////////////
+  //  AXI Handling  //
+  ///////////////////
+
+  always_comb begin : axi
+    // Default: Feed through
+    mst_req_o  = slv_req_i;
+    slv_resp_o = mst_resp_i;
+
+    // Maintain state
+    tbl_valid_d    = tbl_valid_q;
+    tbl_line_d     = tbl_line_q;
+    tbl_age_d      = tbl_age_q;
+    pf_pending_d   = pf_pending_q;
+    buf_valid_d    = buf_valid_q;
+    buf_busy_d     = buf_busy_q;
+    buf_line_d     = buf_line_q;
+    buf_beats_d    = buf_beats_q;
+    buf_rcv_d      = buf_rcv_q;
+    dmd_ptr_d      = dmd_ptr_q;
+    writes_d       = writes_q;
+
+    pf_ar_valid_d  = pf_ar_valid_q;
+    pf_ar_d        = pf_ar_q;
+    pf_ar_stream_d = pf_ar_stream_q;
+
+    buf_we        = 1'b0;
+    buf_we_stream = '0;
+    buf_we_beat   = '0;
+
+    dmd_fifo_data = '0;
+    dmd_fifo_push = 1'b0;
+    dmd_fifo_pop  = 1'b0;
+    mem_fifo_data = '0;
+    mem_fifo_push = 1'b0;
+    mem_fifo_pop  = 1'b0;
+
+    //////////////////
+    //  AR channel  //
+    //////////////////
+
+    // Do not depend on the AR payload, which the address generator computes from the ready
+    slv_resp_o.ar_ready = !dmd_fifo_full && !mem_fifo_full && mst_resp_i.ar_ready;
+    mst_req_o.ar_valid  = 1'b0;
+
+    if (pf_ar_valid_q) begin : prefetch_held
+      // Keep the prefetch request stable until it is accepted
+      slv_resp_o.ar_ready = 1'b0;
+      mst_req_o.ar        = pf_ar_q;
+      mst_req_o.ar_valid  = 1'b1;
+
+      if (mst_resp_i.ar_ready) begin
+        pf_ar_valid_d = 1'b0;
+        mem_fifo_data = '{prefetch: 1'b1, stream: pf_ar_stream_q};
+        mem_fifo_push = 1'b1;
+      end
+    end : prefetch_held
+    else if (slv_req_i.ar_valid) begin : demand
+      automatic line_t   ar_line   = slv_req_i.ar.addr[AxiAddrWidth-1:LineOffset];
+      automatic logic    ar_stream = slv_req_i.ar.burst == BURST_INCR && slv_req_i.ar.size == LineOffset;
+      automatic line_t   ar_end    = ar_line + slv_req_i.ar.len + 1;
+      automatic logic    match     = 1'b0;
+      automatic stream_t match_s   = '0;
+      automatic stream_t victim    = '0;
+      automatic beats_t  hit_beats = '0;
+
+      for (int unsigned s = 0; s < NrStreams; s++) begin
+        if (tbl_valid_q[s] && tbl_line_q[s] == ar_line) begin
+          match   = 1'b1;
+          match_s = s;
+        end
+        if (tbl_age_q[s] == NrStreams - 1)
+          victim = s;
+      end
+
+      // Take the first beats from the buffer
+      if (ar_stream && match && buf_valid_q[match_s] && buf_line_q[match_s] == ar_line)
+        hit_beats = (buf_beats_q[match_s] < slv_req_i.ar.len + 1) ? buf_beats_q[match_s] :
+                                                                     slv_req_i.ar.len + 1;
+
+      // Request the rest from memory
+      if (hit_beats != slv_req_i.ar.len + 1) begin
+        mst_req_o.ar_valid = !dmd_fifo_full && !mem_fifo_full;
+        mst_req_o.ar.addr  = (ar_line + hit_beats) << LineOffset;
+        mst_req_o.ar.len   = slv_req_i.ar.len - hit_beats;
+        // Keep the misaligned start address of the first beat
+        if (hit_beats == '0)
+          mst_req_o.ar.addr = slv_req_i.ar.addr;
+      end
+
+      if (slv_resp_o.ar_ready) begin : demand_accepted
+        dmd_fifo_data = '{
+          stream   : match_s,
+          hit_beats: hit_beats,
+          fwd      : hit_beats != slv_req_i.ar.len + 1
+        };
+        dmd_fifo_push = 1'b1;
+        mem_fifo_data = '{prefetch: 1'b0, stream: '0};
+        mem_fifo_push = mst_req_o.ar_valid;
+
+        if (hit_beats != '0)
+          buf_busy_d[match_s] = 1'b1;
+
+        if (ar_stream) begin
+          if (match) begin
+            // Continue the stream, and prefetch its next stripe
+            tbl_line_d[match_s]   = ar_end;
+            buf_valid_d[match_s]  = 1'b0;
+            pf_pending_d[match_s] = 1'b1;
+            tbl_age_d             = touch(match_s, tbl_age_q);
+          end else begin
+            // Replace the oldest stream
+            tbl_valid_d[victim]  = 1'b1;
+            tbl_line_d[victim]   = ar_end;
+            buf_valid_d[victim]  = 1'b0;
+            pf_pending_d[victim] = 1'b0;
+            tbl_age_d            = touch(victim, tbl_age_q);
+          end
+        end
+      end : demand_accepted
+    end : demand
+    else if (!core_st_pending_i && writes_q == '0 && !mem_fifo_full) begin : prefetch
+      // Prefetch the next stripe of a stream whose buffer is free
+      for (int unsigned s = 0; s < NrStreams; s++) begin
+        if (pf_pending_q[s] && !buf_busy_q[s] && buf_rcv_q[s] == '0 && !mst_req_o.ar_valid) begin
+          automatic int unsigned page_left = PageLines - (tbl_line_q[s] % PageLines);
+          automatic beats_t      pf_beats  = (page_left < Beats) ? page_left : Beats;
+
+          mst_req_o.ar = '{
+            addr   : tbl_line_q[s] << LineOffset,
+            len    : pf_beats - 1,
+            size   : LineOffset,
+            burst  : BURST_INCR,
+            cache  : CACHE_MODIFIABLE,
+            default: '0
+          };
+          mst_req_o.ar_valid = 1'b1;
+
+          // The request is raised: it cannot be withdrawn anymore
+          pf_pending_d[s] = 1'b0;
+          buf_valid_d[s]  = 1'b1;
+          buf_line_d[s]   = tbl_line_q[s];
+          buf_beats_d[s]  = pf_beats;
+          buf_rcv_d[s]    = pf_beats;
+
+          if (mst_resp_i.ar_ready) begin
+            mem_fifo_data = '{prefetch: 1'b1, stream: s};
+            mem_fifo_push = 1'b1;
+          end else begin
+            pf_ar_valid_d  = 1'b1;
+            pf_ar_d        = mst_req_o.ar;
+            pf_ar_stream_d = s;
+          end
+        end
+      end
+    end : prefetch
+
+    /////////////////
+    //  R channel  //
+    /////////////////
+
+    slv_resp_o.r_valid = 1'b0;
+    mst_req_o.r_ready  = 1'b0;
+
+    // Responses to the prefetch requests go to the buffers
+    if (!mem_fifo_empty && mem_fifo_head.prefetch) begin : prefetch_response
+      mst_req_o.r_ready = 1'b1;
+      if (mst_resp_i.r_valid) begin
+        buf_we                          = 1'b1;
+        buf_we_stream                   = mem_fifo_head.stream;
+        buf_we_beat                     = buf_beats_q[buf_we_stream] - buf_rcv_q[buf_we_stream];
+        buf_rcv_d[mem_fifo_head.stream] = buf_rcv_q[mem_fifo_head.stream] - 1;
+        mem_fifo_pop                    = mst_resp_i.r.last;
+      end
+    end : prefetch_response
+
+    if (!dmd_fifo_empty) begin : demand_response
+      automatic stream_t s = dmd_fifo_head.stream;
+
+      if (dmd_ptr_q != dmd_fifo_head.hit_beats) begin : from_buffer
+        // Wait for the beat to be received
+        slv_resp_o.r_valid = (buf_beats_q[s] - buf_rcv_q[s]) > dmd_ptr_q;
+        slv_resp_o.r       = '{
+          data   : buf_data_q[s][beat_idx_t'(dmd_ptr_q)],
+          resp   : buf_resp_q[s][beat_idx_t'(dmd_ptr_q)],
+          last   : !dmd_fifo_head.fwd && (dmd_ptr_q == dmd_fifo_head.hit_beats - 1),
+          default: '0
+        };
+
+        if (slv_resp_o.r_valid && slv_req_i.r_ready) begin
+          dmd_ptr_d = dmd_ptr_q + 1;
+          if (dmd_ptr_d == dmd_fifo_head.hit_beats) begin
+            buf_busy_d[s] = 1'b0;
+            if (!dmd_fifo_head.fwd) begin
+              dmd_ptr_d    = '0;
+              dmd_fifo_pop = 1'b1;
+            end
+          end
+        end
+      end : from_buffer
+      else if (!mem_fifo_empty && !mem_fifo_head.prefetch) begin : from_memory
+        slv_resp_o.r_valid = mst_resp_i.r_valid;
+        slv_resp_o.r       = mst_resp_i.r;
+        mst_req_o.r_ready  = slv_req_i.r_ready;
+
+        if (mst_resp_i.r_valid && slv_req_i.r_ready && mst_resp_i.r.last) begin
+          dmd_ptr_d    = '0;
+          dmd_fifo_pop = 1'b1;
+          mem_fifo_pop = 1'b1;
+        end
+      end : from_memory
+    end : demand_response
+
+    /////////////////////////
+    //  AW and B channels  //
+    /////////////////////////
+
+    if (slv_req_i.aw_valid && mst_resp_i.aw_ready) begin : write
+      // Drop the buffers that overlap with the write, including the one prefetched in this cycle
+      automatic line_t aw_first = slv_req_i.aw.addr[AxiAddrWidth-1:LineOffset];
+      automatic line_t aw_last  = (aligned_addr(slv_req_i.aw.addr, slv_req_i.aw.size) +
+        ((slv_req_i.aw.len + 1) << slv_req_i.aw.size) - 1) >> LineOffset;
+
+      for (int unsigned s = 0; s < NrStreams; s++)
+        if (buf_line_d[s] <= aw_last && aw_first < buf_line_d[s] + buf_beats_d[s])
+          buf_valid_d[s] = 1'b0;
+
+      writes_d += 1;
+    end : write
+
+    if (mst_resp_i.b_valid && slv_req_i.b_ready)
+      writes_d -= 1;
+
+    // Scalar stores can write the prefetched data
+    if (core_st_pending_i)
+      buf_valid_d = '0;
+  end : axi
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      tbl_valid_q    <= '0;
+      tbl_line_q     <= '0;
+      pf_pending_q   <= '0;
+      buf_valid_q    <= '0;
+      buf_busy_q     <= '0;
+      buf_line_q     <= '0;
+      buf_beats_q    <= '0;
+      buf_rcv_q      <= '0;
+      dmd_ptr_q      <= '0;
+      writes_q       <= '0;
+      pf_ar_valid_q  <= 1'b0;
+      pf_ar_q        <= '0;
+      pf_ar_stream_q <= '0;
+      for (int unsigned s = 0; s < NrStreams; s++)
+        tbl_age_q[s] <= s;
+    end else begin
+      tbl_valid_q    <= tbl_valid_d;
+      tbl_line_q     <= tbl_line_d;
+      tbl_age_q      <= tbl_age_d;
+      pf_pending_q   <= pf_pending_d;
+      buf_valid_q    <= buf_valid_d;
+      buf_busy_q     <= buf_busy_d;
+      buf_line_q     <= buf_line_d;
+      buf_beats_q    <= buf_beats_d;
+      buf_rcv_q      <= buf_rcv_d;
+      dmd_ptr_q      <= dmd_ptr_d;
+      writes_q       <= writes_d;
+      pf_ar_valid_q  <= pf_ar_valid_d;
+      pf_ar_q        <= pf_ar_d;
+      pf_ar_stream_q <= pf_ar_stream_d;
+    end
+  end
+
+  // The buffers are not reset
+  always_ff @(posedge clk_i) begin
+    if (buf_we) begin
+      buf_data_q[buf_we_stream][buf_we_beat] <= mst_resp_i.r.data;
+      buf_resp_q[buf_we_stream][buf_we_beat] <= mst_resp_i.r.resp;
+    end
+  end
+
+  //////////////////
+  //  Assertions  //
+  //////////////////
+
+  if (Beats == 0 || Beats > 256)
+    $error("[vlsu_prefetcher] The buffers must hold between 1 and 256 beats.");
+
+  if (NrStreams == 0)
+    $error("[vlsu_prefetcher] The prefetcher needs at least one stream.");
+
+`ifndef SYNTHESIS
+  // The responses are matched to the demand and prefetch requests in order,
+  // which only holds if they all use the same ID
+  always_ff @(posedge clk_i) begin
+    if (rst_ni && slv_req_i.ar_valid && slv_req_i.ar.id != '0)
+      $error("[vlsu_prefetcher] AR request with ID %0d: the VLSU requests must use ID 0.",
+        slv_req_i.ar.id);
+    if (rst_ni && mst_resp_i.r_valid && mst_resp_i.r.id != '0)
+      $error("[vlsu_prefetcher] R response with ID %0d: the responses must come back on ID 0.",
+        mst_resp_i.r.id);
+  end
+`endif
+
+endmodule : vlsu_prefetcher
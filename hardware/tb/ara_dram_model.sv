@@ -0,0 +1,125 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description: DRAM timing model for Verilator.
+// Sits between axi_to_mem and the main memory, and delays the response of
+// every memory request by the latency computed by the DPI functions in
+// tb/verilator/dram_model. The memory itself is still accessed when the
+// request is granted, so the timing model never affects the contents.
+// Responses are returned in order, as axi_to_mem expects.
+//
+// The model is configured with plusargs (see dram_model.cc for the defaults):
+//   +dram_latency=N    fixed latency of the controller and PHY [cycles]
+//   +dram_bw=N         peak bandwidth of the data bus [bytes/cycle]
+//   +dram_max_txns=N   requests in flight, at most MaxTxns
+//   +dram_banks=N      number of banks
+//   +dram_row_size=N   size of a row of each bank [bytes]
+//   +dram_t_cas=N      column access latency [cycles]
+//   +dram_t_rcd=N      row activation latency [cycles]
+//   +dram_t_rp=N       row precharge latency [cycles]
+
+module ara_dram_model #(
+    parameter  int unsigned DataWidth = 0,
+    parameter  int unsigned AddrWidth = 0,
+    // Size of the response buffer, upper bound of +dram_max_txns
+    parameter  int unsigned MaxTxns   = 64,
+    // Dependant parameters. DO NOT CHANGE!
+    localparam int unsigned IdxWidth  = (MaxTxns > 1) ? $clog2(MaxTxns) : 1
+  ) (
+    input  logic                 clk_i,
+    input  logic                 rst_ni,
+    // Memory port of axi_to_mem
+    input  logic                 req_i,
+    output logic                 gnt_o,
+    input  logic                 we_i,
+    input  logic [AddrWidth-1:0] addr_i,
+    output logic                 rvalid_o,
+    output logic [DataWidth-1:0] rdata_o,
+    // Memory, with one cycle of read latency
+    output logic                 mem_req_o,
+    input  logic [DataWidth-1:0] mem_rdata_i
+  );
+
+  import "DPI-C" function int ara_dram_model_init(input int data_width, input int buf_size,
+    input int max_txns, input int latency, input int bw, input int banks, input int row_size,
+    input int t_cas, input int t_rcd, input int t_rp);
+  import "DPI-C" function void ara_dram_model_reset();
+  import "DPI-C" function longint ara_dram_model_access(input longint cycle, input longint addr,
+    input bit we);
+
+  /////////////////////
+  //  Configuration  //
+  /////////////////////
+
+  // Requests in flight, set by +dram_max_txns
+  int unsigned max_txns;
+
+  initial begin
+    // Unset parameters keep the defaults of the model
+    int latency, bw, txns, banks, row_size, t_cas, t_rcd, t_rp;
+    if (!$value$plusargs("dram_latency=%d", latency)) latency = -1;
+    if (!$value$plusargs("dram_bw=%d", bw)) bw = -1;
+    if (!$value$plusargs("dram_max_txns=%d", txns)) txns = -1;
+    if (!$value$plusargs("dram_banks=%d", banks)) banks = -1;
+    if (!$value$plusargs("dram_row_size=%d", row_size)) row_size = -1;
+    if (!$value$plusargs("dram_t_cas=%d", t_cas)) t_cas = -1;
+    if (!$value$plusargs("dram_t_rcd=%d", t_rcd)) t_rcd = -1;
+    if (!$value$plusargs("dram_t_rp=%d", t_rp)) t_rp = -1;
+    max_txns = ara_dram_model_init(DataWidth, MaxTxns, txns, latency, bw, banks, row_size,
+      t_cas, t_rcd, t_rp);
+  end
+
+  ///////////////////////
+  //  Response buffer  //
+  ///////////////////////
+
+  longint unsigned      cycle_q;
+  // Cycle from which each response can be returned, and its data
+  longint unsigned      ready_q [MaxTxns];
+  logic [DataWidth-1:0] data_q  [MaxTxns];
+  logic [IdxWidth-1:0]  wr_ptr_q, rd_ptr_q;
+  logic [IdxWidth:0]    cnt_q;
+  // The memory returns the read data of the entry fill_idx_q in this cycle
+  logic                 fill_q;
+  logic [IdxWidth-1:0]  fill_idx_q;
+
+  assign gnt_o     = 32'(cnt_q) < max_txns;
+  assign mem_req_o = req_i && gnt_o;
+
+  // The data of the oldest response may still be on the memory output
+  assign rvalid_o = cnt_q != '0 && ready_q[rd_ptr_q] <= cycle_q;
+  assign rdata_o  = (fill_q && fill_idx_q == rd_ptr_q) ? mem_rdata_i : data_q[rd_ptr_q];
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      cycle_q    <= '0;
+      wr_ptr_q   <= '0;
+      rd_ptr_q   <= '0;
+      cnt_q      <= '0;
+      fill_q     <= 1'b0;
+      fill_idx_q <= '0;
+    end else begin
+      cycle_q <= cycle_q + 1;
+      fill_q  <= mem_req_o;
+
+      if (fill_q)
+        data_q[fill_idx_q] <= mem_rdata_i;
+
+      if (mem_req_o) begin
+        ready_q[wr_ptr_q] <= ara_dram_model_access(cycle_q, longint'(addr_i), we_i);
+        fill_idx_q        <= wr_ptr_q;
+        wr_ptr_q          <= (wr_ptr_q == IdxWidth'(MaxTxns - 1)) ? '0 : wr_ptr_q + 1;
+      end
+
+      if (rvalid_o)
+        rd_ptr_q <= (rd_ptr_q == IdxWidth'(MaxTxns - 1)) ? '0 : rd_ptr_q + 1;
+
+      cnt_q <= cnt_q + (IdxWidth+1)'(mem_req_o) - (IdxWidth+1)'(rvalid_o);
+    end
+  end
+
+  // The state of the banks and the statistics restart with the simulation
+  always @(negedge rst_ni) ara_dram_model_reset();
+
+endmodule : ara_dram_model
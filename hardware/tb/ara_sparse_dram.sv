@@ -0,0 +1,89 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description: Sparse main memory for Verilator.
+// Drop-in replacement of the single-ported tc_sram, with one cycle of read
+// latency. The contents live in the DPI functions of tb/verilator/sparse_dram,
+// which only allocate the pages that are written, so that the memory can span
+// the whole DRAM region without its size being allocated by the model.
+// The memory can be preloaded with simutil_set_mem, like tc_sram. Its contents
+// are not part of the checkpoints of the model.
+
+module ara_sparse_dram #(
+    parameter  int unsigned NumWords  = 0,
+    parameter  int unsigned DataWidth = 0,
+    // Dependant parameters. DO NOT CHANGE!
+    localparam int unsigned BeWidth   = DataWidth / 8,
+    localparam int unsigned AddrWidth = (NumWords > 1) ? $clog2(NumWords) : 1
+  ) (
+    input  logic                 clk_i,
+    input  logic                 rst_ni,
+    input  logic                 req_i,
+    input  logic                 we_i,
+    input  logic [AddrWidth-1:0] addr_i,
+    input  logic [DataWidth-1:0] wdata_i,
+    input  logic [BeWidth-1:0]   be_i,
+    output logic [DataWidth-1:0] rdata_o
+  );
+
+  import "DPI-C" context function void ara_sparse_dram_read(input longint offset,
+    input int size, output bit [511:0] data);
+  import "DPI-C" context function void ara_sparse_dram_write(input longint offset,
+    input int size, input bit [511:0] data, input bit [63:0] strb);
+
+  ///////////////////
+  //  Memory port  //
+  ///////////////////
+
+  logic [DataWidth-1:0] rdata_q;
+
+  always @(posedge clk_i) begin
+    automatic bit [511:0] rdata;
+    if (req_i) begin
+      if (we_i) begin
+        ara_sparse_dram_write(longint'(addr_i) * BeWidth, BeWidth, 512'(wdata_i), 64'(be_i));
+      end else begin
+        ara_sparse_dram_read(longint'(addr_i) * BeWidth, BeWidth, rdata);
+        rdata_q <= rdata[DataWidth-1:0];
+      end
+    end
+  end
+
+  assign rdata_o = rdata_q;
+
+  ////////////////////
+  //  Memory utils  //
+  ////////////////////
+
+  // Same interface as the memory loader of tc_sram, used by the simulation
+  // controller to preload the memory
+  export "DPI-C" task simutil_memload;
+
+  task simutil_memload;
+    input string file;
+    $error("[ara_sparse_dram] VMEM files are not supported, load an ELF file.");
+  endtask
+
+  export "DPI-C" function simutil_set_mem;
+  function int simutil_set_mem(input int index, input bit [511:0] val);
+    if (DataWidth > 512 || index < 0 || index >= NumWords)
+      return 0;
+
+    ara_sparse_dram_write(longint'(index) * BeWidth, BeWidth, val, '1);
+    return 1;
+  endfunction
+
+  export "DPI-C" function simutil_get_mem;
+  function int simutil_get_mem(input int index, output bit [511:0] val);
+    if (DataWidth > 512 || index < 0 || index >= NumWords)
+      return 0;
+
+    ara_sparse_dram_read(longint'(index) * BeWidth, BeWidth, val);
+    return 1;
+  endfunction
+
+  if (DataWidth > 512)
+    $error("[ara_sparse_dram] DataWidth must be at most 512 bits.");
+
+endmodule : ara_sparse_dram
@@ -35,6 +35,12 @@ module ara_tb;
   localparam VLEN = 0;
   `endif
 
+  `ifdef L2_NUM_WORDS
+  localparam L2NumWords = `L2_NUM_WORDS;
+  `else
+  localparam L2NumWords = (2**22) / NrLanes;
+  `endif
+
   localparam ClockPeriod  = 1ns;
   // Axi response delay [ps]
   localparam int unsigned AxiRespDelay = 200;
@@ -46,6 +52,7 @@ module ara_tb;
 
   localparam DRAMAddrBase = 64'h8000_0000;
   localparam DRAMLength   = 64'h4000_0000; // 1GByte of DDR (split between two chips on Genesys2)
+  localparam L2Length     = 64'(L2NumWords) * AxiWideBeWidth;
 
   /********************************
    *  Clock and Reset Generation  *
@@ -87,7 +94,8 @@ module ara_tb;
     .VLEN        (VLEN            ),
     .AxiAddrWidth(AxiAddrWidth    ),
     .AxiDataWidth(AxiWideDataWidth),
-    .AxiRespDelay(AxiRespDelay    )
+    .AxiRespDelay(AxiRespDelay    ),
+    .L2NumWords  (L2NumWords      )
   ) dut (
     .clk_i (clk  ),
     .rst_ni(rst_n),
@@ -123,6 +131,12 @@ module ara_tb;
         // Read sections
         automatic int nwords = (length + AxiWideBeWidth - 1)/AxiWideBeWidth;
         $display("Loading section %x of length %x", address, length);
+        // The L2 is aliased over the DRAM region, so a section that does not
+        // fit would silently overwrite the beginning of the memory
+        if (address >= DRAMAddrBase && address + length > DRAMAddrBase + L2Length) begin
+          $error("Section %x of length %x does not fit in the %x bytes of L2 memory.", address, length, L2Length);
+          $finish;
+        end
         buffer = new[nwords * AxiWideBeWidth];
         void'(read_section(address, buffer));
         // Initializing memories
@@ -7,12 +7,23 @@
 // Description: Top level testbench module for Verilator.
 
 module ara_tb_verilator #(
-    parameter int unsigned NrLanes = 0,
-    parameter int unsigned VLEN    = 0
+    parameter int unsigned NrLanes    = 0,
+    parameter int unsigned VLEN       = 0,
+    // Number of words of the main memory
+    parameter int unsigned L2NumWords = (2**22) / NrLanes
   )(
     input  logic        clk_i,
     input  logic        rst_ni,
-    output logic [63:0] exit_o
+    output logic [63:0] exit_o,
+    // Software-controlled event register, sampled by the simulation controller
+    output logic [63:0] event_trigger_o,
+    // Software-controlled counter enable, used to window the traces
+    output logic [63:0] hw_cnt_en_o,
+    // Performance counters, reported by the simulation controller
+    output logic [63:0] hw_cycles_o,
+    output logic [63:0] dcache_stalls_o,
+    output logic [63:0] icache_stalls_o,
+    output logic [63:0] sb_full_o
   );
 
   /*****************
@@ -30,13 +41,64 @@ module ara_tb_verilator #(
     .NrLanes     (NrLanes         ),
     .VLEN        (VLEN            ),
     .AxiAddrWidth(AxiAddrWidth    ),
-    .AxiDataWidth(AxiWideDataWidth)
+    .AxiDataWidth(AxiWideDataWidth),
+    .L2NumWords  (L2NumWords      )
   ) dut (
     .clk_i (clk_i ),
     .rst_ni(rst_ni),
     .exit_o(exit_o)
   );
 
+  assign event_trigger_o = dut.i_ara_soc.event_trigger;
+  assign hw_cnt_en_o     = dut.i_ara_soc.hw_cnt_en_o;
+
+  assign hw_cycles_o     = dut.runtime_buf_q;
+  assign dcache_stalls_o = dut.dcache_stall_buf_q;
+  assign icache_stalls_o = dut.icache_stall_buf_q;
+  assign sb_full_o       = dut.sb_full_buf_q;
+
+  /*************************
+   *  Instruction tracer  *
+   *************************/
+
+`ifdef VINSN_TRACE
+  localparam int unsigned NrPEs = NrLanes + 4;
+
+  logic [NrPEs-1:0][ara_pkg::NrVInsn-1:0] pe_vinsn_done;
+  logic [63:0]                            vinsn_pc;
+
+  for (genvar pe = 0; pe < NrPEs; pe++) begin: gen_pe_vinsn_done
+    assign pe_vinsn_done[pe] = dut.i_ara_soc.i_system.i_ara.pe_resp[pe].vinsn_done;
+  end: gen_pe_vinsn_done
+
+`ifdef IDEAL_DISPATCHER
+  assign vinsn_pc = '0;
+`else
+  // The accelerator request does not carry the PC, so take it from the scoreboard entry of the
+  // instruction that CVA6 is offering
+  assign vinsn_pc = dut.i_ara_soc.i_system.i_ariane.issue_stage_i.i_scoreboard.mem_q[
+    dut.i_ara_soc.i_system.i_ara.acc_req_i.acc_req.trans_id].sbe.pc;
+`endif
+
+  ara_vinsn_tracer #(
+    .NrLanes(NrLanes)
+  ) i_vinsn_tracer (
+    .clk_i             (clk_i                                                      ),
+    .rst_ni            (rst_ni                                                     ),
+    .insn_i            (dut.i_ara_soc.i_system.i_ara.acc_req_i.acc_req.insn        ),
+    .pc_i              (vinsn_pc                                                   ),
+    .ara_req_valid_i   (dut.i_ara_soc.i_system.i_ara.ara_req_valid                 ),
+    .ara_req_ready_i   (dut.i_ara_soc.i_system.i_ara.ara_req_ready                 ),
+    .vid_i             (dut.i_ara_soc.i_system.i_ara.i_sequencer.vinsn_id_n        ),
+    .pe_req_valid_i    (dut.i_ara_soc.i_system.i_ara.pe_req_valid                  ),
+    .pe_req_id_i       (dut.i_ara_soc.i_system.i_ara.pe_req.id                     ),
+    .pe_req_vfu_i      (dut.i_ara_soc.i_system.i_ara.pe_req.vfu                    ),
+    .pe_req_ready_i    (dut.i_ara_soc.i_system.i_ara.pe_req_ready                  ),
+    .pe_vinsn_running_i(dut.i_ara_soc.i_system.i_ara.i_sequencer.pe_vinsn_running_q),
+    .pe_vinsn_done_i   (pe_vinsn_done                                              )
+  );
+`endif
+
   /*********
    *  EOC  *
    *********/
@@ -48,6 +110,9 @@ module ara_tb_verilator #(
       end else begin
         // Print vector HW runtime
         $display("[hw-cycles]: %d", int'(dut.runtime_buf_q));
+        $display("[cva6-d$-stalls]: %d", int'(dut.dcache_stall_buf_q));
+        $display("[cva6-i$-stalls]: %d", int'(dut.icache_stall_buf_q));
+        $display("[cva6-sb-full]: %d", int'(dut.sb_full_buf_q));
         $info("Core Test ", $sformatf("*** SUCCESS *** (tohost = %0d)", (exit_o >> 1)));
       end
 
@@ -0,0 +1,158 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description: Vector instruction tracer for Verilator.
+// For every vector instruction that reaches Ara's sequencer, records when the
+// dispatcher took it from CVA6, when the sequencer accepted it, and when each
+// processing element accepted and committed it. The records are written by
+// the DPI functions in tb/verilator/vinsn_trace, to the file given by the
+// +vinsn_trace=FILE plusarg (vinsn_trace.bin by default).
+
+module ara_vinsn_tracer import ara_pkg::*; #(
+    parameter  int unsigned NrLanes = 0,
+    // Dependant parameters. DO NOT CHANGE!
+    localparam int unsigned NrPEs   = NrLanes + 4
+  ) (
+    input logic                            clk_i,
+    input logic                            rst_ni,
+    // Instruction offered by CVA6 to the dispatcher
+    input logic        [31:0]              insn_i,
+    input logic        [63:0]              pc_i,
+    // Interface between the dispatcher and the sequencer
+    input logic                            ara_req_valid_i,
+    input logic                            ara_req_ready_i,
+    // ID that the sequencer assigns to the accepted instruction
+    input vid_t                            vid_i,
+    // Interface between the sequencer and the PEs
+    input logic                            pe_req_valid_i,
+    input vid_t                            pe_req_id_i,
+    input vfu_e                            pe_req_vfu_i,
+    input logic        [NrPEs-1:0]         pe_req_ready_i,
+    input logic        [NrPEs-1:0][NrVInsn-1:0] pe_vinsn_running_i,
+    input logic        [NrPEs-1:0][NrVInsn-1:0] pe_vinsn_done_i
+  );
+
+  import "DPI-C" function void ara_vtrace_open(input string filename, input int nr_lanes);
+  import "DPI-C" function void ara_vtrace_pe(input int pe, input longint t_start,
+    input longint t_done);
+  import "DPI-C" function void ara_vtrace_insn(input int vid, input int vfu, input int insn,
+    input longint pc, input longint t_dispatch, input longint t_accept, input longint t_done);
+  import "DPI-C" function void ara_vtrace_close();
+
+  /////////////////
+  //  Trace file //
+  /////////////////
+
+  initial begin
+    string filename;
+    if (!$value$plusargs("vinsn_trace=%s", filename))
+      filename = "vinsn_trace.bin";
+    ara_vtrace_open(filename, NrLanes);
+  end
+
+  final ara_vtrace_close();
+
+  /////////////////
+  //  Recording  //
+  /////////////////
+
+  longint unsigned cycle;
+
+  // Instruction that the request registered by the dispatcher was decoded from
+  logic            [31:0] req_insn;
+  logic            [63:0] req_pc;
+  longint unsigned        req_t_dispatch;
+
+  // Instructions accepted by the sequencer, and not yet committed
+  logic            [NrVInsn-1:0] pending;
+  longint unsigned              t_dispatch [NrVInsn];
+  longint unsigned              t_accept   [NrVInsn];
+  logic            [31:0]       insn       [NrVInsn];
+  logic            [63:0]       pc         [NrVInsn];
+  vfu_e                         vfu        [NrVInsn];
+  // Processing elements that run each instruction
+  logic            [NrPEs-1:0]  pe_target  [NrVInsn];
+  logic            [NrPEs-1:0]  pe_started [NrVInsn];
+  longint unsigned              t_pe_start [NrVInsn][NrPEs];
+  longint unsigned              t_pe_done  [NrVInsn][NrPEs];
+
+  always @(posedge clk_i) begin
+    if (!rst_ni) begin
+      cycle          = 0;
+      req_insn       = '0;
+      req_pc         = '0;
+      req_t_dispatch = 0;
+      pending        = '0;
+    end else begin
+      for (int unsigned v = 0; v < NrVInsn; v++) begin
+        if (pending[v]) begin
+          automatic logic running = 1'b0;
+
+          if (pe_req_valid_i && pe_req_id_i == v)
+            vfu[v] = pe_req_vfu_i;
+
+          for (int unsigned pe = 0; pe < NrPEs; pe++) begin
+            running |= pe_vinsn_running_i[pe][v];
+            if (pe_vinsn_running_i[pe][v])
+              pe_target[v][pe] = 1'b1;
+            // The sequencer broadcasts the request until every PE sampled it
+            if (pe_req_valid_i && pe_req_id_i == v && pe_req_ready_i[pe] &&
+                pe_vinsn_running_i[pe][v] && !pe_started[v][pe]) begin
+              pe_started[v][pe] = 1'b1;
+              t_pe_start[v][pe] = cycle;
+            end
+            if (pe_vinsn_done_i[pe][v])
+              t_pe_done[v][pe] = cycle;
+          end
+
+          // The sequencer marks the instruction as running one cycle after
+          // accepting it, and clears it after the last PE committed it
+          if (!running && cycle > t_accept[v] + 1) begin
+            automatic longint unsigned t_done = t_accept[v] + 1;
+            for (int unsigned pe = 0; pe < NrPEs; pe++)
+              if (pe_target[v][pe]) begin
+                ara_vtrace_pe(pe, t_pe_start[v][pe], t_pe_done[v][pe]);
+                if (t_pe_done[v][pe] > t_done)
+                  t_done = t_pe_done[v][pe];
+              end
+            ara_vtrace_insn(v, vfu[v], insn[v], pc[v], t_dispatch[v], t_accept[v], t_done);
+            pending[v] = 1'b0;
+          end
+        end
+      end
+
+      // Handshake between the dispatcher and the sequencer
+      if (ara_req_valid_i && ara_req_ready_i) begin
+        pending[vid_i]    = 1'b1;
+        t_dispatch[vid_i] = req_t_dispatch;
+        t_accept[vid_i]   = cycle;
+        insn[vid_i]       = req_insn;
+        pc[vid_i]         = req_pc;
+        vfu[vid_i]        = VFU_None;
+        pe_target[vid_i]  = '0;
+        pe_started[vid_i] = '0;
+        for (int unsigned pe = 0; pe < NrPEs; pe++) begin
+          t_pe_start[vid_i][pe] = cycle;
+          t_pe_done[vid_i][pe]  = cycle;
+        end
+      end
+
+      // The dispatcher registers its request to the sequencer whenever the
+      // sequencer is ready, so the request it offers was decoded from the
+      // instruction that CVA6 offered when the register was last written. The
+      // dispatcher only takes an instruction from CVA6 when the sequencer is
+      // ready, i.e., in the cycle in which the register is written (reshuffle
+      // and segment micro-operations are written before the handshake of
+      // their instruction).
+      if (ara_req_ready_i) begin
+        req_insn       = insn_i;
+        req_pc         = pc_i;
+        req_t_dispatch = cycle;
+      end
+
+      cycle++;
+    end
+  end
+
+endmodule : ara_vinsn_tracer
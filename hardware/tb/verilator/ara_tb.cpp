@@ -13,6 +13,10 @@
 #include "verilator_memutil.h"
 #include "verilator_sim_ctrl.h"
 
+// DRAM region of Ara's SoC
+static const uint32_t kDRAMBase = 0x80000000;
+static const uint64_t kDRAMLength = 0x40000000;
+
 int main(int argc, char **argv) {
   // Create an instance of the DUT
   ara_tb_verilator *tb = new ara_tb_verilator;
@@ -22,11 +26,32 @@ int main(int argc, char **argv) {
   VerilatorSimCtrl &simctrl = VerilatorSimCtrl::GetInstance();
   simctrl.SetTop(tb, &tb->clk_i, &tb->rst_ni,
                  VerilatorSimCtrlFlags::ResetPolarityNegative);
+  simctrl.SetEventTrigger(&tb->event_trigger_o);
+  simctrl.SetCounterEnable(&tb->hw_cnt_en_o);
+  simctrl.SetExitSignal(&tb->exit_o);
+
+  // Performance report
+  simctrl.SetConfiguration("nr_lanes", NR_LANES);
+  simctrl.SetConfiguration("vlen", ARA_VLEN);
+  simctrl.RegisterCounter("hw_cycles", &tb->hw_cycles_o);
+  simctrl.RegisterCounter("dcache_stalls", &tb->dcache_stalls_o);
+  simctrl.RegisterCounter("icache_stalls", &tb->icache_stalls_o);
+  simctrl.RegisterCounter("sb_full", &tb->sb_full_o);
 
-  // Initialize the DRAM
-  MemAreaLoc l2_mem = {.base=0x80000000, .size=0x00100000};
+  // Initialize the DRAM, with the same size as the L2 memory of the RTL, so
+  // that ELF segments that do not fit are rejected when they are loaded
+  const uint64_t l2_width = 64 * NR_LANES / 2;
+  const uint64_t l2_size = uint64_t(L2_NUM_WORDS) * l2_width / 8;
+  if (l2_size > kDRAMLength || (l2_size & (l2_size - 1))) {
+    std::cerr << "ERROR: The L2 memory size (0x" << std::hex << l2_size
+              << " bytes) must be a power of two, at most 0x" << kDRAMLength
+              << "." << std::endl;
+    return 1;
+  }
+  simctrl.SetConfiguration("dram_size", l2_size);
+  MemAreaLoc l2_mem = {.base = kDRAMBase, .size = uint32_t(l2_size)};
   memutil.RegisterMemoryArea(
-                             "ram", "TOP.ara_tb_verilator.dut.i_ara_soc.i_dram", 64*NR_LANES/2, &l2_mem);
+                             "ram", "TOP.ara_tb_verilator.dut.i_ara_soc.i_dram", l2_width, &l2_mem);
   simctrl.RegisterExtension(&memutil);
 
   simctrl.SetInitialResetDelay(5);
@@ -44,5 +69,9 @@ int main(int argc, char **argv) {
 
   simctrl.RunSimulation();
 
+  // In batch mode, this also fails if any of the runs failed
+  if (!simctrl.WasSimulationSuccessful()) {
+    return 1;
+  }
   return tb->dut().exit_o >> 1;
 }
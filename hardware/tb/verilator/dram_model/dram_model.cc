@@ -0,0 +1,165 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// DPI functions of the DRAM timing model (tb/ara_dram_model.sv).
+// They are only linked into models verilated with dram_model=1.
+//
+// Each memory word goes through one bank and the shared data bus:
+// - The address is split in rows of row_size bytes, interleaved on the banks.
+// - A bank keeps its last row open. An access to the open row only pays the
+//   column access (t_cas), one to another row first closes it (t_rp) and
+//   opens the new one (t_rcd). Column accesses to an open row are pipelined.
+// - The data bus moves bw bytes per cycle, shared by all the banks.
+// - The fixed latency of the controller and of the PHY is added on top.
+// The statistics are added to the performance report of the simulation.
+
+#include <algorithm>
+#include <cstdint>
+#include <svdpi.h>
+#include <vector>
+
+#include "verilator_sim_ctrl.h"
+
+namespace {
+
+struct DramConfig {
+  uint64_t latency = 40;
+  uint64_t bw = 16;
+  uint64_t max_txns = 16;
+  uint64_t banks = 8;
+  uint64_t row_size = 2048;
+  uint64_t t_cas = 14;
+  uint64_t t_rcd = 14;
+  uint64_t t_rp = 14;
+};
+
+struct DramStats {
+  QData reads = 0;
+  QData writes = 0;
+  QData row_hits = 0;
+  QData row_conflicts = 0;
+  // Sum of the latencies of the reads [cycles]
+  QData read_cycles = 0;
+};
+
+class DramModel {
+ public:
+  void Init(const DramConfig &config, uint64_t word_size) {
+    config_ = config;
+    word_size_ = word_size;
+    banks_.resize(config_.banks);
+    Reset();
+  }
+
+  void Reset() {
+    std::fill(banks_.begin(), banks_.end(), Bank());
+    bus_free_ = 0;
+    stats_ = DramStats();
+  }
+
+  // Cycle from which the response of an access issued at cycle can be
+  // returned
+  uint64_t Access(uint64_t cycle, uint64_t addr, bool we) {
+    uint64_t row = addr / config_.row_size;
+    Bank &bank = banks_[row % config_.banks];
+    row /= config_.banks;
+
+    uint64_t issue = std::max(cycle, bank.ready);
+    if (bank.open && bank.row == row) {
+      stats_.row_hits++;
+    } else {
+      if (bank.open) {
+        stats_.row_conflicts++;
+        issue += config_.t_rp;
+      }
+      issue += config_.t_rcd;
+      bank.open = true;
+      bank.row = row;
+    }
+
+    // A word takes at least one cycle on the bus
+    uint64_t beat =
+        std::max<uint64_t>(1, (word_size_ + config_.bw - 1) / config_.bw);
+    uint64_t data = std::max(issue + config_.t_cas, bus_free_);
+    bus_free_ = data + beat;
+    bank.ready = data - config_.t_cas + beat;
+
+    uint64_t done = data + beat + config_.latency;
+    if (we) {
+      stats_.writes++;
+    } else {
+      stats_.reads++;
+      stats_.read_cycles += done - cycle;
+    }
+    return done;
+  }
+
+  DramStats &stats() { return stats_; }
+
+ private:
+  struct Bank {
+    bool open = false;
+    uint64_t row = 0;
+    // First cycle in which the bank accepts a new column access
+    uint64_t ready = 0;
+  };
+
+  DramConfig config_;
+  uint64_t word_size_ = 0;
+  std::vector<Bank> banks_;
+  // First cycle in which the data bus is free
+  uint64_t bus_free_ = 0;
+  DramStats stats_;
+};
+
+// There is only one main memory
+DramModel dram;
+
+}  // namespace
+
+extern "C" {
+
+// Negative latencies, and sizes that are not positive, keep the defaults.
+// Returns the number of requests in flight, at most buf_size.
+int ara_dram_model_init(int data_width, int buf_size, int max_txns,
+                        int latency, int bw, int banks, int row_size,
+                        int t_cas, int t_rcd, int t_rp) {
+  DramConfig config;
+  if (max_txns > 0) config.max_txns = max_txns;
+  if (latency >= 0) config.latency = latency;
+  if (bw > 0) config.bw = bw;
+  if (banks > 0) config.banks = banks;
+  if (row_size > 0) config.row_size = row_size;
+  if (t_cas >= 0) config.t_cas = t_cas;
+  if (t_rcd >= 0) config.t_rcd = t_rcd;
+  if (t_rp >= 0) config.t_rp = t_rp;
+  config.max_txns = std::min<uint64_t>(config.max_txns, buf_size);
+  dram.Init(config, data_width / 8);
+
+  VerilatorSimCtrl &simctrl = VerilatorSimCtrl::GetInstance();
+  simctrl.SetConfiguration("dram_latency", config.latency);
+  simctrl.SetConfiguration("dram_bw", config.bw);
+  simctrl.SetConfiguration("dram_max_txns", config.max_txns);
+  simctrl.SetConfiguration("dram_banks", config.banks);
+  simctrl.SetConfiguration("dram_row_size", config.row_size);
+  simctrl.SetConfiguration("dram_t_cas", config.t_cas);
+  simctrl.SetConfiguration("dram_t_rcd", config.t_rcd);
+  simctrl.SetConfiguration("dram_t_rp", config.t_rp);
+  DramStats &stats = dram.stats();
+  simctrl.RegisterCounter("dram_reads", &stats.reads);
+  simctrl.RegisterCounter("dram_writes", &stats.writes);
+  simctrl.RegisterCounter("dram_row_hits", &stats.row_hits);
+  simctrl.RegisterCounter("dram_row_conflicts", &stats.row_conflicts);
+  simctrl.RegisterCounter("dram_read_cycles", &stats.read_cycles);
+
+  return config.max_txns;
+}
+
+void ara_dram_model_reset() { dram.Reset(); }
+
+long long ara_dram_model_access(long long cycle, long long addr, svBit we) {
+  return dram.Access(cycle, addr, we);
+}
+}
@@ -5,6 +5,7 @@
 #include "dpi_memutil.h"
 
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <fcntl.h>
 #include <iostream>
@@ -13,6 +14,8 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <vector>
+#include <verilated.h>
+#include <verilated_syms.h>
 
 #include "sv_scoped.h"
 
@@ -243,6 +246,51 @@ static std::vector<uint8_t> FlattenElfFile(const std::string &filepath) {
   return ret.GetFlat();
 }
 
+// Return a pointer to the verilated storage array (`sram') of the memory
+// area |m| and its size in bytes, or nullptr if it cannot be accessed directly.
+//
+// The array is only visible if it is marked as public (see waiver.vlt). We
+// also require each word to be stored without padding, so that a byte offset
+// in the memory is also a byte offset in the storage array.
+static uint8_t *GetMemStorage(const MemArea &m, size_t &size_byte) {
+  const VerilatedScope *scope = static_cast<const VerilatedScope *>(
+      svGetScopeFromName(m.location.data()));
+  if (!scope)
+    return nullptr;
+
+  const VerilatedVar *var = scope->varFind("sram");
+  if (!var || var->entSize() != m.width_byte)
+    return nullptr;
+
+  size_byte = var->totalSize();
+  return static_cast<uint8_t *>(var->datap());
+}
+
+// Write a "segment" of data to the given memory area with a single copy into
+// the verilated storage array. Return false if the array is not accessible.
+static bool WriteSegmentBulk(const MemArea &m, uint32_t offset,
+                             const std::vector<uint8_t> &data) {
+  size_t storage_size;
+  uint8_t *storage = GetMemStorage(m, storage_size);
+  if (!storage)
+    return false;
+
+  // Like the word-by-word path, zero-fill the tail of a partial last word
+  size_t padded_size =
+      (data.size() + m.width_byte - 1) / m.width_byte * m.width_byte;
+  if ((size_t)offset + padded_size > storage_size) {
+    std::ostringstream oss;
+    oss << "Could not set `" << m.name << "' memory at byte offset 0x"
+        << std::hex << offset << ": segment of size 0x" << data.size()
+        << " does not fit in the 0x" << storage_size << " bytes of storage.";
+    throw std::runtime_error(oss.str());
+  }
+
+  memcpy(storage + offset, data.data(), data.size());
+  memset(storage + offset + data.size(), 0, padded_size - data.size());
+  return true;
+}
+
 // Write a "segment" of data to the given memory area.
 static void WriteSegment(const MemArea &m, uint32_t offset,
                          const std::vector<uint8_t> &data) {
@@ -257,6 +305,10 @@ static void WriteSegment(const MemArea &m, uint32_t offset,
   assert(m.addr_loc.size == 0 || offset + data.size() <= m.addr_loc.size);
   assert((offset % m.width_byte) == 0);
 
+  // Fast path: copy the whole segment at once
+  if (WriteSegmentBulk(m, offset, data))
+    return;
+
   // If this fails to set scope, it will throw an error which should
   // be caught at this function's callsite.
   SVScoped scoped(m.location.data());
@@ -552,18 +604,18 @@ void DpiMemUtil::LoadElfToMemories(bool verbose, const std::string &filepath) {
 
     const MemArea &mem_area = mem_area_it->second;
 
-    for (const auto seg_pr : staged_mem.GetSegs()) {
+    for (const auto &seg_pr : staged_mem.GetSegs()) {
       const AddrRange<uint32_t> &seg_rng = seg_pr.first;
       const std::vector<uint8_t> &seg_data = seg_pr.second;
       try {
         WriteSegment(mem_area, seg_rng.lo, seg_data);
       } catch (const SVScoped::Error &err) {
         std::ostringstream oss;
-        std::cout << "No memory found at `" << err.scope_name_
+        oss << "No memory found at `" << err.scope_name_
             << "' (the scope associated with region `" << mem_area.name
             << "', used by a segment that starts at LMA 0x" << std::hex
             << mem_area.addr_loc.base + seg_rng.lo << ").";
-        // throw std::runtime_warn(oss.str());
+        throw std::runtime_error(oss.str());
       }
     }
   }
@@ -590,6 +642,17 @@ void DpiMemUtil::StageElf(bool verbose, const std::string &path) {
     if (phdr.p_memsz == 0)
       continue;
 
+    // The memory regions live in a 32-bit address space: do not let the
+    // segment bounds wrap around when they are narrowed below
+    if (phdr.p_paddr + phdr.p_memsz > (uint64_t)UINT32_MAX + 1 ||
+        phdr.p_paddr + phdr.p_memsz < phdr.p_paddr) {
+      std::ostringstream oss;
+      oss << "Segment " << i << " has LMA 0x" << std::hex << phdr.p_paddr
+          << " and size 0x" << phdr.p_memsz
+          << ", so it does not fit in any memory region.";
+      throw ElfError(path, oss.str());
+    }
+
     const MemArea &mem_area =
         GetRegionForSegment(path, i, phdr.p_paddr, phdr.p_memsz);
 
@@ -69,6 +69,10 @@ class StagedMem {
  * simutil_memload()
  * simutil_set_mem()
  * to be defined somewhere as SystemVerilog functions.
+ *
+ * If the memory array (`sram') of a registered memory is public in the
+ * verilated model, ELF segments are copied into it directly, with one memcpy
+ * per segment, instead of one simutil_set_mem() call per memory word.
  */
 class DpiMemUtil {
  public:
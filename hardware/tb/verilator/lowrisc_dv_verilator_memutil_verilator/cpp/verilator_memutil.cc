@@ -182,7 +182,19 @@ bool VerilatorMemUtil::ParseCLIArguments(int argc, char **argv,
       std::cerr << "ERROR: " << err.what() << std::endl;
       return false;
     }
+    loaded_images_.push_back(arg.filepath);
   }
 
   return true;
 }
+
+bool VerilatorMemUtil::LoadImage(const std::string &filepath) {
+  loaded_images_.assign(1, filepath);
+  try {
+    mem_util_->LoadElfToMemories(false, filepath);
+  } catch (const std::exception &err) {
+    std::cerr << "ERROR: " << err.what() << std::endl;
+    return false;
+  }
+  return true;
+}
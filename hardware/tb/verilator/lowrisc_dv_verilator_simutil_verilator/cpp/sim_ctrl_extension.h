@@ -5,6 +5,9 @@
 #ifndef OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_SIM_CTRL_EXTENSION_H_
 #define OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_SIM_CTRL_EXTENSION_H_
 
+#include <string>
+#include <vector>
+
 class SimCtrlExtension {
  public:
   virtual ~SimCtrlExtension() = default;
@@ -22,6 +25,22 @@ class SimCtrlExtension {
     return true;
   }
 
+  /**
+   * Load the program image at |filepath|
+   *
+   * Called before each run of a batch simulation (see --batch).
+   *
+   * @return Return code, true == success
+   */
+  virtual bool LoadImage(const std::string &filepath) { return true; }
+
+  /**
+   * Get the files loaded for the current run
+   *
+   * Their hashes are part of the performance report.
+   */
+  virtual std::vector<std::string> GetLoadedImages() const { return {}; }
+
   /**
    * Function to be called prior to executing the simulation
    */
@@ -4,10 +4,17 @@
 
 #include "verilator_sim_ctrl.h"
 
+#include <climits>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
 #include <getopt.h>
+#include <iomanip>
 #include <iostream>
 #include <signal.h>
+#include <sstream>
 #include <sys/stat.h>
+#include <unistd.h>
 #include <verilated.h>
 
 // This is defined by Verilator and passed through the command line
@@ -15,6 +22,11 @@
 #define VM_TRACE 0
 #endif
 
+// This is passed through the command line when verilating with --savable
+#ifndef VM_SAVABLE
+#define VM_SAVABLE 0
+#endif
+
 /**
  * Get the current simulation time
  *
@@ -47,6 +59,26 @@ void VerilatorSimCtrl::SetTop(VerilatedToplevel *top, CData *sig_clk,
   flags_ = flags;
 }
 
+void VerilatorSimCtrl::SetEventTrigger(QData *sig_event_trigger) {
+  sig_event_trigger_ = sig_event_trigger;
+}
+
+void VerilatorSimCtrl::SetCounterEnable(QData *sig_cnt_en) {
+  sig_cnt_en_ = sig_cnt_en;
+}
+
+void VerilatorSimCtrl::SetExitSignal(QData *sig_exit) { sig_exit_ = sig_exit; }
+
+void VerilatorSimCtrl::RegisterCounter(const std::string &name,
+                                       QData *sig_counter) {
+  counters_.emplace_back(name, sig_counter);
+}
+
+void VerilatorSimCtrl::SetConfiguration(const std::string &name,
+                                        unsigned long value) {
+  configuration_.emplace_back(name, value);
+}
+
 std::pair<int, bool> VerilatorSimCtrl::Exec(int argc, char **argv) {
   bool exit_app = false;
   bool good_cmdline = ParseCommandArgs(argc, argv, exit_app);
@@ -64,6 +96,12 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
   const struct option long_options[] = {
       {"term-after-cycles", required_argument, nullptr, 'c'},
       {"trace", no_argument, nullptr, 't'},
+      {"trace-window", required_argument, nullptr, 'w'},
+      {"trace-scope", required_argument, nullptr, 'S'},
+      {"save-checkpoint-at", required_argument, nullptr, 's'},
+      {"restore-checkpoint", required_argument, nullptr, 'R'},
+      {"batch", required_argument, nullptr, 'b'},
+      {"report", required_argument, nullptr, 'p'},
       {"help", no_argument, nullptr, 'h'},
       {nullptr, no_argument, nullptr, 0}};
 
@@ -88,9 +126,53 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
         }
         TraceOn();
         break;
+      case 'w':
+      case 'S':
+        if (!tracing_possible_) {
+          std::cerr << "ERROR: Tracing has not been enabled at compile time."
+                    << std::endl;
+          exit_app = true;
+          return false;
+        }
+        if (c == 'S') {
+          trace_scopes_.push_back(optarg);
+        } else if (!ParseTraceWindow(optarg)) {
+          exit_app = true;
+          return false;
+        }
+        break;
       case 'c':
         term_after_cycles_ = atoi(optarg);
         break;
+      case 's':
+      case 'R':
+        if (!checkpoint_possible_) {
+          std::cerr << "ERROR: Checkpointing has not been enabled at compile "
+                       "time."
+                    << std::endl;
+          exit_app = true;
+          return false;
+        }
+        if (c == 'R') {
+          restore_checkpoint_file_ = optarg;
+        } else if (strcmp(optarg, "event_trigger") == 0) {
+          if (!sig_event_trigger_) {
+            std::cerr << "ERROR: No event trigger signal has been set."
+                      << std::endl;
+            exit_app = true;
+            return false;
+          }
+          checkpoint_on_event_ = true;
+        } else {
+          checkpoint_cycle_ = strtoul(optarg, nullptr, 0);
+        }
+        break;
+      case 'b':
+        batch_manifest_ = optarg;
+        break;
+      case 'p':
+        report_file_ = optarg;
+        break;
       case 'h':
         PrintHelp();
         exit_app = true;
@@ -106,10 +188,19 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
     }
   }
 
+  // With a trace window, tracing starts when the window opens
+  if (trace_window_ != TraceWindowNone) {
+    tracing_enabled_ = false;
+    tracing_ever_enabled_ = false;
+    tracing_enabled_changed_ = false;
+  }
+
   // Pass args to verilator
   Verilated::commandArgs(argc, argv);
 
-  // Parse arguments for all registered extensions
+  // Parse arguments for all registered extensions. This also loads the
+  // memory images, so keep track of the time spent here.
+  time_load_begin_ = std::chrono::steady_clock::now();
   for (auto it = extension_array_.begin(); it != extension_array_.end(); ++it) {
     if (!(*it)->ParseCLIArguments(argc, argv, exit_app)) {
       exit_app = true;
@@ -119,6 +210,15 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
       }
     }
   }
+  time_load_end_ = std::chrono::steady_clock::now();
+
+  // Restore the model after the extensions loaded the memory images, so that
+  // the memories hold the checkpointed state and not the initial image
+  if (!exit_app && !restore_checkpoint_file_.empty() &&
+      !RestoreCheckpoint(restore_checkpoint_file_)) {
+    exit_app = true;
+    return false;
+  }
   return true;
 }
 
@@ -143,6 +243,10 @@ void VerilatorSimCtrl::RunSimulation() {
   }
   // Print simulation speed info
   PrintStatistics();
+  // Batch runs are reported one by one
+  if (batch_manifest_.empty()) {
+    WriteReport();
+  }
   // Print helper message for tracing
   if (TracingEverEnabled()) {
     std::cout << std::endl
@@ -170,11 +274,22 @@ void VerilatorSimCtrl::RegisterExtension(SimCtrlExtension *ext) {
 
 VerilatorSimCtrl::VerilatorSimCtrl()
     : top_(nullptr),
+      sig_event_trigger_(nullptr),
+      sig_cnt_en_(nullptr),
+      sig_exit_(nullptr),
       time_(0),
+      time_restored_(0),
       tracing_enabled_(false),
       tracing_enabled_changed_(false),
       tracing_ever_enabled_(false),
       tracing_possible_(VM_TRACE),
+      trace_window_(TraceWindowNone),
+      trace_window_open_(false),
+      checkpoint_possible_(VM_SAVABLE),
+      checkpoint_on_event_(false),
+      checkpoint_saved_(false),
+      checkpoint_cycle_(0),
+      report_file_("sim_report.json"),
       initial_reset_delay_cycles_(2),
       reset_duration_cycles_(2),
       request_stop_(false),
@@ -214,9 +329,43 @@ void VerilatorSimCtrl::PrintHelp() const {
   std::cout << "Execute a simulation model for " << GetName() << "\n\n";
   if (tracing_possible_) {
     std::cout << "-t|--trace\n"
-                 "  Write a trace file from the start\n\n";
+                 "  Write a trace file from the start\n\n"
+                 "--trace-window=A:B[,C:D...]|event_trigger|hw_cnt_en\n"
+                 "  Only trace the cycles in [A, B) (B can be omitted), "
+                 "between software\n"
+                 "  setting event_trigger to 1 and to -1, or while hw_cnt_en "
+                 "is set\n\n"
+                 "--trace-scope=HIER\n"
+                 "  Only trace the signals below HIER, e.g.,\n"
+                 "  TOP.ara_tb_verilator.dut.i_ara_soc.i_system.i_ara.i_vlsu."
+                 " Can be repeated\n\n";
   }
-  std::cout << "-c|--term-after-cycles=N\n"
+  if (checkpoint_possible_) {
+    std::cout << "--save-checkpoint-at=N|event_trigger\n"
+                 "  Save the model state to "
+              << GetCheckpointFileName()
+              << " at cycle N, or when software\n"
+                 "  sets event_trigger to 1\n\n"
+                 "--restore-checkpoint=FILE\n"
+                 "  Restore the model state from FILE before running. The "
+                 "memory images\n"
+                 "  must be the ones of the run that saved FILE\n\n";
+  }
+  std::cout << "--batch=FILE\n"
+               "  Run, one after the other, the ELF files listed in FILE (one "
+               "per line),\n"
+               "  resetting the design and reloading the memories before "
+               "each run.\n"
+               "  The results are written to "
+            << GetBatchReportFileName()
+            << "\n\n"
+               "--report=FILE\n"
+               "  Write the performance report to FILE (default: "
+            << report_file_
+            << ").\n"
+               "  The report is in CSV if FILE ends in .csv, in JSON "
+               "otherwise\n\n"
+               "-c|--term-after-cycles=N\n"
                "  Terminate simulation after N cycles\n\n"
                "-h|--help\n"
                "  Show help\n\n"
@@ -236,6 +385,76 @@ bool VerilatorSimCtrl::TraceOn() {
   return tracing_enabled_;
 }
 
+bool VerilatorSimCtrl::ParseTraceWindow(const std::string &spec) {
+  if (spec == "event_trigger" || spec == "hw_cnt_en") {
+    bool event = spec == "event_trigger";
+    if (!(event ? sig_event_trigger_ : sig_cnt_en_)) {
+      std::cerr << "ERROR: No " << spec << " signal has been set."
+                << std::endl;
+      return false;
+    }
+    trace_window_ = event ? TraceWindowEventTrigger : TraceWindowCounterEnable;
+    return true;
+  }
+
+  std::istringstream ranges(spec);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    size_t colon = range.find(':');
+    if (colon == std::string::npos || colon == 0) {
+      std::cerr << "ERROR: Invalid trace window `" << range
+                << "', expected A:B." << std::endl;
+      return false;
+    }
+    unsigned long begin = strtoul(range.c_str(), nullptr, 0);
+    unsigned long end = colon + 1 < range.size()
+                            ? strtoul(range.c_str() + colon + 1, nullptr, 0)
+                            : ULONG_MAX;
+    if (end <= begin) {
+      std::cerr << "ERROR: Empty trace window `" << range << "'."
+                << std::endl;
+      return false;
+    }
+    trace_window_cycles_.emplace_back(begin, end);
+  }
+  trace_window_ = TraceWindowCycles;
+  return true;
+}
+
+void VerilatorSimCtrl::UpdateTraceWindow() {
+  bool open = false;
+  switch (trace_window_) {
+    case TraceWindowNone:
+      return;
+    case TraceWindowCycles:
+      for (const auto &range : trace_window_cycles_) {
+        open |= time_ / 2 >= range.first && time_ / 2 < range.second;
+      }
+      break;
+    case TraceWindowEventTrigger:
+      // Same convention as the VCD dump of the QuestaSim testbench
+      open = trace_window_open_;
+      if (*sig_event_trigger_ == 1) {
+        open = true;
+      } else if (*sig_event_trigger_ == ~0ULL) {
+        open = false;
+      }
+      break;
+    case TraceWindowCounterEnable:
+      open = *sig_cnt_en_ & 1;
+      break;
+  }
+
+  if (open != trace_window_open_) {
+    trace_window_open_ = open;
+    if (open) {
+      TraceOn();
+    } else {
+      TraceOff();
+    }
+  }
+}
+
 bool VerilatorSimCtrl::TraceOff() {
   if (tracing_enabled_) {
     tracing_enabled_changed_ = true;
@@ -245,7 +464,9 @@ bool VerilatorSimCtrl::TraceOff() {
 }
 
 void VerilatorSimCtrl::PrintStatistics() const {
-  double speed_hz = time_ / 2 / (GetExecutionTimeMs() / 1000.0);
+  // Cycles restored from a checkpoint were not simulated by this run
+  double speed_hz =
+      (time_ - time_restored_) / 2 / (GetExecutionTimeMs() / 1000.0);
   double speed_khz = speed_hz / 1000.0;
 
   std::cout << std::endl
@@ -255,12 +476,65 @@ void VerilatorSimCtrl::PrintStatistics() const {
             << "Wallclock time:   " << GetExecutionTimeMs() / 1000.0 << " s"
             << std::endl
             << "Simulation speed: " << speed_hz << " cycles/s "
-            << "(" << speed_khz << " kHz)" << std::endl;
+            << "(" << speed_khz << " kHz)" << std::endl
+            << "Memory load time: " << GetLoadTimeMs() / 1000.0 << " s"
+            << std::endl;
 
   int trace_size_byte;
-  if (tracing_enabled_ && FileSize(GetTraceFileName(), trace_size_byte)) {
+  if (TracingEverEnabled() &&
+      FileSize(GetTraceFileName(), trace_size_byte)) {
     std::cout << "Trace file size:  " << trace_size_byte << " B" << std::endl;
   }
+
+  PrintThreadStatistics();
+}
+
+void VerilatorSimCtrl::PrintThreadStatistics() const {
+  std::cout << "Model threads:    " << Verilated::threadContextp()->threads()
+            << std::endl;
+
+  // The kernel accounts the CPU time of each thread over its whole lifetime,
+  // i.e., also while the memories are loaded
+  double wallclock_s = (GetLoadTimeMs() + GetExecutionTimeMs()) / 1000.0;
+  double ticks_per_s = sysconf(_SC_CLK_TCK);
+  if (wallclock_s <= 0 || ticks_per_s <= 0) {
+    return;
+  }
+
+  DIR *dir = opendir("/proc/self/task");
+  if (!dir) {
+    return;
+  }
+  while (struct dirent *entry = readdir(dir)) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    }
+    std::ifstream stat_file(std::string("/proc/self/task/") + entry->d_name +
+                            "/stat");
+    std::string stat;
+    if (!std::getline(stat_file, stat)) {
+      continue;
+    }
+    // The thread name can contain spaces: skip it, then skip the fields that
+    // precede utime (14th field) and stime (15th field)
+    size_t name_end = stat.rfind(')');
+    if (name_end == std::string::npos) {
+      continue;
+    }
+    std::istringstream fields(stat.substr(name_end + 1));
+    std::string skip;
+    for (int i = 3; i < 14; ++i) {
+      fields >> skip;
+    }
+    unsigned long utime, stime;
+    if (!(fields >> utime >> stime)) {
+      continue;
+    }
+    double cpu_s = (utime + stime) / ticks_per_s;
+    std::cout << "Thread " << entry->d_name << " utilization: "
+              << 100.0 * cpu_s / wallclock_s << " %" << std::endl;
+  }
+  closedir(dir);
 }
 
 const char *VerilatorSimCtrl::GetTraceFileName() const {
@@ -271,6 +545,80 @@ const char *VerilatorSimCtrl::GetTraceFileName() const {
 #endif
 }
 
+const char *VerilatorSimCtrl::GetBatchReportFileName() const {
+  return "batch.jsonl";
+}
+
+const char *VerilatorSimCtrl::GetCheckpointFileName() const {
+  return "sim.ckpt";
+}
+
+void VerilatorSimCtrl::Checkpoint() {
+  if (checkpoint_saved_) {
+    return;
+  }
+
+  bool cycle_reached = checkpoint_cycle_ && (time_ / 2 >= checkpoint_cycle_);
+  bool event_reached = checkpoint_on_event_ && (*sig_event_trigger_ == 1);
+  if (!cycle_reached && !event_reached) {
+    return;
+  }
+
+  SaveCheckpoint(GetCheckpointFileName());
+  checkpoint_saved_ = true;
+  std::cout << "Saved checkpoint at cycle " << time_ / 2 << " to "
+            << GetCheckpointFileName() << std::endl;
+}
+
+void VerilatorSimCtrl::SaveCheckpoint(const char *filepath) {
+#if VM_SAVABLE == 1
+  VerilatedSave os;
+  os.open(filepath);
+  // The clock parity is part of the simulation time, so store it as well
+  os.write(&time_, sizeof(time_));
+  // Identify the memory images, so that the checkpoint is only restored
+  // together with the program that produced it
+  std::string images = GetImagesHash();
+  size_t images_len = images.size();
+  os.write(&images_len, sizeof(images_len));
+  os.write(images.data(), images_len);
+  top_->save(os);
+  os.close();
+#endif
+}
+
+bool VerilatorSimCtrl::RestoreCheckpoint(const std::string &filepath) {
+  int size_byte;
+  if (!FileSize(filepath, size_byte)) {
+    std::cerr << "ERROR: Cannot open checkpoint file `" << filepath << "'."
+              << std::endl;
+    return false;
+  }
+
+#if VM_SAVABLE == 1
+  VerilatedRestore os;
+  os.open(filepath.c_str());
+  os.read(&time_, sizeof(time_));
+  size_t images_len;
+  os.read(&images_len, sizeof(images_len));
+  std::string images(images_len, '\0');
+  os.read(&images[0], images_len);
+  if (images != GetImagesHash()) {
+    std::cerr << "ERROR: Checkpoint file `" << filepath
+              << "' was saved with different memory images." << std::endl;
+    os.close();
+    return false;
+  }
+  top_->restore(os);
+  os.close();
+#endif
+  time_restored_ = time_;
+
+  std::cout << "Restored checkpoint from `" << filepath << "' at cycle "
+            << time_ / 2 << std::endl;
+  return true;
+}
+
 void VerilatorSimCtrl::Run() {
   assert(top_ && "Use SetTop() first.");
 
@@ -291,7 +639,211 @@ void VerilatorSimCtrl::Run() {
   time_begin_ = std::chrono::steady_clock::now();
   UnsetReset();
 
-  unsigned long start_reset_cycle_ = initial_reset_delay_cycles_;
+  if (batch_manifest_.empty()) {
+    Simulate(initial_reset_delay_cycles_);
+  } else {
+    RunBatch();
+  }
+
+  top_->final();
+  time_end_ = std::chrono::steady_clock::now();
+
+  if (TracingEverEnabled()) {
+    tracer_.close();
+  }
+}
+
+void VerilatorSimCtrl::RunBatch() {
+  std::ifstream manifest(batch_manifest_);
+  std::ofstream report(GetBatchReportFileName());
+  if (!manifest.is_open() || !report.is_open()) {
+    std::cerr << "ERROR: Cannot open batch manifest `" << batch_manifest_
+              << "' or report `" << GetBatchReportFileName() << "'."
+              << std::endl;
+    simulation_success_ = false;
+    return;
+  }
+
+  std::string image;
+  while (std::getline(manifest, image)) {
+    // Skip empty lines and comments
+    if (image.empty() || image[0] == '#') {
+      continue;
+    }
+
+    std::cout << std::endl << "Batch run: " << image << std::endl;
+
+    bool image_loaded = true;
+    for (auto it = extension_array_.begin(); it != extension_array_.end();
+         ++it) {
+      image_loaded &= (*it)->LoadImage(image);
+    }
+
+    // Every run starts with a fresh reset sequence
+    request_stop_ = false;
+    bool batch_success = simulation_success_;
+    simulation_success_ = true;
+    Verilated::gotFinish(false);
+
+    unsigned long start_time = time_;
+    auto run_begin = std::chrono::steady_clock::now();
+    if (image_loaded) {
+      Simulate(time_ / 2 + initial_reset_delay_cycles_);
+    }
+    auto run_end = std::chrono::steady_clock::now();
+
+    bool run_success =
+        image_loaded && simulation_success_ && Verilated::gotFinish();
+    unsigned long run_cycles = (time_ - start_time) / 2;
+    report << FormatJson(GetReportFields(
+                  run_success, run_cycles, run_cycles,
+                  std::chrono::duration_cast<std::chrono::milliseconds>(
+                      run_end - run_begin)
+                      .count()))
+           << std::endl;
+
+    simulation_success_ = batch_success && run_success;
+    // A stop requested by the user (CTRL-c) ends the whole batch
+    if (request_stop_ && !Verilated::gotFinish()) {
+      break;
+    }
+  }
+
+  std::cout << "Batch results written to " << GetBatchReportFileName()
+            << std::endl;
+}
+
+std::vector<VerilatorSimCtrl::ReportField> VerilatorSimCtrl::GetReportFields(
+    bool success, unsigned long cycles, unsigned long simulated_cycles,
+    unsigned int wallclock_ms) const {
+  std::vector<ReportField> fields;
+
+  for (const auto &param : configuration_) {
+    fields.push_back({param.first, std::to_string(param.second), false});
+  }
+
+  // Multiple images are separated by semicolons
+  std::string elf, elf_hash;
+  for (const std::string &image : GetLoadedImages()) {
+    elf += (elf.empty() ? "" : ";") + image;
+    elf_hash += (elf_hash.empty() ? "" : ";") + HashFile(image);
+  }
+  fields.push_back({"elf", elf, true});
+  fields.push_back({"elf_hash", elf_hash, true});
+
+  fields.push_back({"success", success ? "true" : "false", false});
+  if (sig_exit_) {
+    fields.push_back({"exit_code", std::to_string(*sig_exit_ >> 1), false});
+  }
+  for (const auto &counter : counters_) {
+    fields.push_back({counter.first, std::to_string(*counter.second), false});
+  }
+
+  // The speed only accounts for the cycles simulated by this run
+  double speed_hz =
+      wallclock_ms ? simulated_cycles / (wallclock_ms / 1000.0) : 0.0;
+  fields.push_back({"cycles", std::to_string(cycles), false});
+  fields.push_back({"wallclock_ms", std::to_string(wallclock_ms), false});
+  fields.push_back({"speed_hz", std::to_string(speed_hz), false});
+  return fields;
+}
+
+void VerilatorSimCtrl::WriteReport() const {
+  std::ofstream report(report_file_);
+  if (!report.is_open()) {
+    std::cerr << "ERROR: Cannot open report `" << report_file_ << "'."
+              << std::endl;
+    return;
+  }
+
+  // Cycles restored from a checkpoint were not simulated by this run
+  std::vector<ReportField> fields =
+      GetReportFields(simulation_success_ && Verilated::gotFinish(),
+                      time_ / 2, (time_ - time_restored_) / 2,
+                      GetExecutionTimeMs());
+
+  const std::string csv_ext = ".csv";
+  bool csv = report_file_.size() >= csv_ext.size() &&
+             report_file_.compare(report_file_.size() - csv_ext.size(),
+                                  csv_ext.size(), csv_ext) == 0;
+  if (csv) {
+    for (size_t i = 0; i < fields.size(); ++i) {
+      report << (i ? "," : "") << fields[i].name;
+    }
+    report << std::endl;
+    for (size_t i = 0; i < fields.size(); ++i) {
+      report << (i ? "," : "") << fields[i].value;
+    }
+    report << std::endl;
+  } else {
+    report << FormatJson(fields) << std::endl;
+  }
+
+  std::cout << "Performance report written to " << report_file_ << std::endl;
+}
+
+std::string VerilatorSimCtrl::FormatJson(
+    const std::vector<ReportField> &fields) {
+  std::ostringstream oss;
+  oss << "{";
+  for (size_t i = 0; i < fields.size(); ++i) {
+    oss << (i ? ", " : "") << "\"" << fields[i].name << "\": ";
+    if (!fields[i].is_string) {
+      oss << fields[i].value;
+      continue;
+    }
+    oss << "\"";
+    for (char c : fields[i].value) {
+      if (c == '"' || c == '\\') {
+        oss << '\\';
+      }
+      oss << c;
+    }
+    oss << "\"";
+  }
+  oss << "}";
+  return oss.str();
+}
+
+std::vector<std::string> VerilatorSimCtrl::GetLoadedImages() const {
+  std::vector<std::string> images;
+  for (auto it = extension_array_.begin(); it != extension_array_.end(); ++it) {
+    for (const std::string &image : (*it)->GetLoadedImages()) {
+      images.push_back(image);
+    }
+  }
+  return images;
+}
+
+std::string VerilatorSimCtrl::GetImagesHash() const {
+  std::string images_hash;
+  for (const std::string &image : GetLoadedImages()) {
+    images_hash += (images_hash.empty() ? "" : ";") + HashFile(image);
+  }
+  return images_hash;
+}
+
+std::string VerilatorSimCtrl::HashFile(const std::string &filepath) {
+  std::ifstream file(filepath, std::ios::binary);
+  if (!file.is_open()) {
+    return "";
+  }
+
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  char buf[4096];
+  while (file.read(buf, sizeof(buf)) || file.gcount()) {
+    for (std::streamsize i = 0; i < file.gcount(); ++i) {
+      hash ^= static_cast<uint8_t>(buf[i]);
+      hash *= 0x100000001b3ULL;
+    }
+  }
+
+  std::ostringstream oss;
+  oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return oss.str();
+}
+
+void VerilatorSimCtrl::Simulate(unsigned long start_reset_cycle_) {
   unsigned long end_reset_cycle_ = start_reset_cycle_ + reset_duration_cycles_;
 
   while (1) {
@@ -317,6 +869,7 @@ void VerilatorSimCtrl::Run() {
     time_++;
 
     Trace();
+    Checkpoint();
 
     if (request_stop_) {
       std::cout << "Received stop request, shutting down simulation."
@@ -334,13 +887,6 @@ void VerilatorSimCtrl::Run() {
       break;
     }
   }
-
-  top_->final();
-  time_end_ = std::chrono::steady_clock::now();
-
-  if (TracingEverEnabled()) {
-    tracer_.close();
-  }
 }
 
 std::string VerilatorSimCtrl::GetName() const {
@@ -356,6 +902,12 @@ unsigned int VerilatorSimCtrl::GetExecutionTimeMs() const {
       .count();
 }
 
+unsigned int VerilatorSimCtrl::GetLoadTimeMs() const {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(time_load_end_ -
+                                                               time_load_begin_)
+      .count();
+}
+
 void VerilatorSimCtrl::SetReset() {
   if (flags_ & ResetPolarityNegative) {
     *sig_rst_ = 0;
@@ -384,6 +936,8 @@ bool VerilatorSimCtrl::FileSize(std::string filepath, int &size_byte) const {
 }
 
 void VerilatorSimCtrl::Trace() {
+  UpdateTraceWindow();
+
   // We cannot output a message when calling TraceOn()/TraceOff() as these
   // functions can be called from a signal handler. Instead we print the message
   // here from the main loop.
@@ -401,6 +955,10 @@ void VerilatorSimCtrl::Trace() {
   }
 
   if (!tracer_.isOpen()) {
+    // The scopes select the signals declared when the trace file is opened
+    for (const std::string &scope : trace_scopes_) {
+      tracer_.dumpvars(99, scope);
+    }
     tracer_.open(GetTraceFileName());
     std::cout << "Writing simulation traces to " << GetTraceFileName()
               << std::endl;
@@ -7,6 +7,7 @@
 
 #include <chrono>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "sim_ctrl_extension.h"
@@ -38,6 +39,46 @@ class VerilatorSimCtrl {
   void SetTop(VerilatedToplevel *top, CData *sig_clk, CData *sig_rst,
               VerilatorSimCtrlFlags flags = Defaults);
 
+  /**
+   * Set the software-controlled event signal
+   *
+   * The simulation can save a checkpoint when software sets this signal to 1
+   * (see --save-checkpoint-at).
+   */
+  void SetEventTrigger(QData *sig_event_trigger);
+
+  /**
+   * Set the software-controlled counter enable signal
+   *
+   * Tracing can be restricted to the cycles in which bit 0 of this signal is
+   * set (see --trace-window).
+   */
+  void SetCounterEnable(QData *sig_cnt_en);
+
+  /**
+   * Set the exit signal of the design
+   *
+   * Bit 0 of the signal flags the end of the program, the upper bits hold its
+   * exit code. The exit code of each run is part of the batch results.
+   */
+  void SetExitSignal(QData *sig_exit);
+
+  /**
+   * Register a performance counter of the design
+   *
+   * The value of the counter at the end of the simulation is part of the
+   * performance report (see --report) and of the batch results.
+   */
+  void RegisterCounter(const std::string &name, QData *sig_counter);
+
+  /**
+   * Set a configuration parameter of the design, e.g., its number of lanes
+   *
+   * Configuration parameters are part of the performance report and of the
+   * batch results.
+   */
+  void SetConfiguration(const std::string &name, unsigned long value);
+
   /**
    * Setup and run the simulation (all in one)
    *
@@ -113,21 +154,59 @@ class VerilatorSimCtrl {
   unsigned long GetTime() const { return time_; }
 
  private:
+  /**
+   * A field of the performance report
+   */
+  struct ReportField {
+    std::string name;
+    std::string value;
+    bool is_string;
+  };
+
+  /**
+   * What drives tracing on and off during the simulation
+   */
+  enum TraceWindowMode {
+    TraceWindowNone,
+    TraceWindowCycles,
+    TraceWindowEventTrigger,
+    TraceWindowCounterEnable,
+  };
+
   VerilatedToplevel *top_;
   CData *sig_clk_;
   CData *sig_rst_;
+  QData *sig_event_trigger_;
+  QData *sig_cnt_en_;
+  QData *sig_exit_;
   VerilatorSimCtrlFlags flags_;
   unsigned long time_;
+  unsigned long time_restored_;
   bool tracing_enabled_;
   bool tracing_enabled_changed_;
   bool tracing_ever_enabled_;
   bool tracing_possible_;
+  TraceWindowMode trace_window_;
+  std::vector<std::pair<unsigned long, unsigned long>> trace_window_cycles_;
+  bool trace_window_open_;
+  std::vector<std::string> trace_scopes_;
+  bool checkpoint_possible_;
+  bool checkpoint_on_event_;
+  bool checkpoint_saved_;
+  unsigned long checkpoint_cycle_;
+  std::string restore_checkpoint_file_;
+  std::string batch_manifest_;
+  std::string report_file_;
+  std::vector<std::pair<std::string, QData *>> counters_;
+  std::vector<std::pair<std::string, unsigned long>> configuration_;
   unsigned int initial_reset_delay_cycles_;
   unsigned int reset_duration_cycles_;
   volatile unsigned int request_stop_;
   volatile bool simulation_success_;
   std::chrono::steady_clock::time_point time_begin_;
   std::chrono::steady_clock::time_point time_end_;
+  std::chrono::steady_clock::time_point time_load_begin_;
+  std::chrono::steady_clock::time_point time_load_end_;
   VerilatedTracer tracer_;
   int term_after_cycles_;
   std::vector<SimCtrlExtension *> extension_array_;
@@ -190,16 +269,60 @@ class VerilatorSimCtrl {
    */
   bool TracingPossible() const { return tracing_possible_; }
 
+  /**
+   * Parse the argument of --trace-window
+   *
+   * @return Return code, true == success
+   */
+  bool ParseTraceWindow(const std::string &spec);
+
+  /**
+   * Turn tracing on or off when the simulation enters or leaves the trace
+   * window
+   *
+   * Tracing is only switched on the edges of the window, so that it can still
+   * be toggled with SIGUSR1 in between.
+   */
+  void UpdateTraceWindow();
+
   /**
    * Print statistics about the simulation run
    */
   void PrintStatistics() const;
 
+  /**
+   * Print the number of model threads and the CPU utilization of each thread
+   */
+  void PrintThreadStatistics() const;
+
   /**
    * Get the file name of the trace file
    */
   const char *GetTraceFileName() const;
 
+  /**
+   * Get the file name of the checkpoint file
+   */
+  const char *GetCheckpointFileName() const;
+
+  /**
+   * Save a checkpoint of the model state if requested
+   */
+  void Checkpoint();
+
+  /**
+   * Save the model state, including the memories, to |filepath|
+   */
+  void SaveCheckpoint(const char *filepath);
+
+  /**
+   * Restore the model state from |filepath|, which must have been saved with
+   * the memory images loaded by the current run
+   *
+   * @return Return code, true == success
+   */
+  bool RestoreCheckpoint(const std::string &filepath);
+
   /**
    * Run the main loop of the simulation
    *
@@ -207,6 +330,64 @@ class VerilatorSimCtrl {
    */
   void Run();
 
+  /**
+   * Simulate from the current time until a stop condition is met, asserting
+   * the reset at cycle |start_reset_cycle_|
+   */
+  void Simulate(unsigned long start_reset_cycle_);
+
+  /**
+   * Run all the images listed in the batch manifest, resetting the design
+   * before each of them, and write one result record per run
+   */
+  void RunBatch();
+
+  /**
+   * Get the file name of the batch results
+   */
+  const char *GetBatchReportFileName() const;
+
+  /**
+   * Collect the fields of the performance report of a run
+   *
+   * The report holds the configuration, the loaded images and their hashes,
+   * the exit status, the design counters, and the simulation statistics.
+   */
+  std::vector<ReportField> GetReportFields(bool success,
+                                           unsigned long cycles,
+                                           unsigned long simulated_cycles,
+                                           unsigned int wallclock_ms) const;
+
+  /**
+   * Write the performance report of the simulation
+   *
+   * The report is written in CSV if its file name ends in .csv, and in JSON
+   * otherwise.
+   */
+  void WriteReport() const;
+
+  /**
+   * Format the fields of a report as a single-line JSON object
+   */
+  static std::string FormatJson(const std::vector<ReportField> &fields);
+
+  /**
+   * Get the files loaded by the extensions for the current run
+   */
+  std::vector<std::string> GetLoadedImages() const;
+
+  /**
+   * Get the hashes of the files loaded by the extensions, separated by ';'
+   */
+  std::string GetImagesHash() const;
+
+  /**
+   * Compute the 64-bit FNV-1a hash of a file, as a hex string
+   *
+   * @return The hash, or an empty string if the file cannot be read
+   */
+  static std::string HashFile(const std::string &filepath);
+
   /**
    * Get a name for this simulation
    *
@@ -219,6 +400,12 @@ class VerilatorSimCtrl {
    */
   unsigned int GetExecutionTimeMs() const;
 
+  /**
+   * Get the wallclock time in ms spent by the extensions to parse their
+   * arguments, i.e., mostly to preload the memories
+   */
+  unsigned int GetLoadTimeMs() const;
+
   /**
    * Assert the reset signal
    */
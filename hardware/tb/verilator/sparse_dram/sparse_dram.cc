@@ -0,0 +1,81 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// DPI functions of the sparse main memory (tb/ara_sparse_dram.sv).
+// They are only linked into models verilated with sparse_dram=1.
+//
+// The memory is split in pages, which are only allocated when they are first
+// written. Pages that were never written read as zero. Each instance of the
+// memory keeps its pages in the user data of its DPI scope.
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <svdpi.h>
+#include <unordered_map>
+
+namespace {
+
+// Memory words are at most 64 bytes wide and aligned, so they never cross a
+// page boundary
+const uint64_t kPageSize = 1 << 16;
+
+class SparseDram {
+ public:
+  void Read(uint64_t offset, int size, uint8_t *data) const {
+    auto it = pages_.find(offset / kPageSize);
+    if (it == pages_.end()) {
+      memset(data, 0, size);
+    } else {
+      memcpy(data, it->second.get() + offset % kPageSize, size);
+    }
+  }
+
+  void Write(uint64_t offset, int size, const uint8_t *data,
+             const uint8_t *strb) {
+    std::unique_ptr<uint8_t[]> &page = pages_[offset / kPageSize];
+    if (!page) {
+      page.reset(new uint8_t[kPageSize]());
+    }
+    uint8_t *dst = page.get() + offset % kPageSize;
+    for (int i = 0; i < size; ++i) {
+      if (strb[i / 8] & (1 << (i % 8))) {
+        dst[i] = data[i];
+      }
+    }
+  }
+
+ private:
+  std::unordered_map<uint64_t, std::unique_ptr<uint8_t[]>> pages_;
+};
+
+// Key of the memory in the user data of the DPI scope
+const int kUserDataKey = 0;
+
+SparseDram &GetDram() {
+  svScope scope = svGetScope();
+  void *dram = svGetUserData(scope, (void *)&kUserDataKey);
+  if (!dram) {
+    dram = new SparseDram();
+    svPutUserData(scope, (void *)&kUserDataKey, dram);
+  }
+  return *static_cast<SparseDram *>(dram);
+}
+
+}  // namespace
+
+extern "C" {
+
+void ara_sparse_dram_read(long long offset, int size, svBitVecVal *data) {
+  // The data words are little endian, like the host
+  GetDram().Read(offset, size, reinterpret_cast<uint8_t *>(data));
+}
+
+void ara_sparse_dram_write(long long offset, int size, const svBitVecVal *data,
+                           const svBitVecVal *strb) {
+  GetDram().Write(offset, size, reinterpret_cast<const uint8_t *>(data),
+                  reinterpret_cast<const uint8_t *>(strb));
+}
+}
@@ -0,0 +1,84 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// DPI functions of the vector instruction tracer (tb/ara_vinsn_tracer.sv).
+// They are only linked into models verilated with vinsn_trace=1.
+
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "vinsn_trace.h"
+
+namespace {
+
+struct PeTimes {
+  int pe;
+  long long t_start;
+  long long t_done;
+};
+
+FILE *trace_file = nullptr;
+// Buffer of the trace file, so that the simulation does not wait on the disk
+std::vector<char> trace_buffer(1 << 20);
+// Processing elements of the instruction that is being recorded
+std::vector<PeTimes> insn_pes;
+
+}  // namespace
+
+extern "C" {
+
+void ara_vtrace_open(const char *filename, int nr_lanes) {
+  trace_file = fopen(filename, "wb");
+  if (!trace_file) {
+    std::cerr << "ERROR: Cannot open vector instruction trace `" << filename
+              << "'." << std::endl;
+    return;
+  }
+  setvbuf(trace_file, trace_buffer.data(), _IOFBF, trace_buffer.size());
+
+  VinsnTraceHeader header = {.magic = kVinsnTraceMagic,
+                             .nr_lanes = static_cast<uint32_t>(nr_lanes)};
+  fwrite(&header, sizeof(header), 1, trace_file);
+  std::cout << "Writing vector instruction trace to " << filename << std::endl;
+}
+
+void ara_vtrace_pe(int pe, long long t_start, long long t_done) {
+  insn_pes.push_back({pe, t_start, t_done});
+}
+
+void ara_vtrace_insn(int vid, int vfu, int insn, long long pc,
+                     long long t_dispatch, long long t_accept,
+                     long long t_done) {
+  if (trace_file) {
+    VinsnTraceInsn record = {};
+    record.pc = pc;
+    record.t_dispatch = t_dispatch;
+    record.t_accept = t_accept;
+    record.t_done = t_done;
+    record.insn = insn;
+    record.vid = vid;
+    record.vfu = vfu;
+    record.nr_pes = insn_pes.size();
+    fwrite(&record, sizeof(record), 1, trace_file);
+
+    for (const PeTimes &p : insn_pes) {
+      VinsnTracePe pe_record = {};
+      pe_record.pe = p.pe;
+      pe_record.start = p.t_start - t_accept;
+      pe_record.done = p.t_done - t_accept;
+      fwrite(&pe_record, sizeof(pe_record), 1, trace_file);
+    }
+  }
+  insn_pes.clear();
+}
+
+void ara_vtrace_close() {
+  if (trace_file) {
+    fclose(trace_file);
+    trace_file = nullptr;
+  }
+}
+}
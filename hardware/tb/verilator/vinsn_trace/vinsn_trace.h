@@ -0,0 +1,72 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Binary format of the vector instruction trace, shared by the DPI writer
+// (vinsn_trace.cc) and the host-side analyser (vinsn_trace_analyse.cc).
+//
+// The file starts with a VinsnTraceHeader. Each vector instruction that
+// reached Ara's sequencer is then described by a VinsnTraceInsn record,
+// followed by one VinsnTracePe record for each processing element that ran it.
+// All the timestamps are clock cycles since the end of the reset.
+
+#ifndef ARA_VINSN_TRACE_H_
+#define ARA_VINSN_TRACE_H_
+
+#include <cstdint>
+
+// "AVT1", little endian
+static const uint32_t kVinsnTraceMagic = 0x31545641;
+
+// Ara's processing elements are the lanes, followed by these global units
+enum VinsnTracePeOffset {
+  kPeOffsetLoad = 0,
+  kPeOffsetStore = 1,
+  kPeOffsetMask = 2,
+  kPeOffsetSlide = 3,
+  kNrPeOffsets = 4
+};
+
+// Same order as ara_pkg::vfu_e
+enum VinsnTraceVfu {
+  kVfuAlu = 0,
+  kVfuMFpu = 1,
+  kVfuSlideUnit = 2,
+  kVfuMaskUnit = 3,
+  kVfuLoadUnit = 4,
+  kVfuStoreUnit = 5,
+  kVfuNone = 6,
+  kNrVfus = 7
+};
+
+struct __attribute__((packed)) VinsnTraceHeader {
+  uint32_t magic;
+  uint32_t nr_lanes;
+};
+
+struct __attribute__((packed)) VinsnTraceInsn {
+  uint64_t pc;
+  // Cycle in which Ara's dispatcher took the instruction from CVA6
+  uint64_t t_dispatch;
+  // Cycle in which the sequencer accepted the instruction
+  uint64_t t_accept;
+  // Cycle in which the last processing element committed the instruction
+  uint64_t t_done;
+  uint32_t insn;
+  uint8_t vid;
+  uint8_t vfu;
+  uint8_t nr_pes;
+  uint8_t reserved;
+};
+
+struct __attribute__((packed)) VinsnTracePe {
+  uint8_t pe;
+  uint8_t reserved[3];
+  // Cycles after t_accept in which the processing element accepted and
+  // committed the instruction
+  uint32_t start;
+  uint32_t done;
+};
+
+#endif  // ARA_VINSN_TRACE_H_
@@ -0,0 +1,269 @@
+// Copyright 2021 ETH Zurich and University of Bologna.
+// Solderpad Hardware License, Version 0.51, see LICENSE for details.
+// SPDX-License-Identifier: SHL-0.51
+//
+// Description:
+// Analyser of the vector instruction traces written by the Verilator model.
+//
+// Usage: vinsn_trace_analyse [-i] <trace file>
+//
+// Reports the latency breakdown of the vector instructions, aggregated per PC,
+// and how much the functional units overlapped in time. With -i, the latency
+// of every single instruction is printed as well.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "vinsn_trace.h"
+
+namespace {
+
+const char *kVfuNames[kNrVfus] = {"valu",  "vmfpu", "sldu", "masku",
+                                  "vlsu-ld", "vlsu-st", "none"};
+
+struct PcStats {
+  uint64_t count = 0;
+  uint64_t issue_stall = 0;
+  uint64_t start_latency = 0;
+  uint64_t total_latency = 0;
+  uint64_t max_latency = 0;
+  uint32_t insn = 0;
+};
+
+// Interval [start, end) in which a functional unit was busy
+struct BusyInterval {
+  uint64_t start;
+  uint64_t end;
+};
+
+void Usage(const char *name) {
+  std::cerr << "Usage: " << name << " [-i] <trace file>" << std::endl
+            << "  -i  Print the latency of every instruction" << std::endl;
+}
+
+// Merge the overlapping intervals of a functional unit
+std::vector<BusyInterval> Merge(std::vector<BusyInterval> intervals) {
+  std::vector<BusyInterval> merged;
+  std::sort(intervals.begin(), intervals.end(),
+            [](const BusyInterval &a, const BusyInterval &b) {
+              return a.start < b.start;
+            });
+  for (const BusyInterval &i : intervals) {
+    if (!merged.empty() && i.start <= merged.back().end) {
+      merged.back().end = std::max(merged.back().end, i.end);
+    } else {
+      merged.push_back(i);
+    }
+  }
+  return merged;
+}
+
+uint64_t BusyCycles(const std::vector<BusyInterval> &merged) {
+  uint64_t cycles = 0;
+  for (const BusyInterval &i : merged) {
+    cycles += i.end - i.start;
+  }
+  return cycles;
+}
+
+// Cycles in which both functional units were busy
+uint64_t OverlapCycles(const std::vector<BusyInterval> &a,
+                       const std::vector<BusyInterval> &b) {
+  uint64_t cycles = 0;
+  size_t i = 0, j = 0;
+  while (i < a.size() && j < b.size()) {
+    uint64_t start = std::max(a[i].start, b[j].start);
+    uint64_t end = std::min(a[i].end, b[j].end);
+    if (start < end) {
+      cycles += end - start;
+    }
+    if (a[i].end < b[j].end) {
+      i++;
+    } else {
+      j++;
+    }
+  }
+  return cycles;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  bool print_insns = false;
+  const char *filename = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-i")) {
+      print_insns = true;
+    } else if (!filename) {
+      filename = argv[i];
+    } else {
+      Usage(argv[0]);
+      return 1;
+    }
+  }
+  if (!filename) {
+    Usage(argv[0]);
+    return 1;
+  }
+
+  FILE *trace_file = fopen(filename, "rb");
+  if (!trace_file) {
+    std::cerr << "ERROR: Cannot open `" << filename << "'." << std::endl;
+    return 1;
+  }
+
+  VinsnTraceHeader header;
+  if (fread(&header, sizeof(header), 1, trace_file) != 1 ||
+      header.magic != kVinsnTraceMagic) {
+    std::cerr << "ERROR: `" << filename
+              << "' is not a vector instruction trace." << std::endl;
+    fclose(trace_file);
+    return 1;
+  }
+
+  std::map<uint64_t, PcStats> pc_stats;
+  std::vector<BusyInterval> vfu_busy[kNrVfus];
+  uint64_t nr_insns = 0;
+  uint64_t t_first = UINT64_MAX;
+  uint64_t t_last = 0;
+
+  if (print_insns) {
+    std::cout << "pc,insn,vfu,t_accept,issue_stall,start_latency,"
+                 "exec_latency,total_latency"
+              << std::endl;
+  }
+
+  VinsnTraceInsn insn;
+  std::vector<VinsnTracePe> pes;
+  while (fread(&insn, sizeof(insn), 1, trace_file) == 1) {
+    pes.resize(insn.nr_pes);
+    if (insn.nr_pes &&
+        fread(pes.data(), sizeof(VinsnTracePe), insn.nr_pes, trace_file) !=
+            insn.nr_pes) {
+      std::cerr << "WARNING: Truncated trace." << std::endl;
+      break;
+    }
+
+    // The instruction starts executing when the first PE accepts it
+    uint64_t start = insn.t_done - insn.t_accept;
+    for (const VinsnTracePe &pe : pes) {
+      start = std::min<uint64_t>(start, pe.start);
+    }
+    uint64_t issue_stall = insn.t_accept - insn.t_dispatch;
+    uint64_t total_latency = insn.t_done - insn.t_dispatch;
+    uint64_t exec_latency = insn.t_done - insn.t_accept - start;
+
+    PcStats &stats = pc_stats[insn.pc];
+    stats.count++;
+    stats.issue_stall += issue_stall;
+    stats.start_latency += start;
+    stats.total_latency += total_latency;
+    stats.max_latency = std::max(stats.max_latency, total_latency);
+    stats.insn = insn.insn;
+
+    uint8_t vfu = insn.vfu < kNrVfus ? insn.vfu : uint8_t(kVfuNone);
+    vfu_busy[vfu].push_back({insn.t_accept + start, insn.t_done + 1});
+
+    t_first = std::min(t_first, insn.t_dispatch);
+    t_last = std::max(t_last, insn.t_done + 1);
+    nr_insns++;
+
+    if (print_insns) {
+      std::cout << "0x" << std::hex << insn.pc << ",0x" << std::setw(8)
+                << std::setfill('0') << insn.insn << std::dec
+                << std::setfill(' ') << "," << kVfuNames[vfu] << ","
+                << insn.t_accept << "," << issue_stall << "," << start << ","
+                << exec_latency << "," << total_latency << std::endl;
+    }
+  }
+  fclose(trace_file);
+
+  if (!nr_insns) {
+    std::cout << "No vector instructions in `" << filename << "'."
+              << std::endl;
+    return 0;
+  }
+  if (print_insns) {
+    std::cout << std::endl;
+  }
+
+  // Per-PC latency breakdown, sorted by PC
+  std::cout << "Vector instructions: " << nr_insns << " (" << header.nr_lanes
+            << " lanes, " << t_last - t_first << " cycles)" << std::endl
+            << std::endl;
+  std::cout << std::setw(18) << "pc" << std::setw(12) << "insn"
+            << std::setw(10) << "count" << std::setw(14) << "avg-stall"
+            << std::setw(14) << "avg-start" << std::setw(14) << "avg-lat"
+            << std::setw(14) << "max-lat" << std::endl;
+  for (const auto &it : pc_stats) {
+    const PcStats &stats = it.second;
+    std::cout << "0x" << std::hex << std::setw(16) << std::setfill('0')
+              << it.first << "  0x" << std::setw(8) << stats.insn << std::dec
+              << std::setfill(' ') << std::setw(10) << stats.count
+              << std::fixed << std::setprecision(1) << std::setw(14)
+              << double(stats.issue_stall) / stats.count << std::setw(14)
+              << double(stats.start_latency) / stats.count << std::setw(14)
+              << double(stats.total_latency) / stats.count << std::setw(14)
+              << stats.max_latency << std::endl;
+  }
+  std::cout << std::endl;
+
+  // Functional unit utilization and overlap
+  std::vector<BusyInterval> merged[kNrVfus];
+  for (int v = 0; v < kNrVfus; ++v) {
+    merged[v] = Merge(vfu_busy[v]);
+  }
+
+  // Sweep over the interval boundaries to count the busy units in each cycle
+  std::vector<std::pair<uint64_t, int>> events;
+  for (int v = 0; v < kVfuNone; ++v) {
+    for (const BusyInterval &i : merged[v]) {
+      events.push_back({i.start, 1});
+      events.push_back({i.end, -1});
+    }
+  }
+  std::sort(events.begin(), events.end());
+  uint64_t overlap_cycles = 0;
+  int busy = 0;
+  for (size_t e = 0; e < events.size(); ++e) {
+    busy += events[e].second;
+    if (busy >= 2 && e + 1 < events.size()) {
+      overlap_cycles += events[e + 1].first - events[e].first;
+    }
+  }
+
+  std::cout << "Functional unit busy cycles:" << std::endl;
+  for (int v = 0; v < kVfuNone; ++v) {
+    uint64_t cycles = BusyCycles(merged[v]);
+    std::cout << std::setw(10) << kVfuNames[v] << std::setw(12) << cycles
+              << std::fixed << std::setprecision(1) << std::setw(8)
+              << 100.0 * cycles / (t_last - t_first) << "%" << std::endl;
+  }
+  std::cout << "Cycles with two or more units busy: " << overlap_cycles
+            << std::endl
+            << std::endl;
+
+  std::cout << "Pairwise overlap (cycles):" << std::endl << std::setw(10) << "";
+  for (int v = 0; v < kVfuNone; ++v) {
+    std::cout << std::setw(10) << kVfuNames[v];
+  }
+  std::cout << std::endl;
+  for (int a = 0; a < kVfuNone; ++a) {
+    std::cout << std::setw(10) << kVfuNames[a];
+    for (int b = 0; b < kVfuNone; ++b) {
+      std::cout << std::setw(10)
+                << (a == b ? BusyCycles(merged[a])
+                           : OverlapCycles(merged[a], merged[b]));
+    }
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
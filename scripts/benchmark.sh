@@ -240,6 +240,50 @@ matmul() {
   done
 }
 
+##########
+## GEMM ##
+##########
+
+gemm() {
+
+  kernel=fgemm
+  defines=""
+  # sew in bytes (uint64_t -> sew: 8)
+  sew=8
+
+  tempfile=`mktemp`
+
+  # Log the performance results
+  > ${kernel}_${nr_lanes}.benchmark
+  > ${kernel}_${nr_lanes}_ideal.benchmark
+  # Init error report
+  echo "kernel: $kernel" >> ${error_rpt}
+
+  # Measure the square shapes of matmul, and then tall, wide, and deep
+  # shapes with sizes that are not multiples of the blocks
+  for shape in "4 4 4" "8 8 8" "16 16 16" "32 32 32" "64 64 64" "128 128 128" \
+               "256 32 32" "32 32 256" "32 256 32" "100 37 61" "7 300 9"; do
+
+    args="$shape"
+    metadata="$kernel $nr_lanes $(echo $shape | cut -d" " -f1) $sew"
+
+    # Clean
+    clean_and_gen_data $kernel "$args" || exit
+
+    # Default System
+    compile_and_run $kernel "$defines" $tempfile 0                                      || exit
+    extract_performance $kernel "$metadata 0" "$args" $tempfile ${kernel}_${nr_lanes}.benchmark || exit
+
+    # Ideal Dispatcher System, if QuestaSim is available
+    if [ "$ci" == 0 ]; then
+      compile_and_run $kernel "$defines" $tempfile 1                                            || exit
+      extract_performance $kernel "$metadata 1" "$args" $tempfile ${kernel}_${nr_lanes}_ideal.benchmark || exit
+      # Verify ID results is non-blocking! Check the report afterwards
+      verify_id_results 0 | tee -a ${error_rpt}
+    fi
+  done
+}
+
 ################
 ## CONV2D 3x3 ##
 ################
@@ -794,11 +838,73 @@ lavamd() {
   done
 }
 
+##########
+## SpMV ##
+##########
+
+spmv() {
+
+  kernel=spmv
+  # sew in bytes (double -> sew: 8)
+  sew=8
+  # Height of the SELL-C-sigma slices: one e64 vector with LMUL=4
+  slice_h=$(( vlen / 16 ))
+
+  tempfile=`mktemp`
+
+  # Log the performance results, one file per format
+  for name in spmv spmv_sell; do
+    > ${name}_${nr_lanes}.benchmark
+    > ${name}_${nr_lanes}_ideal.benchmark
+  done
+  # Init error report
+  echo "kernel: $kernel" >> ${error_rpt}
+
+  # Compare the CSR and the SELL-C-sigma formats on the same matrices, with
+  # rows of the same length (as in FEM matrices), uniformly spread nonzeros,
+  # and skewed row lengths
+  for dist in fixed uniform powerlaw; do
+    for density in 0.03 0.25; do
+
+      args="256 256 $density $dist $slice_h"
+
+      for name in spmv spmv_sell; do
+
+        if [ "$name" == "spmv_sell" ]; then
+          defines="-DSPMV_SELL=1"
+        else
+          defines=""
+        fi
+        metadata="$name $nr_lanes 256 $sew"
+
+        # Clean
+        clean_and_gen_data $kernel "$args" || exit
+
+        # Default System
+        compile_and_run $kernel "$defines" $tempfile 0                                  || exit
+        extract_performance $kernel "$metadata 0" "$args" $tempfile ${name}_${nr_lanes}.benchmark || exit
+
+        # Ideal Dispatcher System, if QuestaSim is available
+        if [ "$ci" == 0 ]; then
+          compile_and_run $kernel "$defines" $tempfile 1                                        || exit
+          extract_performance $kernel "$metadata 1" "$args" $tempfile ${name}_${nr_lanes}_ideal.benchmark || exit
+          # Verify ID results is non-blocking! Check the report afterwards
+          verify_id_results 0 | tee -a ${error_rpt}
+        fi
+      done
+    done
+  done
+}
+
 case $1 in
   "imatmul" | "fmatmul")
     matmul $1
     ;;
 
+  "fgemm")
+    gemm
+    ;;
+
   "iconv2d" | "fconv2d")
     conv2d $1
     ;;
@@ -851,9 +957,14 @@ case $1 in
     lavamd
     ;;
 
+  "spmv")
+    spmv
+    ;;
+
   *)
     echo "Benchmarking all the apps."
     matmul fmatmul
+    gemm
     fconv3d
     jacobi2d
     dropout
@@ -866,5 +977,6 @@ case $1 in
     pathfinder
     roi_align
     lavamd
+    spmv
     ;;
 esac
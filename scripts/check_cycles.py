@@ -26,6 +26,7 @@ import numpy as np
 threshold = {
   'imatmul'    : 500,
   'fmatmul'    : 500,
+  'fgemm'      : 500,
   'iconv2d'    : 500,
   'fconv2d'    : 500,
   'fconv3d'    : 500,
@@ -40,11 +41,13 @@ threshold = {
   'fdotproduct': 500,
   'roi_align'  : 500,
   'lavamd'     : 500,
+  'spmv'       : 500,
 }
 
 skip_check = {
   'imatmul'    : 0,
   'fmatmul'    : 0,
+  'fgemm'      : 0,
   'iconv2d'    : 0,
   'fconv2d'    : 0,
   'fconv3d'    : 0,
@@ -59,6 +62,7 @@ skip_check = {
   'fdotproduct': 0,
   'roi_align'  : 1, # This program has a larger scalar component
   'lavamd'     : 0,
+  'spmv'       : 0,
 }
 
 def main():
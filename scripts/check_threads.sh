@@ -0,0 +1,99 @@
+#!/usr/bin/env bash
+#
+# check_threads.sh threads [kernel ...]
+#
+# Verilate a single-threaded and a multi-threaded model of the current
+# configuration, benchmark the kernels on both, and check that the two models
+# report the same cycle counts. If no kernel is passed, all the kernels
+# supported by benchmark.sh are checked. The wall-clock time of each run is
+# written to wallclock.csv and printed with the speedup of the threaded model.
+#
+# When this script is called, CLANG_PATH should point to the
+# clang directory used to verilate the design
+
+# Useful dirs
+script=$( cd -- "$( dirname -- "${BASH_SOURCE[0]}" )" &> /dev/null && pwd )
+root=${script}/..
+hardware=$root/hardware
+
+if [ -z "$1" ]; then
+  echo "Usage: $0 threads [kernel ...]"
+  exit 1
+fi
+nr_threads=$1
+shift
+
+kernels="$@"
+if [ -z "$kernels" ]; then
+  # The apps benchmarked by benchmark.sh when no app is passed
+  kernels="fmatmul fgemm fconv3d jacobi2d dropout fft dwt exp softmax fdotproduct dotproduct pathfinder roi_align lavamd spmv"
+fi
+
+# Result files written by benchmark.sh for a kernel
+benchmark_files() {
+  case $1 in
+    "spmv")
+      echo "spmv_${nr_lanes}.benchmark spmv_sell_${nr_lanes}.benchmark"
+      ;;
+    *)
+      echo "${1}_${nr_lanes}.benchmark"
+      ;;
+  esac
+}
+
+# Include Ara's configuration
+if [ -z ${config} ]; then
+    if [ -z ${ARA_CONFIGURATION} ]; then
+        config=default
+    else
+        config=${ARA_CONFIGURATION}
+    fi
+fi
+
+tmpscript=`mktemp`
+sed "s/ ?= /=/g" $root/config/${config}.mk > $tmpscript
+source ${tmpscript}
+
+timestamp=$(date +%Y%m%d%H%M%S)
+result=$root/check-threads-runs/$timestamp
+mkdir -p $result/st $result/mt
+
+# Move to root directory
+cd $root
+
+# Verilate both models. They live in different build folders.
+config=${config} CLANG_PATH=${CLANG_PATH} make -C $hardware verilate || exit
+config=${config} CLANG_PATH=${CLANG_PATH} make -C $hardware verilate threads=${nr_threads} || exit
+
+failed=0
+echo "kernel,st_seconds,mt_seconds" > $result/wallclock.csv
+for kernel in $kernels; do
+  files=$(benchmark_files $kernel)
+  start=$(date +%s.%N)
+  config=${config} $script/benchmark.sh ci $kernel || exit
+  st_time=$(awk "BEGIN { print $(date +%s.%N) - $start }")
+  mv $files $result/st/
+  start=$(date +%s.%N)
+  config=${config} threads=${nr_threads} $script/benchmark.sh ci $kernel || exit
+  mt_time=$(awk "BEGIN { print $(date +%s.%N) - $start }")
+  mv $files $result/mt/
+  echo "$kernel,$st_time,$mt_time" >> $result/wallclock.csv
+
+  for file in $files; do
+    if diff $result/st/$file $result/mt/$file; then
+      echo "[${file}]: single-threaded and ${nr_threads}-threaded models match."
+    else
+      echo "[${file}]: single-threaded and ${nr_threads}-threaded models DIFFER."
+      failed=1
+    fi
+  done
+done
+
+# Wall-clock time of the benchmark runs (compilation included) on both models
+echo ""
+printf "%-16s %12s %12s %8s\n" kernel "1 thread [s]" "${nr_threads} threads [s]" speedup
+tail -n +2 $result/wallclock.csv | awk -F, '{ printf "%-16s %12.1f %12.1f %8.2f\n", $1, $2, $3, $2 / $3 }'
+
+echo "Results in $result"
+
+exit $failed
@@ -0,0 +1,104 @@
+#!/usr/bin/env python
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Operand forwarding: correctness and cycles.
+#
+# Verilates the model of each lane configuration with and without the operand
+# forwarding (operand_fwd=1), and runs the same binaries of the apps on both.
+# The apps check their results against a scalar reference, so an app passes
+# if it exits with 0 on the model.
+#
+# forwarding_check.py [-j jobs] [-l lanes ...] [app ...]
+#
+# Results are written to forwarding_check.csv (app, lanes, hw_cycles without
+# and with the forwarding) in the run folder, and printed with the speedup.
+
+import argparse
+import os
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+from sweep import root_dir, hw_dir, read_config, run
+from queue_sweep import compile_app, simulate
+
+def verilate(config, forwarding, outdir):
+  name = 'forwarding-check-{}{}'.format(config, '-fwd' if forwarding else '')
+  buildpath = os.path.join('build', name)
+  log = os.path.join(outdir, 'verilate_' + name + '.log')
+  ok = run(['make', '-C', hw_dir, 'verilate', 'config=' + config, 'buildpath=' + buildpath] +
+           (['operand_fwd=1'] if forwarding else []), log)
+  folder = 'verilator_operand_fwd' if forwarding else 'verilator'
+  return os.path.join(hw_dir, buildpath, folder, 'Vara_tb_verilator') if ok else None
+
+def main():
+  parser = argparse.ArgumentParser(description='Check the operand forwarding of Ara on the apps.')
+  parser.add_argument('apps', nargs='*',
+                      default=['chaining', 'fmatmul', 'fconv2d', 'fconv3d', 'fdotproduct', 'jacobi2d', 'softmax', 'spmv'],
+                      help='apps to simulate, with their default arguments '
+                           '(default: chaining fmatmul fconv2d fconv3d fdotproduct jacobi2d softmax spmv)')
+  parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(),
+                      help='number of parallel simulations (default: number of cores)')
+  parser.add_argument('-l', '--lanes', type=int, nargs='+', default=[2, 4],
+                      help='lane configurations (default: 2 4)')
+  parser.add_argument('-o', '--outdir', default=os.path.join(root_dir, 'sweep-runs', 'forwarding-' + time.strftime('%Y%m%d%H%M%S')),
+                      help='run folder')
+  args = parser.parse_args()
+
+  configs = {lanes: read_config(lanes)[0] for lanes in args.lanes}
+  for config in configs.values():
+    os.makedirs(os.path.join(args.outdir, config))
+
+  builds = [(lanes, forwarding) for lanes in args.lanes for forwarding in [False, True]]
+  compiles = [(lanes, app) for lanes in args.lanes for app in args.apps]
+  print('Verilating {} models and compiling {} apps in {}'.format(len(builds), len(compiles), args.outdir))
+  with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+    models = dict(zip(builds, pool.map(
+      lambda b: verilate(configs[b[0]], b[1], os.path.join(args.outdir, configs[b[0]])), builds)))
+    binaries = dict(zip(compiles, pool.map(
+      lambda c: compile_app(c[1], configs[c[0]], os.path.join(args.outdir, configs[c[0]])), compiles)))
+  for (lanes, forwarding), model in models.items():
+    if model is None:
+      sys.exit('Error: verilation of {} lanes {} the operand forwarding failed'.format(
+        lanes, 'with' if forwarding else 'without'))
+  for (lanes, app), binary in binaries.items():
+    if binary is None:
+      sys.exit('Error: compilation of {} for {} lanes failed'.format(app, lanes))
+
+  points = [(lanes, app, forwarding) for lanes, app in compiles for forwarding in [False, True]]
+  print('Running {} simulations on {} jobs'.format(len(points), args.jobs))
+  with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+    cycles = dict(zip(points, pool.map(
+      lambda p: simulate(models[(p[0], p[2])], binaries[(p[0], p[1])],
+                         os.path.join(args.outdir, configs[p[0]], p[1] + ('_fwd' if p[2] else ''))), points)))
+
+  failed = 0
+  with open(os.path.join(args.outdir, 'forwarding_check.csv'), 'w') as outfile:
+    print('app,lanes,hw_cycles,hw_cycles_fwd', file=outfile)
+    print('\n{:<16} {:>5} {:>12} {:>12} {:>8}'.format('app', 'lanes', 'hw_cycles', 'fwd', 'speedup'))
+    for lanes, app in compiles:
+      base, fwd = cycles[(lanes, app, False)], cycles[(lanes, app, True)]
+      if base is None or fwd is None:
+        failed += 1
+      speedup = '{:.3f}'.format(base / fwd) if base and fwd else '-'
+      print('{:<16} {:>5} {:>12} {:>12} {:>8}'.format(app, lanes, base or 'FAILED', fwd or 'FAILED', speedup))
+      print('{},{},{},{}'.format(app, lanes, base if base else '', fwd if fwd else ''), file=outfile)
+
+  sys.exit(1 if failed else 0)
+
+if __name__ == '__main__':
+  main()
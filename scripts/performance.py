@@ -24,26 +24,24 @@ import sys
 import numpy as np
 
 # Performance extractors: returns problem size and performance (throughput)
-def imatmul(args, cycles):
+# Square matrix multiplications are identified by their size, the others by
+# their shape (MxNxP)
+def matmul(args, cycles):
   m           = int(args[0])
   n           = int(args[1])
   p           = int(args[2])
   if (m == n and n == p):
     size = m
   else:
-    sys.exit('Unimplemented return value for performance function if !(M == N == P) in "' + kernel)
-  performance = 2 * size * size * size / cycles
+    size = '{}x{}x{}'.format(m, n, p)
+  performance = 2 * m * n * p / cycles
   return [size, performance]
+def imatmul(args, cycles):
+  return matmul(args, cycles)
 def fmatmul(args, cycles):
-  m           = int(args[0])
-  n           = int(args[1])
-  p           = int(args[2])
-  if (m == n and n == p):
-    size = m
-  else:
-    sys.exit('Unimplemented return value for performance function if !(M == N == P) in "' + kernel)
-  performance = 2 * size * size * size / cycles
-  return [size, performance]
+  return matmul(args, cycles)
+def fgemm(args, cycles):
+  return matmul(args, cycles)
 def iconv2d(args, cycles):
   size        = int(args[0])
   filter      = int(args[1])
@@ -64,6 +62,12 @@ def jacobi2d(args, cycles):
   trash_0     = args[1]
   performance = 2 * 5 * (size-1) * (size-1) / cycles
   return [size, performance]
+def jacobi2d_tb(args, cycles):
+  size        = int(args[0])
+  tsteps      = int(args[2])
+  tb          = int(args[3])
+  performance = 2 * tsteps * 5 * (size-1) * (size-1) / cycles
+  return ['{}-T{}'.format(size, tb), performance]
 def dropout(args, cycles):
   size        = int(args[0])
   performance = size / cycles
@@ -122,13 +126,28 @@ def lavamd(args, cycles):
   performance = (1 * 2 * 4 * (51 * par4box + 4 * min(par4box, maxelm))) / cycles
   return [par4box, performance]
 
+# Sparse matrices are identified by their shape, density, and distribution of
+# the row lengths. The number of nonzeros is set by the shape and density
+def spmv(args, cycles):
+  r           = int(args[0])
+  c           = int(args[1])
+  density     = float(args[2])
+  dist        = args[3] if len(args) > 3 else 'uniform'
+  size        = '{}x{}-{}-{}'.format(r, c, density, dist)
+  performance = 2 * int(r * c * density) / cycles
+  return [size, performance]
+def spmv_sell(args, cycles):
+  return spmv(args, cycles)
+
 perfExtr = {
   'imatmul'    : imatmul,
   'fmatmul'    : fmatmul,
+  'fgemm'      : fgemm,
   'iconv2d'    : iconv2d,
   'fconv2d'    : fconv2d,
   'fconv3d'    : fconv3d,
   'jacobi2d'   : jacobi2d,
+  'jacobi2d_tb': jacobi2d_tb,
   'dropout'    : dropout,
   'fft'        : fft,
   'dwt'        : dwt,
@@ -139,16 +158,20 @@ perfExtr = {
   'fdotproduct': fdotproduct,
   'roi_align'  : roi_align,
   'lavamd'     : lavamd,
+  'spmv'       : spmv,
+  'spmv_sell'  : spmv_sell,
 }
 
 # Maximum performance if Ara's BW can be fully utilized
 ideal_maxPerf = {
   'imatmul'    : lambda l, s : 2 * l * 8/s,
   'fmatmul'    : lambda l, s : 2 * l * 8/s,
+  'fgemm'      : lambda l, s : 2 * l * 8/s,
   'iconv2d'    : lambda l, s : 2 * l * 8/s,
   'fconv2d'    : lambda l, s : 2 * l * 8/s,
   'fconv3d'    : lambda l, s : 2 * l * 8/s,
   'jacobi2d'   : lambda l, s : l * 8/s,
+  'jacobi2d_tb': lambda l, s : l * 8/s,
   'dropout'    : lambda l, s : 4 * l / (2*s + 1/8),
   'fft'        : lambda l, s : 5/4 * l * 8/s,
   'dwt'        : lambda l, s : 4 * l / s,
@@ -159,6 +182,8 @@ ideal_maxPerf = {
   'fdotproduct': lambda l, s : l * 8/s,
   'roi_align'  : lambda l, s : l * 8/s,
   'lavamd'     : lambda l, s : 0, # placeholder
+  'spmv'       : lambda l, s : 2 * l * 8/s,
+  'spmv_sell'  : lambda l, s : 2 * l * 8/s,
 }
 
 # Maximum performance taking into account Ara's limited
@@ -166,10 +191,12 @@ ideal_maxPerf = {
 real_maxPerf = {
   'imatmul'    : lambda l, s : 2 * l * 8/s,
   'fmatmul'    : lambda l, s : 2 * l * 8/s,
+  'fgemm'      : lambda l, s : 2 * l * 8/s,
   'iconv2d'    : lambda l, s : 2 * l * 8/s,
   'fconv2d'    : lambda l, s : 2 * l * 8/s,
   'fconv3d'    : lambda l, s : 2 * l * 8/s,
   'jacobi2d'   : lambda l, s : l * 8/s,
+  'jacobi2d_tb': lambda l, s : l * 8/s,
   'dropout'    : lambda l, s : 4 * l / (2*s + 1/8),
   'fft'        : lambda l, s : 5/4 * l * 8/s,
   'dwt'        : lambda l, s : 4 * l / s,
@@ -180,6 +207,9 @@ real_maxPerf = {
   'fdotproduct': lambda l, s : 4 * l/s,
   'roi_align'  : lambda l, s : 9/5 * l * 4/s,
   'lavamd'     : lambda l, s : 0, # placeholder
+  # Indexed loads fetch one element of the vector per cycle
+  'spmv'       : lambda l, s : min(2 * l * 8/s, 2),
+  'spmv_sell'  : lambda l, s : min(2 * l * 8/s, 2),
 }
 
 def main():
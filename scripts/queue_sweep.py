@@ -0,0 +1,163 @@
+#!/usr/bin/env python
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Sensitivity of the apps to the instruction queues.
+#
+# Every knob (nr_vinsn and the depths of the MFPU, load unit, and slide unit
+# instruction queues) is swept alone, with the other ones at the value of the
+# configuration. Each hardware variant is verilated in its own build folder,
+# and each app is compiled once, with its default arguments.
+#
+# queue_sweep.py [-j jobs] [-l lanes] [--nr-vinsn N ...] [--mfpu N ...]
+#                [--vldu N ...] [--sldu N ...] [app ...]
+#
+# Results are written to queue_sweep.csv (app, lanes, knob, value, hw_cycles)
+# in the run folder, and printed as cycles versus value for each app and knob.
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+from sweep import root_dir, hw_dir, read_config, run, setup_apps
+
+# Knobs of the configuration, with the option that sweeps them
+knobs = [('nr_vinsn', 'nr_vinsn'), ('mfpu_insn_queue_depth', 'mfpu'),
+         ('vldu_insn_queue_depth', 'vldu'), ('sldu_insn_queue_depth', 'sldu')]
+
+def config_knobs(config):
+  with open(os.path.join(root_dir, 'config', config + '.mk')) as f:
+    text = f.read()
+  values = {}
+  for knob, _ in knobs:
+    m = re.search(r'^' + knob + r'\s*\?=\s*(\d+)', text, re.M)
+    if not m:
+      sys.exit('Error: {} is not set in the configuration {}'.format(knob, config))
+    values[knob] = int(m.group(1))
+  return values
+
+# Name of the build folder of a hardware variant
+def variant_name(config, variant):
+  return 'queue-sweep-{}-'.format(config) + '-'.join('{}{}'.format(k, v) for k, v in variant)
+
+def verilate(config, variant, outdir):
+  buildpath = os.path.join('build', variant_name(config, variant))
+  log = os.path.join(outdir, 'verilate_' + variant_name(config, variant) + '.log')
+  ok = run(['make', '-C', hw_dir, 'verilate', 'config=' + config, 'buildpath=' + buildpath] +
+           ['{}={}'.format(k, v) for k, v in variant], log)
+  return os.path.join(hw_dir, buildpath, 'verilator', 'Vara_tb_verilator') if ok else None
+
+def compile_app(app, config, outdir):
+  app_dir = os.path.join(outdir, 'apps_' + app)
+  os.makedirs(app_dir)
+  point_apps = setup_apps(app_dir)
+  log = os.path.join(app_dir, 'compile.log')
+  env = dict(os.environ, config=config)
+  ok = run(['make', '-C', point_apps, 'bin/' + app], log, env=env)
+  return os.path.join(point_apps, 'bin', app) if ok else None
+
+def simulate(model, binary, sim_dir):
+  os.makedirs(sim_dir)
+  sim = subprocess.run([model, '-l', 'ram,{},elf'.format(binary)], cwd=sim_dir,
+                       stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+  with open(os.path.join(sim_dir, 'sim.log'), 'w') as f:
+    f.write(sim.stdout)
+  if sim.returncode != 0:
+    return None
+  try:
+    with open(os.path.join(sim_dir, 'sim_report.json')) as f:
+      return json.load(f)['hw_cycles']
+  except (OSError, ValueError, KeyError):
+    return None
+
+def main():
+  parser = argparse.ArgumentParser(description='Sweep the instruction queues of Ara, one knob at a time.')
+  parser.add_argument('apps', nargs='*', default=['fconv3d', 'dtype-conv3d', 'fmatmul'],
+                      help='apps to simulate, with their default arguments (default: fconv3d dtype-conv3d fmatmul)')
+  parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(),
+                      help='number of parallel simulations (default: number of cores)')
+  parser.add_argument('-l', '--lanes', type=int, default=4,
+                      help='lane configuration (default: 4)')
+  parser.add_argument('--nr-vinsn', type=int, nargs='*', default=[2, 4, 8],
+                      help='vector instructions in flight (default: 2 4 8)')
+  parser.add_argument('--mfpu', type=int, nargs='*', default=[2, 4],
+                      help='depths of the MFPU instruction queue (default: 2 4)')
+  parser.add_argument('--vldu', type=int, nargs='*', default=[2, 4],
+                      help='depths of the load unit instruction queue (default: 2 4)')
+  parser.add_argument('--sldu', type=int, nargs='*', default=[2, 4],
+                      help='depths of the slide unit instruction queue (default: 2 4)')
+  parser.add_argument('-o', '--outdir', default=os.path.join(root_dir, 'sweep-runs', 'queues-' + time.strftime('%Y%m%d%H%M%S')),
+                      help='run folder')
+  args = parser.parse_args()
+
+  config, _ = read_config(args.lanes)
+  base = config_knobs(config)
+
+  # One variant per value of each knob, the others at the value of the configuration
+  variants = []
+  for knob, option in knobs:
+    for value in getattr(args, option):
+      variant = tuple(sorted(dict(base, **{knob: value}).items()))
+      if variant not in variants:
+        variants.append(variant)
+
+  os.makedirs(args.outdir)
+  print('Verilating {} variants and compiling {} apps in {}'.format(len(variants), len(args.apps), args.outdir))
+  with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+    models = dict(zip(variants, pool.map(lambda v: verilate(config, v, args.outdir), variants)))
+    binaries = dict(zip(args.apps, pool.map(lambda a: compile_app(a, config, args.outdir), args.apps)))
+  for variant, model in models.items():
+    if model is None:
+      sys.exit('Error: verilation of {} failed'.format(variant_name(config, variant)))
+  for app, binary in binaries.items():
+    if binary is None:
+      sys.exit('Error: compilation of {} failed'.format(app))
+
+  points = [(app, variant) for app in args.apps for variant in variants]
+  print('Running {} simulations on {} jobs'.format(len(points), args.jobs))
+  with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+    cycles = dict(zip(points, pool.map(
+      lambda p: simulate(models[p[1]], binaries[p[0]],
+                         os.path.join(args.outdir, p[0] + '_' + variant_name(config, p[1]))), points)))
+
+  base_key = tuple(sorted(base.items()))
+  failed = 0
+  with open(os.path.join(args.outdir, 'queue_sweep.csv'), 'w') as outfile:
+    print('app,lanes,knob,value,hw_cycles', file=outfile)
+    for app in args.apps:
+      print('\n{} ({} lanes)'.format(app, args.lanes))
+      for knob, option in knobs:
+        print('  {:<22} {:>6} {:>12} {:>8}'.format(knob, 'value', 'hw_cycles', 'speedup'))
+        base_cycles = cycles.get((app, base_key))
+        for value in getattr(args, option):
+          hw_cycles = cycles[(app, tuple(sorted(dict(base, **{knob: value}).items())))]
+          if hw_cycles is None:
+            print('  {:<22} {:>6} {:>12}'.format('', value, 'FAILED'))
+            failed += 1
+            continue
+          speedup = '{:.3f}'.format(base_cycles / hw_cycles) if base_cycles else '-'
+          print('  {:<22} {:>6} {:>12} {:>8}'.format('', value, hw_cycles, speedup))
+          print('{},{},{},{},{}'.format(app, args.lanes, knob, value, hw_cycles), file=outfile)
+
+  sys.exit(1 if failed else 0)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,294 @@
+#!/usr/bin/env python
+# Copyright 2022 ETH Zurich and University of Bologna.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Parallel benchmark sweep.
+#
+# Same measurements as benchmark.sh, but every (kernel, args, lanes,
+# ideal_dispatcher) point is compiled in its own copy of the apps folder, and
+# the points are simulated with Verilator in parallel.
+#
+# sweep.py [-j jobs] [-l lanes ...] [--ideal] [kernel ...]
+#
+# Results are merged into sweep.benchmark (same fields as performance.py, one
+# line per point) in the run folder.
+
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+import performance
+
+script_dir = os.path.dirname(os.path.abspath(__file__))
+root_dir   = os.path.abspath(os.path.join(script_dir, '..'))
+apps_dir   = os.path.join(root_dir, 'apps')
+hw_dir     = os.path.join(root_dir, 'hardware')
+python     = sys.executable
+
+# Apps sub-folders that are written during the compilation. They are copied in
+# each point folder (without build products), while the others are only linked.
+apps_private = ['common', 'benchmarks', 'ideal_dispatcher', 'libara-rvv']
+apps_skip    = ['bin']
+build_products = shutil.ignore_patterns('*.o', '*.o.spike', '*.a', 'link.ld', 'vtrace', 'log', 'temp')
+
+def sew_from_dtype(dtype):
+  return {'double': 8, 'float64': 8, 'int64_t': 8, 'uint64_t': 8,
+          'float32': 4, 'float': 4, 'int32_t': 4, 'uint32_t': 4,
+          '_Float16': 2, 'int16_t': 2, 'uint16_t': 2,
+          '_Float8': 1, 'int8_t': 1, 'uint8_t': 1}[dtype]
+
+# Sweep points of each kernel, as in benchmark.sh
+# Each point is: (args, problem size, sew, defines)
+def kernel_points(kernel, vlen):
+  pow2 = lambda lo, hi: [2**i for i in range(lo, hi + 1)]
+  if kernel in ['imatmul', 'fmatmul']:
+    return [('{0} {0} {0}'.format(s), s, 8, '') for s in pow2(2, 7)]
+  if kernel == 'fgemm':
+    # Square shapes, then tall, wide, and deep shapes that are not multiples of the blocks
+    shapes = [(s, s, s) for s in pow2(2, 7)] + [(256, 32, 32), (32, 32, 256), (32, 256, 32), (100, 37, 61), (7, 300, 9)]
+    return [('{} {} {}'.format(*shape), shape[0], 8, '') for shape in shapes]
+  if kernel in ['iconv2d', 'fconv2d']:
+    return [('{} 3'.format(s), s, 8, '') for s in [4, 8, 16, 32, 64, 112]]
+  if kernel == 'fconv3d':
+    return [('{} 7'.format(s), s, 8, '') for s in [4, 8, 16, 32, 64, 112]]
+  if kernel == 'jacobi2d':
+    return [('{0} {0}'.format(s + 2), s + 2, 8, '') for s in pow2(2, 7)]
+  if kernel == 'jacobi2d_tb':
+    # Four time steps, with T = 1 to 4 of them fused in each pass over the grid
+    return [('{0} {0} 4 {1}'.format(s + 2, t), s + 2, 8, '')
+            for s in pow2(4, 7) for t in range(1, 5)]
+  if kernel == 'dropout':
+    return [('{}'.format(s), s, 4, '') for s in pow2(2, 11)]
+  if kernel == 'fft':
+    sizes = pow2(2, 7) + ([256] if vlen >= 256 * 32 else [])
+    return [('{} float32'.format(s), s, 4, '-DFFT_SAMPLES={}'.format(s)) for s in sizes]
+  if kernel == 'dwt':
+    return [('{}'.format(s), s, 4, '') for s in pow2(2, 9)]
+  if kernel == 'exp':
+    return [('{}'.format(s), s, 8, '') for s in pow2(2, 9)]
+  if kernel == 'softmax':
+    return [('32 {}'.format(s), s, 4, '') for s in pow2(2, 9)]
+  if kernel == 'fdotproduct':
+    return [('{}'.format(s), s, sew_from_dtype('double'), '-Ddtype=double') for s in pow2(2, 9)]
+  if kernel == 'dotproduct':
+    return [('{}'.format(s), s, sew_from_dtype('int64_t'), '-Ddtype=int64_t') for s in pow2(2, 9)]
+  if kernel == 'pathfinder':
+    return [('1 {} 64'.format(s), s, 4, '') for s in pow2(2, 10)]
+  if kernel == 'roi_align':
+    return [('1 {} 16 16 4 4 4'.format(s), s, 4, '') for s in pow2(2, 9)]
+  if kernel == 'lavamd':
+    maxelm = vlen // 32
+    return [('2 {} 0.5 {}'.format(s, maxelm), s, 32, '') for s in [4, 8, 16, 32, 64, 96, 128, 256, 512]]
+  if kernel in ['spmv', 'spmv_sell']:
+    # Same matrices for both formats. The SELL slices are one e64 vector with LMUL=4
+    defines = '-DSPMV_SELL=1' if kernel == 'spmv_sell' else ''
+    return [('256 256 {} {} {}'.format(d, dist, vlen // 16), 256, 8, defines)
+            for dist in ['fixed', 'uniform', 'powerlaw'] for d in [0.03, 0.25]]
+  sys.exit('Error: the kernel "' + kernel + '" is not valid')
+
+# Kernels that are variants of another app, with its data and benchmark
+kernel_app = {'spmv_sell': 'spmv', 'jacobi2d_tb': 'jacobi2d'}
+
+def read_config(lanes):
+  config = '{}_lanes'.format(lanes)
+  with open(os.path.join(root_dir, 'config', config + '.mk')) as f:
+    vlen = int(re.search(r'^vlen\s*\?=\s*(\d+)', f.read(), re.M).group(1))
+  return config, vlen
+
+def run(cmd, log, cwd=None, env=None):
+  with open(log, 'a') as f:
+    f.write('$ ' + ' '.join(cmd) + '\n')
+    f.flush()
+    return subprocess.run(cmd, cwd=cwd, env=env, stdout=f, stderr=subprocess.STDOUT).returncode == 0
+
+# Make arguments and model folder of the optional hardware features: the DRAM
+# timing model, the VLSU coalescing and prefetcher, and the operand forwarding
+def model_variant(dram, coalescing, prefetch, forwarding):
+  make, folder = [], 'verilator'
+  if dram is not None:
+    make, folder = make + ['dram_model=1'], folder + '_dram_model'
+  if coalescing:
+    make, folder = make + ['vlsu_coalescing=1'], folder + '_coalescing'
+  if prefetch:
+    make, folder = make + ['vlsu_prefetch=1'], folder + '_prefetch'
+  if forwarding:
+    make, folder = make + ['operand_fwd=1'], folder + '_operand_fwd'
+  return make, folder
+
+# Verilate the default (non-ideal) model of a configuration
+def verilate(config, buildpath, log, dram, coalescing, prefetch, forwarding):
+  return run(['make', '-C', hw_dir, 'verilate', 'config=' + config, 'buildpath=' + buildpath] +
+             model_variant(dram, coalescing, prefetch, forwarding)[0], log)
+
+# Create a private copy of the apps folder
+def setup_apps(point_dir):
+  point_apps = os.path.join(point_dir, 'apps')
+  os.makedirs(point_apps)
+  for entry in os.listdir(apps_dir):
+    src = os.path.join(apps_dir, entry)
+    dst = os.path.join(point_apps, entry)
+    if entry in apps_skip:
+      continue
+    if entry in apps_private:
+      shutil.copytree(src, dst, symlinks=True, ignore=build_products)
+    else:
+      os.symlink(src, dst)
+  # The apps Makefile looks for the configuration next to the apps folder
+  os.symlink(os.path.join(root_dir, 'config'), os.path.join(point_dir, 'config'))
+  return point_apps
+
+def extract(pattern, text):
+  m = re.search(r'\[' + re.escape(pattern) + r'\]:\s*(-?\d+)', text)
+  return int(m.group(1)) if m else None
+
+def run_point(p, run_dir):
+  kernel, lanes, (args, size, sew, defines), ideal = p['kernel'], p['lanes'], p['point'], p['ideal']
+  variant_make, variant_dir = model_variant(p['dram'], p['coalescing'], p['prefetch'],
+                                             p['forwarding'])
+  config, _ = read_config(lanes)
+  name = '{}_{}_{}{}'.format(kernel, lanes, args.replace(' ', '_'), '_ideal' if ideal else '')
+  point_dir = os.path.join(run_dir, name)
+  log = os.path.join(point_dir, 'sweep.log')
+  os.makedirs(point_dir)
+  point_apps = setup_apps(point_dir)
+
+  # Generate the data
+  data_dir = os.path.join(point_apps, 'benchmarks', 'data')
+  os.makedirs(data_dir, exist_ok=True)
+  app = kernel_app.get(kernel, kernel)
+  gen_data = [python, os.path.join(apps_dir, app, 'script', 'gen_data.py')] + args.split()
+  with open(os.path.join(data_dir, 'data.S'), 'w') as f:
+    if subprocess.run(gen_data, stdout=f).returncode != 0:
+      return p, None, 'data generation failed'
+
+  # Compile
+  env = dict(os.environ, config=config, ENV_DEFINES='-D{}=1 {}'.format(app.upper(), defines))
+  binary = 'bin/benchmarks' + ('.ideal' if ideal else '')
+  if not run(['make', '-C', point_apps, binary], log, env=env):
+    return p, None, 'compilation failed'
+
+  # Simulate. Ideal-dispatcher models depend on the vector trace, so they are
+  # verilated for each point
+  if ideal:
+    buildpath = os.path.join(point_dir, 'hw')
+    if not run(['make', '-C', hw_dir, 'verilate', 'config=' + config, 'buildpath=' + buildpath,
+                'ideal_dispatcher=1', 'app=benchmarks',
+                'vtrace_path=' + os.path.join(point_apps, 'ideal_dispatcher', 'vtrace')] + variant_make, log):
+      return p, None, 'verilation failed'
+    model = os.path.join(buildpath, variant_dir, 'Vara_tb_verilator')
+  else:
+    model = os.path.join(hw_dir, p['buildpath'], variant_dir, 'Vara_tb_verilator')
+  dram_args = ['+dram_' + param for param in p['dram'] or []]
+  sim = subprocess.run([model, '-l', 'ram,{},elf'.format(os.path.join(point_apps, binary))] + dram_args,
+                       cwd=point_dir, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+  with open(log, 'a') as f:
+    f.write(sim.stdout)
+  if sim.returncode != 0:
+    return p, None, 'simulation failed'
+
+  # Extract the performance from the report of the model
+  try:
+    with open(os.path.join(point_dir, 'sim_report.json')) as f:
+      report = json.load(f)
+  except (OSError, ValueError):
+    return p, None, 'no performance report'
+  hw_cycles = report['hw_cycles']
+  counters = [report['dcache_stalls'], report['icache_stalls'], report['sb_full']]
+  # The software cycle count is printed by the program itself
+  sw_cycles = extract('sw-cycles', sim.stdout)
+  if not ideal and sw_cycles is not None:
+    if not run([python, os.path.join(script_dir, 'check_cycles.py'), app, str(hw_cycles), str(sw_cycles)], log):
+      return p, None, 'hw and sw cycles mismatch'
+  result = performance.perfExtr[kernel](args.split(), hw_cycles)
+  max_perf = performance.real_maxPerf[kernel](lanes, sew)
+  # kernel, lanes, vsize, sew, perf, max_perf, ideal_disp, dcache_stall, icache_stall, sb_full
+  fields = [kernel, lanes, result[0], sew, result[1], max_perf, int(ideal)] + counters
+  return p, fields, None
+
+def main():
+  parser = argparse.ArgumentParser(description='Run a parallel benchmark sweep with Verilator.')
+  parser.add_argument('kernels', nargs='*', default=list(performance.perfExtr.keys()),
+                      help='kernels to benchmark (default: all)')
+  parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(),
+                      help='number of parallel simulations (default: number of cores)')
+  parser.add_argument('-l', '--lanes', type=int, nargs='+', default=[2, 4, 8, 16],
+                      help='lane configurations to benchmark (default: 2 4 8 16)')
+  parser.add_argument('--ideal', action='store_true',
+                      help='also benchmark the ideal dispatcher system')
+  parser.add_argument('--dram', nargs='*', metavar='PARAM=VALUE',
+                      help='simulate with the DRAM timing model, with the given parameters '
+                           '(e.g., --dram latency=100 bw=8)')
+  parser.add_argument('--coalescing', action='store_true',
+                      help='coalesce the strided and indexed accesses of the VLSU')
+  parser.add_argument('--prefetch', action='store_true',
+                      help='enable the next-stripe prefetcher of the VLSU')
+  parser.add_argument('--forwarding', action='store_true',
+                      help='enable the operand forwarding from the VFU results to the operand queues')
+  parser.add_argument('-o', '--outdir', default=os.path.join(root_dir, 'sweep-runs', time.strftime('%Y%m%d%H%M%S')),
+                      help='run folder')
+  args = parser.parse_args()
+
+  os.makedirs(args.outdir)
+
+  # Verilate the models of all the configurations
+  buildpaths = {}
+  with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+    jobs = {}
+    for lanes in args.lanes:
+      config, _ = read_config(lanes)
+      buildpaths[lanes] = os.path.join('build', 'sweep-' + config)
+      log = os.path.join(args.outdir, 'verilate_' + config + '.log')
+      jobs[lanes] = pool.submit(verilate, config, buildpaths[lanes], log, args.dram, args.coalescing,
+                               args.prefetch, args.forwarding)
+    for lanes, job in jobs.items():
+      if not job.result():
+        sys.exit('Error: verilation of {} lanes failed'.format(lanes))
+
+  points = []
+  for lanes in args.lanes:
+    _, vlen = read_config(lanes)
+    for kernel in args.kernels:
+      for point in kernel_points(kernel, vlen):
+        for ideal in ([False, True] if args.ideal else [False]):
+          points.append({'kernel': kernel, 'lanes': lanes, 'point': point,
+                         'ideal': ideal, 'buildpath': buildpaths[lanes], 'dram': args.dram,
+                         'coalescing': args.coalescing, 'prefetch': args.prefetch,
+                         'forwarding': args.forwarding})
+
+  print('Running {} points on {} jobs in {}'.format(len(points), args.jobs, args.outdir))
+  failed = 0
+  with ThreadPoolExecutor(max_workers=args.jobs) as pool, \
+       open(os.path.join(args.outdir, 'sweep.benchmark'), 'w') as outfile:
+    for p, fields, error in pool.map(lambda p: run_point(p, args.outdir), points):
+      desc = '{} {} lanes "{}"{}'.format(p['kernel'], p['lanes'], p['point'][0], ' (ideal)' if p['ideal'] else '')
+      if error:
+        print('[FAILED] {}: {}'.format(desc, error))
+        failed += 1
+        continue
+      print('[OK] ' + desc)
+      print(*fields, file=outfile)
+
+  print('{} of {} points failed'.format(failed, len(points)))
+  sys.exit(1 if failed else 0)
+
+if __name__ == '__main__':
+  main()